@@ -0,0 +1,75 @@
+#include "controllers/filters/lang/Filter.hpp"
+#include "controllers/filters/lang/FilterContext.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QColor>
+#include <QString>
+#include <QStringList>
+
+#include <iterator>
+#include <variant>
+
+using namespace chatterino::filters;
+
+namespace {
+
+const QString FILTERS[] = {
+    R".(flags.highlighted || author.subbed).",
+    R".(channel.name == "forsen" && author.badges contains "moderator").",
+    R".(message.content match r"\d\d\d\d-\d\d-\d\d" && message.length > 10).",
+    R".(!(author.sub_length >= 12) || author.color == "#ff0000").",
+};
+
+FilterContext makeContext()
+{
+    FilterContext ctx;
+    ctx.at(StringSlot::AuthorName) = "icelys";
+    ctx.at(ColorSlot::AuthorColor) = QColor("#ff0000");
+    ctx.at(BoolSlot::AuthorSubbed) = true;
+    ctx.at(IntSlot::AuthorSubLength) = 14;
+    ctx.at(StringSlot::MessageContent) = "hey there :) 2038-01-19 123 456";
+    ctx.at(IntSlot::MessageLength) = 31;
+    ctx.at(StringSlot::ChannelName) = "forsen";
+    ctx.at(StringListSlot::AuthorBadges) = {"moderator", "staff"};
+    ctx.at(IntSlot::RewardCost) = -1;
+    return ctx;
+}
+
+Filter parse(const QString &input)
+{
+    auto result = Filter::fromString(input);
+    return std::move(std::get<Filter>(result));
+}
+
+}  // namespace
+
+static void BM_FilterContextMap(benchmark::State &state)
+{
+    auto filter = parse(FILTERS[state.range(0)]);
+    auto ctx = makeContext();
+
+    for (auto _ : state)
+    {
+        // Building the map is part of evaluating a message
+        auto map = ctx.toContextMap(MESSAGE_CONTEXT_SLOTS);
+        auto result = filter.execute(map).toBool();
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+static void BM_FilterCompiled(benchmark::State &state)
+{
+    auto filter = parse(FILTERS[state.range(0)]);
+    auto ctx = makeContext();
+
+    for (auto _ : state)
+    {
+        auto result = filter.matches(ctx);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+BENCHMARK(BM_FilterContextMap)->DenseRange(
+    0, static_cast<int>(std::size(FILTERS)) - 1);
+BENCHMARK(BM_FilterCompiled)->DenseRange(
+    0, static_cast<int>(std::size(FILTERS)) - 1);
@@ -0,0 +1,106 @@
+#include "controllers/accounts/AccountController.hpp"
+#include "controllers/ignores/IgnoreController.hpp"
+#include "controllers/ignores/IgnorePhrase.hpp"
+#include "controllers/ignores/IgnorePhraseMatcher.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "providers/twitch/TwitchIrc.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QString>
+
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+class MockApplication : public mock::BaseApplication
+{
+public:
+    MockApplication() = default;
+
+    AccountController *getAccounts() override
+    {
+        return &this->accounts;
+    }
+
+    AccountController accounts;
+};
+
+const QString MESSAGE =
+    "hey there forsen :) did you see the stream yesterday? it was pretty "
+    "good PogChamp phrase8 2038-01-19 woord19 some more text to make it "
+    "longer";
+
+/// Creates `count` rules: mostly literals, every fourth rule is a regex
+std::vector<IgnorePhrase> makeRules(int count, bool isBlock)
+{
+    std::vector<IgnorePhrase> rules;
+    rules.reserve(count);
+    for (int i = 0; i < count; i++)
+    {
+        auto n = QString::number(i);
+        if (i % 4 == 3)
+        {
+            rules.emplace_back("w(o+)rd" + n + "\\b", true, isBlock, "[\\1]",
+                               i % 2 == 0);
+        }
+        else
+        {
+            rules.emplace_back("phrase" + n, false, isBlock, "***", i % 2 == 0);
+        }
+    }
+    return rules;
+}
+
+}  // namespace
+
+static void BM_IgnorePhrasesReplace(benchmark::State &state)
+{
+    MockApplication app;
+    IgnorePhraseMatcher matcher(
+        makeRules(static_cast<int>(state.range(0)), false));
+
+    for (auto _ : state)
+    {
+        auto content = MESSAGE;
+        std::vector<TwitchEmoteOccurrence> emotes;
+        processIgnorePhrases(matcher, content, emotes);
+        benchmark::DoNotOptimize(content);
+    }
+}
+
+static void BM_IgnorePhrasesBlockNaive(benchmark::State &state)
+{
+    auto rules = makeRules(static_cast<int>(state.range(0)), true);
+
+    for (auto _ : state)
+    {
+        bool blocked = false;
+        for (const auto &rule : rules)
+        {
+            if (rule.isMatch(MESSAGE))
+            {
+                blocked = true;
+                break;
+            }
+        }
+        benchmark::DoNotOptimize(blocked);
+    }
+}
+
+static void BM_IgnorePhrasesBlockMatcher(benchmark::State &state)
+{
+    IgnorePhraseMatcher matcher(
+        makeRules(static_cast<int>(state.range(0)), true));
+
+    for (auto _ : state)
+    {
+        const auto *phrase = matcher.findBlockingPhrase(MESSAGE);
+        benchmark::DoNotOptimize(phrase);
+    }
+}
+
+BENCHMARK(BM_IgnorePhrasesReplace)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(BM_IgnorePhrasesBlockNaive)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(BM_IgnorePhrasesBlockMatcher)->Arg(10)->Arg(100)->Arg(1000);
@@ -0,0 +1,81 @@
+#include "messages/MessageSimilarity.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QString>
+
+#include <algorithm>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+const QString SPAM = QStringLiteral(
+    "THIS IS A COPYPASTA THAT GETS POSTED OVER AND OVER AGAIN PogChamp ");
+
+/// A 500 character spam message, slightly varied by `n`
+QString makeSpam(int n)
+{
+    return (QString::number(n) + " " + SPAM.repeated(8)).left(500);
+}
+
+/// Previous messages of a busy channel: mostly unrelated chatter, some spam
+std::vector<QString> makeHistory(int count, bool withSpam)
+{
+    std::vector<QString> history;
+    for (int i = 0; i < count; i++)
+    {
+        if (withSpam && i % 10 == 9)
+        {
+            history.push_back(makeSpam(i));
+        }
+        else
+        {
+            history.push_back(QString("message number %1 from someone who "
+                                      "is talking about the game LUL")
+                                  .arg(i));
+        }
+    }
+    return history;
+}
+
+}  // namespace
+
+static void BM_SimilarityFull(benchmark::State &state)
+{
+    auto message = makeSpam(-1);
+    auto history = makeHistory(50, state.range(0) != 0);
+
+    for (auto _ : state)
+    {
+        float max = 0;
+        for (const auto &previous : history)
+        {
+            max = std::max(max, relativeSimilarity(message, previous));
+        }
+        benchmark::DoNotOptimize(max > 0.9F);
+    }
+}
+
+static void BM_SimilarityThreshold(benchmark::State &state)
+{
+    auto message = makeSpam(-1);
+    auto history = makeHistory(50, state.range(0) != 0);
+
+    for (auto _ : state)
+    {
+        bool similar = false;
+        for (const auto &previous : history)
+        {
+            if (isSimilar(message, previous, 0.9F))
+            {
+                similar = true;
+                break;
+            }
+        }
+        benchmark::DoNotOptimize(similar);
+    }
+}
+
+BENCHMARK(BM_SimilarityFull)->Arg(0)->Arg(1);
+BENCHMARK(BM_SimilarityThreshold)->Arg(0)->Arg(1);
@@ -22,6 +22,7 @@
 #include "singletons/Resources.hpp"
 
 #include <benchmark/benchmark.h>
+#include <QByteArray>
 #include <QFile>
 #include <QJsonArray>
 #include <QJsonDocument>
@@ -158,14 +159,14 @@ std::optional<QJsonDocument> tryReadJsonFile(const QString &path)
     return doc;
 }
 
-QJsonDocument readJsonFile(const QString &path)
+QByteArray readFile(const QString &path)
 {
-    auto opt = tryReadJsonFile(path);
-    if (!opt)
+    QFile file(path);
+    if (!file.open(QFile::ReadOnly))
     {
         _exit(1);
     }
-    return *opt;
+    return file.readAll();
 }
 
 class RecentMessages
@@ -206,7 +207,7 @@ public:
         }
 
         this->messages =
-            readJsonFile(u":/bench/recentmessages-%1.json"_s.arg(this->name));
+            readFile(u":/bench/recentmessages-%1.json"_s.arg(this->name));
     }
 
     ~RecentMessages()
@@ -220,7 +221,7 @@ protected:
     QString name;
     MockApplication app;
     TwitchChannel chan;
-    QJsonDocument messages;
+    QByteArray messages;
 };
 
 class ParseRecentMessages : public RecentMessages
@@ -235,8 +236,8 @@ public:
     {
         for (auto _ : state)
         {
-            auto parsed = recentmessages::detail::parseRecentMessages(
-                this->messages.object());
+            auto parsed =
+                recentmessages::detail::parseRecentMessages(this->messages);
             benchmark::DoNotOptimize(parsed);
         }
     }
@@ -252,12 +253,13 @@ public:
 
     void run(benchmark::State &state)
     {
-        auto parsed = recentmessages::detail::parseRecentMessages(
-            this->messages.object());
+        auto parsed =
+            recentmessages::detail::parseRecentMessages(this->messages);
         for (auto _ : state)
         {
+            auto lastDate = this->chan.lastDate_;
             auto built = recentmessages::detail::buildRecentMessages(
-                parsed, &this->chan);
+                parsed.messages, &this->chan, lastDate);
             benchmark::DoNotOptimize(built);
         }
     }
@@ -3,9 +3,12 @@
 
 #include <benchmark/benchmark.h>
 #include <boost/beast/core/flat_buffer.hpp>
+#include <boost/json.hpp>
 #include <QFile>
 
+#include <array>
 #include <memory>
+#include <string_view>
 
 namespace {
 
@@ -36,6 +39,31 @@ std::vector<boost::beast::flat_buffer> readMessages()
     return messages;
 }
 
+std::string_view viewOf(const boost::beast::flat_buffer &buffer)
+{
+    auto data = buffer.data();
+    return {static_cast<const char *>(data.data()), data.size()};
+}
+
+size_t totalSize(const std::vector<boost::beast::flat_buffer> &messages)
+{
+    size_t size = 0;
+    for (const auto &msg : messages)
+    {
+        size += msg.size();
+    }
+    return size;
+}
+
+void setProcessed(benchmark::State &state,
+                  const std::vector<boost::beast::flat_buffer> &messages)
+{
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() *
+                                                 messages.size()));
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * totalSize(messages)));
+}
+
 class NoopListener : public Listener
 {
 public:
@@ -128,8 +156,56 @@ void BM_ParseAndHandleMessages(benchmark::State &state)
             assert(!ec);
         }
     }
+    setProcessed(state, messages);
+}
+
+/// Only builds the DOM, on the default heap (how messages used to be parsed)
+void BM_ParseJsonHeap(benchmark::State &state)
+{
+    auto messages = readMessages();
+
+    for (auto _ : state)
+    {
+        for (const auto &msg : messages)
+        {
+            boost::system::error_code ec;
+            auto jv = boost::json::parse(viewOf(msg), ec);
+            assert(!ec);
+            benchmark::DoNotOptimize(&jv);
+        }
+    }
+    setProcessed(state, messages);
+}
+
+/// Only builds the DOM, in a per-message arena (like handleMessage)
+void BM_ParseJsonArena(benchmark::State &state)
+{
+    auto messages = readMessages();
+
+    for (auto _ : state)
+    {
+        for (const auto &msg : messages)
+        {
+            std::array<unsigned char, 16 * 1024> arena;
+            boost::json::monotonic_resource resource(arena.data(),
+                                                     arena.size());
+            std::array<unsigned char, 4 * 1024> parserBuffer;
+            boost::json::parser parser({}, {}, parserBuffer.data(),
+                                       parserBuffer.size());
+            parser.reset(&resource);
+
+            boost::system::error_code ec;
+            parser.write(viewOf(msg), ec);
+            assert(!ec);
+            auto jv = parser.release();
+            benchmark::DoNotOptimize(&jv);
+        }
+    }
+    setProcessed(state, messages);
 }
 
 }  // namespace
 
 BENCHMARK(BM_ParseAndHandleMessages);
+BENCHMARK(BM_ParseJsonHeap);
+BENCHMARK(BM_ParseJsonArena);
@@ -17,6 +17,9 @@ class Listener;
  *
  * This is called from the Session, and is only provided if you are interested
  * in building your own boost asio framework thing
+ *
+ * The JSON is parsed into a per-message arena, so the `boost::json::value`
+ * passed to Listener::onNotification is only valid during that call.
  **/
 boost::system::error_code handleMessage(
     std::unique_ptr<Listener> &listener,
@@ -48,6 +51,10 @@ public:
 
     void close();
 
+    /// Drops the connection without a close handshake. Pending operations
+    /// complete with an error.
+    void terminate();
+
     Listener *getListener();
 
 private:
@@ -19,6 +19,7 @@
 #include <iostream>
 #include <memory>
 #include <sstream>
+#include <string_view>
 #include <unordered_map>
 
 namespace beast = boost::beast;
@@ -45,6 +46,14 @@ using MessageHandlers = std::unordered_map<
 
 namespace {
 
+    /// Memory for the JSON DOM of a single message. Notifications are usually
+    /// 1-2 KiB of JSON, so their DOM fits comfortably. Larger messages
+    /// continue on the heap.
+    constexpr size_t MESSAGE_ARENA_SIZE = 16 * 1024;
+
+    /// Memory the parser uses for keys and strings it's still reading
+    constexpr size_t PARSER_BUFFER_SIZE = 4 * 1024;
+
     // Report a failure
     void fail(beast::error_code ec, char const *what)
     {
@@ -217,14 +226,29 @@ namespace {
 boost::system::error_code handleMessage(std::unique_ptr<Listener> &listener,
                                         const beast::flat_buffer &buffer)
 {
+    // The DOM only lives until the listener returns, so it's allocated from a
+    // per-message arena on the stack that's dropped all at once afterwards.
+    std::array<unsigned char, MESSAGE_ARENA_SIZE> arena;
+    boost::json::monotonic_resource resource(arena.data(), arena.size());
+
+    std::array<unsigned char, PARSER_BUFFER_SIZE> parserBuffer;
+    boost::json::parser parser({}, {}, parserBuffer.data(),
+                               parserBuffer.size());
+    parser.reset(&resource);
+
+    // A flat_buffer is contiguous, so we can parse the frame in place
+    auto data = buffer.data();
+    std::string_view message(static_cast<const char *>(data.data()),
+                             data.size());
+
     boost::system::error_code parseError;
-    auto jv =
-        boost::json::parse(beast::buffers_to_string(buffer.data()), parseError);
+    parser.write(message, parseError);
     if (parseError)
     {
         // TODO: wrap error?
         return parseError;
     }
+    auto jv = parser.release();
 
     const auto *jvObject = jv.if_object();
     if (jvObject == nullptr)
@@ -299,6 +323,12 @@ void Session::close()
         beast::bind_front_handler(&Session::onClose, shared_from_this()));
 }
 
+void Session::terminate()
+{
+    this->resolver.cancel();
+    beast::get_lowest_layer(this->ws).close();
+}
+
 Listener *Session::getListener()
 {
     return this->listener.get();
@@ -71,6 +71,11 @@ public:
         return nullptr;
     }
 
+    CompletionUsage *getCompletionUsage() override
+    {
+        return nullptr;
+    }
+
     Args args;
     Settings settings;
     Updates updates;
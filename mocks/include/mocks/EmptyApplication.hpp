@@ -174,6 +174,13 @@ public:
         return nullptr;
     }
 
+    CompletionUsage *getCompletionUsage() override
+    {
+        assert(false && "EmptyApplication::getCompletionUsage was called "
+                        "without being initialized");
+        return nullptr;
+    }
+
     ISoundController *getSound() override
     {
         assert(!"getSound was called without being initialized");
@@ -19,6 +19,11 @@ public:
                  const QString &platformName, const QString &streamID),
                 (override));
 
+    MOCK_METHOD(void, addRawMessage,
+                (const QString &channelName, const QByteArray &message,
+                 const QString &platformName),
+                (override));
+
     MOCK_METHOD(void, closeChannel,
                 (const QString &channelName, const QString &platformName),
                 (override));
@@ -37,6 +42,12 @@ public:
         //
     }
 
+    void addRawMessage(const QString &channelName, const QByteArray &message,
+                       const QString &platformName) override
+    {
+        //
+    }
+
     void closeChannel(const QString &channelName,
                       const QString &platformName) override
     {
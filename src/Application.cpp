@@ -7,6 +7,7 @@
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/commands/Command.hpp"
 #include "controllers/commands/CommandController.hpp"
+#include "controllers/completion/CompletionUsage.hpp"
 #include "controllers/highlights/HighlightController.hpp"
 #include "controllers/hotkeys/HotkeyController.hpp"
 #include "controllers/ignores/IgnoreController.hpp"
@@ -30,6 +31,7 @@
 #include "controllers/twitch/LiveController.hpp"
 #include "controllers/userdata/UserDataController.hpp"
 #include "debug/AssertInGuiThread.hpp"
+#include "debug/Trace.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/bttv/BttvLiveUpdates.hpp"
@@ -187,6 +189,7 @@ Application::Application(Settings &_settings, const Paths &paths,
     , seventvPaints(new SeventvPaints)
     , seventvPersonalEmotes(new SeventvPersonalEmotes)
     , userData(new UserDataController(paths))
+    , completionUsage(new CompletionUsage(paths))
     , sound(makeSoundController(_settings))
     , twitchLiveController(new TwitchLiveController)
     , twitchPubSub(new PubSub(TWITCH_PUBSUB_URL))
@@ -218,6 +221,7 @@ Application::~Application()
 void Application::initialize(Settings &settings, const Paths &paths)
 {
     assert(!this->initialized);
+    TraceSpan span("Application::initialize");
 
     // Show changelog
     if (!this->args_.isFramelessEmbed &&
@@ -276,16 +280,26 @@ void Application::initialize(Settings &settings, const Paths &paths)
         getSettings()->currentVersion.setValue(CHATTERINO_VERSION);
     }
 
-    this->accounts->load();
+    {
+        TraceSpan accountsSpan("AccountController::load");
+        this->accounts->load();
+    }
 
-    this->windows->initialize();
+    {
+        TraceSpan windowsSpan("WindowManager::initialize");
+        this->windows->initialize();
+    }
 
     this->ffzBadges->load();
 
     // Load global emotes
-    this->bttvEmotes->loadEmotes();
-    this->ffzEmotes->loadEmotes();
-    this->seventvEmotes->loadGlobalEmotes();
+    {
+        // The requests themselves show up as "network" spans
+        TraceSpan emotesSpan("Load global emotes");
+        this->bttvEmotes->loadEmotes();
+        this->ffzEmotes->loadEmotes();
+        this->seventvEmotes->loadGlobalEmotes();
+    }
 
     this->twitch->initialize();
 
@@ -483,6 +497,13 @@ IUserDataController *Application::getUserData()
     return this->userData.get();
 }
 
+CompletionUsage *Application::getCompletionUsage()
+{
+    assertInGuiThread();
+
+    return this->completionUsage.get();
+}
+
 ISoundController *Application::getSound()
 {
     assertInGuiThread();
@@ -662,6 +683,7 @@ void Application::save()
     this->commands->save();
     this->hotkeys->save();
     this->windows->save();
+    this->completionUsage->save();
 }
 
 void Application::initNm(const Paths &paths)
@@ -20,6 +20,7 @@ class HighlightController;
 class HotkeyController;
 class IUserDataController;
 class UserDataController;
+class CompletionUsage;
 class ISoundController;
 class SoundController;
 class ITwitchLiveController;
@@ -96,6 +97,7 @@ public:
     virtual FfzBadges *getFfzBadges() = 0;
     virtual SeventvBadges *getSeventvBadges() = 0;
     virtual IUserDataController *getUserData() = 0;
+    virtual CompletionUsage *getCompletionUsage() = 0;
     virtual ISoundController *getSound() = 0;
     virtual ITwitchLiveController *getTwitchLiveController() = 0;
 
@@ -173,6 +175,7 @@ private:
     std::unique_ptr<SeventvPaints> seventvPaints;
     std::unique_ptr<SeventvPersonalEmotes> seventvPersonalEmotes;
     std::unique_ptr<UserDataController> userData;
+    std::unique_ptr<CompletionUsage> completionUsage;
     std::unique_ptr<ISoundController> sound;
     std::unique_ptr<TwitchLiveController> twitchLiveController;
     std::unique_ptr<PubSub> twitchPubSub;
@@ -218,6 +221,7 @@ public:
     FfzBadges *getFfzBadges() override;
     SeventvBadges *getSeventvBadges() override;
     IUserDataController *getUserData() override;
+    CompletionUsage *getCompletionUsage() override;
     ISoundController *getSound() override;
     ITwitchLiveController *getTwitchLiveController() override;
     TwitchBadges *getTwitchBadges() override;
@@ -5,6 +5,7 @@
 #include "common/Modes.hpp"
 #include "common/network/NetworkManager.hpp"
 #include "common/QLogging.hpp"
+#include "debug/Trace.hpp"
 #include "singletons/CrashHandler.hpp"
 #include "singletons/Paths.hpp"
 #include "singletons/Resources.hpp"
@@ -264,6 +265,8 @@ void runGui(QApplication &a, const Paths &paths, Settings &settings,
     Application app(settings, paths, args, updates);
     app.initialize(settings, paths);
     app.run();
+    // Write the trace if Chatterino is closed before it was written
+    Trace::finish();
     app.save();
 
     settings.requestSave();
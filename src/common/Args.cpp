@@ -140,6 +140,13 @@ Args::Args(const QApplication &app, const Paths &paths)
         "specified, Twitch is assumed.",
         "t:channel");
 
+    QCommandLineOption traceOption(
+        "trace-startup",
+        "Records a trace of the first 30 seconds after starting Chatterino "
+        "and writes it to the supplied file. The trace can be opened in "
+        "Perfetto (ui.perfetto.dev) or chrome://tracing.",
+        "file");
+
     parser.addOptions({
         {{"V", "version"}, "Displays version information."},
         crashRecoveryOption,
@@ -152,6 +159,7 @@ Args::Args(const QApplication &app, const Paths &paths)
         loginOption,
         channelLayout,
         activateOption,
+        traceOption,
     });
 
     if (!parser.parse(app.arguments()))
@@ -216,6 +224,11 @@ Args::Args(const QApplication &app, const Paths &paths)
             parseActivateOption(parser.value(activateOption));
     }
 
+    if (parser.isSet(traceOption))
+    {
+        this->traceFile = parser.value(traceOption);
+    }
+
     this->currentArguments_ = extractCommandLine(parser, {
                                                              verboseOption,
                                                              safeModeOption,
@@ -29,6 +29,7 @@ class Paths;
 /// -c, --channels=t:channel1;t:channel2;...
 /// -a, --activate=t:channel
 ///     --safe-mode
+///     --trace-startup=file
 ///
 /// See documentation on `QGuiApplication` for documentation on Qt arguments like -platform.
 class Args
@@ -63,6 +64,8 @@ public:
     std::optional<QString> initialLogin;
     bool verbose{};
     bool safeMode{};
+    /// Where to write a trace of the startup, see `Trace`
+    std::optional<QString> traceFile;
 
     QStringList currentArguments() const;
 
@@ -48,6 +48,11 @@ const QString &Channel::getName() const
     return this->name_;
 }
 
+const QString &Channel::getPlatform() const
+{
+    return this->platform_;
+}
+
 const QString &Channel::getDisplayName() const
 {
     return this->getName();
@@ -83,6 +88,11 @@ LimitedQueueSnapshot<MessagePtr> Channel::getMessageSnapshot()
     return this->messages_.getSnapshot();
 }
 
+std::optional<std::pair<size_t, MessagePtr>> Channel::getLastMessage() const
+{
+    return this->messages_.lastWithIndex();
+}
+
 void Channel::addMessage(MessagePtr message, MessageContext context,
                          std::optional<MessageFlags> overridingFlags)
 {
@@ -105,7 +115,25 @@ void Channel::addMessage(MessagePtr message, MessageContext context,
         }
     }
 
-    if (this->messages_.pushBack(message, deleted))
+    bool removed = this->messages_.pushBack(message, deleted);
+    {
+        auto index = this->searchIndex_.access();
+        index->add(*message);
+        if (removed)
+        {
+            index->remove(*deleted);
+        }
+    }
+    {
+        auto users = this->userMessages_.access();
+        users->append(message);
+        if (removed)
+        {
+            users->remove(deleted);
+        }
+    }
+
+    if (removed)
     {
         this->messageRemovedFromStart(deleted);
     }
@@ -121,6 +149,8 @@ void Channel::addSystemMessage(const QString &contents)
 
 void Channel::addOrReplaceTimeout(MessagePtr message, const QDateTime &now)
 {
+    auto timeoutUser = message->timeoutUser;
+
     addOrReplaceChannelTimeout(
         this->getMessageSnapshot(), std::move(message), now,
         [this](auto /*idx*/, auto msg, auto replacement) {
@@ -128,8 +158,22 @@ void Channel::addOrReplaceTimeout(MessagePtr message, const QDateTime &now)
         },
         [this](auto msg) {
             this->addMessage(msg, MessageContext::Original);
-        },
-        true);
+        });
+
+    // disable the messages from the user
+    // this has to happen after the timeout was placed, because
+    // DontStackBeyondUserMessage stops at the user's enabled messages
+    for (const auto &userMessage : this->findMessagesByUser(timeoutUser))
+    {
+        if (userMessage->loginName == timeoutUser &&
+            userMessage->flags.hasNone({MessageFlag::Timeout,
+                                        MessageFlag::Untimeout,
+                                        MessageFlag::Whisper}))
+        {
+            // PAJLADA: Shitty solution described in Message.hpp
+            userMessage->flags.set(MessageFlag::Disabled);
+        }
+    }
 }
 
 void Channel::addOrReplaceClearChat(MessagePtr message, const QDateTime &now)
@@ -166,6 +210,14 @@ void Channel::addMessagesAtStart(const std::vector<MessagePtr> &_messages)
 {
     std::vector<MessagePtr> addedMessages =
         this->messages_.pushFront(_messages);
+    {
+        auto index = this->searchIndex_.access();
+        for (const auto &message : addedMessages)
+        {
+            index->add(*message);
+        }
+    }
+    this->userMessages_.access()->prepend(addedMessages);
 
     if (addedMessages.size() != 0)
     {
@@ -186,16 +238,36 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
         // There are no messages in this channel yet so we can just insert them
         // at the front in order
         this->messages_.pushFront(messages);
+        this->syncIndices();
         this->filledInMessages.invoke(messages);
         return;
     }
 
+    // We assume that the messages we are filling in are in ascending order by
+    // serverReceivedTime. Only messages in the channel that are at least as
+    // new as the first one can be duplicates or have to be inserted around,
+    // so we skip everything older. Usually these are only the few messages
+    // received since reconnecting.
+    const auto &firstTime = messages.front()->serverReceivedTime;
+    size_t start = snapshot.size();
+    while (start > 0)
+    {
+        const auto &msg = snapshot[start - 1];
+        if (!msg->flags.has(MessageFlag::System) &&
+            msg->serverReceivedTime < firstTime)
+        {
+            break;
+        }
+        start--;
+    }
+
     std::unordered_set<QString> existingMessageIds;
-    existingMessageIds.reserve(snapshot.size());
+    existingMessageIds.reserve(snapshot.size() - start);
 
-    // First, collect the ids of every message already present in the channel
-    for (const auto &msg : snapshot)
+    // First, collect the ids of every message that could be a duplicate
+    for (size_t i = start; i < snapshot.size(); i++)
     {
+        const auto &msg = snapshot[i];
         if (msg->flags.has(MessageFlag::System) || msg->id.isEmpty())
         {
             continue;
@@ -211,10 +283,11 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
     // being able to insert just-loaded historical messages at the end
     // in the correct place.
     auto lastMsg = snapshot[snapshot.size() - 1];
+    size_t position = start;
     for (const auto &msg : messages)
     {
         // check if message already exists
-        if (existingMessageIds.count(msg->id) != 0)
+        if (existingMessageIds.contains(msg->id))
         {
             continue;
         }
@@ -222,27 +295,22 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
         // If we get to this point, we know we'll be inserting a message
         anyInserted = true;
 
-        bool insertedFlag = false;
-        for (const auto &snapshotMsg : snapshot)
+        // Find the first message that comes after the current message. Since
+        // the messages are ascending, the next one can't go before it.
+        while (position < snapshot.size() &&
+               (snapshot[position]->flags.has(MessageFlag::System) ||
+                !(msg->serverReceivedTime <
+                  snapshot[position]->serverReceivedTime)))
         {
-            if (snapshotMsg->flags.has(MessageFlag::System))
-            {
-                continue;
-            }
-
-            if (msg->serverReceivedTime < snapshotMsg->serverReceivedTime)
-            {
-                // We found the first message that comes after the current message.
-                // Therefore, we can put the current message directly before. We
-                // assume that the messages we are filling in are in ascending
-                // order by serverReceivedTime.
-                this->messages_.insertBefore(snapshotMsg, msg);
-                insertedFlag = true;
-                break;
-            }
+            position++;
         }
 
-        if (!insertedFlag)
+        if (position < snapshot.size())
+        {
+            // We can put the current message directly before it.
+            this->messages_.insertBefore(snapshot[position], msg);
+        }
+        else
         {
             // We never found a message already in the channel that came after
             // the current message. Put it at the end and make sure to update
@@ -254,6 +322,9 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
 
     if (anyInserted)
     {
+        // Inserting into a full queue drops messages from the start
+        this->syncIndices();
+
         // We only invoke a signal once at the end of filling all messages to
         // prevent doing any unnecessary repaints.
         this->filledInMessages.invoke(messages);
@@ -267,6 +338,7 @@ void Channel::replaceMessage(const MessagePtr &message,
 
     if (index >= 0)
     {
+        this->replaceInIndices(message, replacement);
         this->messageReplaced.invoke((size_t)index, message, replacement);
     }
 }
@@ -276,6 +348,7 @@ void Channel::replaceMessage(size_t index, const MessagePtr &replacement)
     MessagePtr prev;
     if (this->messages_.replaceItem(index, replacement, &prev))
     {
+        this->replaceInIndices(prev, replacement);
         this->messageReplaced.invoke(index, prev, replacement);
     }
 }
@@ -286,6 +359,7 @@ void Channel::replaceMessage(size_t hint, const MessagePtr &message,
     auto index = this->messages_.replaceItem(hint, message, replacement);
     if (index >= 0)
     {
+        this->replaceInIndices(message, replacement);
         this->messageReplaced.invoke(hint, message, replacement);
     }
 }
@@ -302,9 +376,69 @@ void Channel::disableMessage(QString messageID)
 void Channel::clearMessages()
 {
     this->messages_.clear();
+    this->searchIndex_.access()->clear();
+    this->userMessages_.access()->clear();
     this->messagesCleared.invoke();
 }
 
+AccessGuard<MessageSearchIndex> Channel::accessSearchIndex()
+{
+    {
+        auto index = this->searchIndex_.access();
+        if (index->isActive())
+        {
+            return index;
+        }
+    }
+
+    // Building the index is expensive, so it's built without holding the
+    // lock. Otherwise adding messages on the GUI thread would block on it.
+    // The snapshot keeps its messages alive until the index is swapped in,
+    // so no message can reuse the address of one indexed here.
+    auto snapshot = this->getMessageSnapshot();
+    MessageSearchIndex built;
+    built.sync(snapshot);
+
+    auto index = this->searchIndex_.access();
+    if (!index->isActive())
+    {
+        // Catch up with the messages added and removed while building. This
+        // only indexes the new messages.
+        built.sync(this->getMessageSnapshot());
+        *index = std::move(built);
+    }
+    return index;
+}
+
+std::vector<MessagePtr> Channel::findMessagesByUser(
+    const QString &userName) const
+{
+    return this->userMessages_.access()->find(userName);
+}
+
+void Channel::syncIndices()
+{
+    auto snapshot = this->getMessageSnapshot();
+    this->userMessages_.access()->reset(snapshot);
+
+    auto index = this->searchIndex_.access();
+    if (index->isActive())
+    {
+        index->sync(snapshot);
+    }
+}
+
+void Channel::replaceInIndices(const MessagePtr &message,
+                               const MessagePtr &replacement)
+{
+    {
+        auto index = this->searchIndex_.access();
+        index->remove(*message);
+        index->add(*replacement);
+    }
+    this->userMessages_.access()->replace(message, replacement);
+}
+
 MessagePtr Channel::findMessage(QString messageID)
 {
     return this->findMessageByID(messageID);
@@ -1,10 +1,13 @@
 #pragma once
 
 #include "common/enums/MessageContext.hpp"
+#include "common/UniqueAccess.hpp"
 #include "controllers/completion/TabCompletionModel.hpp"
 #include "messages/LimitedQueue.hpp"
 #include "messages/MessageFlag.hpp"
 #include "messages/MessageSink.hpp"
+#include "messages/search/MessageSearchIndex.hpp"
+#include "messages/UserMessageIndex.hpp"
 
 #include <magic_enum/magic_enum.hpp>
 #include <pajlada/signals/signal.hpp>
@@ -14,6 +17,7 @@
 
 #include <memory>
 #include <optional>
+#include <utility>
 
 namespace chatterino {
 
@@ -71,12 +75,16 @@ public:
 
     Type getType() const;
     const QString &getName() const;
+    /// The platform this channel is logged as, e.g. "twitch"
+    const QString &getPlatform() const;
     virtual const QString &getDisplayName() const;
     virtual const QString &getLocalizedName() const;
     bool isTwitchChannel() const;
     bool isWatching() const;
     virtual bool isEmpty() const;
     LimitedQueueSnapshot<MessagePtr> getMessageSnapshot();
+    /// Returns the last message and its index without taking a snapshot
+    std::optional<std::pair<size_t, MessagePtr>> getLastMessage() const;
 
     // MESSAGES
     // overridingFlags can be filled in with flags that should be used instead
@@ -111,6 +119,15 @@ public:
 
     bool hasMessages() const;
 
+    /// Returns the search index over the messages of this channel.
+    /// The index is built on first use and kept up to date afterwards.
+    AccessGuard<MessageSearchIndex> accessSearchIndex();
+
+    /// Returns the messages concerning `userName`, oldest first.
+    /// These are the messages the user sent, moderation actions against them
+    /// and subscription notices about them (see UserMessageIndex).
+    std::vector<MessagePtr> findMessagesByUser(const QString &userName) const;
+
     void applySimilarityFilters(const MessagePtr &message) const final;
 
     MessageSinkTraits sinkTraits() const final;
@@ -142,8 +159,15 @@ protected:
     QString platform_{"other"};
 
 private:
+    /// Rebuilds the indices after messages were inserted in the middle
+    void syncIndices();
+    void replaceInIndices(const MessagePtr &message,
+                          const MessagePtr &replacement);
+
     const QString name_;
     LimitedQueue<MessagePtr> messages_;
+    UniqueAccess<MessageSearchIndex> searchIndex_;
+    UniqueAccess<UserMessageIndex> userMessages_;
     Type type_;
     bool anythingLogged_ = false;
     QTimer clearCompletionModelTimer_;
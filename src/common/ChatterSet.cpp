@@ -2,6 +2,9 @@
 
 #include "debug/Benchmark.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 namespace chatterino {
 
 ChatterSet::ChatterSet()
@@ -11,7 +14,7 @@ ChatterSet::ChatterSet()
 
 void ChatterSet::addRecentChatter(const QString &userName)
 {
-    this->items.put(userName.toLower(), userName);
+    this->insert(userName.toLower(), userName);
 }
 
 void ChatterSet::updateOnlineChatters(
@@ -19,24 +22,33 @@ void ChatterSet::updateOnlineChatters(
 {
     BenchmarkGuard bench("update online chatters");
 
-    // Create a new lru cache without the users that are not present anymore.
-    cache::lru_cache<QString, QString> tmp(ChatterSet::CHATTER_LIMIT);
-
-    for (auto &&chatter : lowerCaseUsernames)
+    // Remove the users that are not present anymore.
+    std::vector<QString> offline;
+    for (const auto &item : this->items)
     {
-        if (this->items.exists(chatter))
+        if (!lowerCaseUsernames.contains(item.first))
         {
-            tmp.put(chatter, this->items.get(chatter));
-
-            // Less chatters than the limit => try to preserve as many as possible.
+            offline.push_back(item.first);
         }
-        else if (lowerCaseUsernames.size() < ChatterSet::CHATTER_LIMIT)
+    }
+    for (const auto &chatter : offline)
+    {
+        this->remove(chatter);
+    }
+
+    // Less chatters than the limit => try to preserve as many as possible.
+    if (lowerCaseUsernames.size() >= ChatterSet::CHATTER_LIMIT)
+    {
+        return;
+    }
+
+    for (const auto &chatter : lowerCaseUsernames)
+    {
+        if (!this->items.exists(chatter))
         {
-            tmp.put(chatter, chatter);
+            this->insert(chatter, chatter);
         }
     }
-
-    this->items = std::move(tmp);
 }
 
 bool ChatterSet::contains(const QString &userName) const
@@ -44,19 +56,30 @@ bool ChatterSet::contains(const QString &userName) const
     return this->items.exists(userName.toLower());
 }
 
-std::vector<QString> ChatterSet::filterByPrefix(const QString &prefix) const
+std::vector<std::pair<QString, QString>> ChatterSet::filterByPrefix(
+    const QString &prefix) const
 {
     QString lowerPrefix = prefix.toLower();
-    std::vector<QString> result;
+    std::vector<std::pair<const QString *, const IndexEntry *>> matches;
 
-    for (auto &&item : this->items)
+    for (auto it = this->sortedNames.lower_bound(lowerPrefix);
+         it != this->sortedNames.end() && it->first.startsWith(lowerPrefix);
+         ++it)
     {
-        if (item.first.startsWith(lowerPrefix))
-        {
-            result.push_back(item.second);
-        }
+        matches.emplace_back(&it->first, &it->second);
     }
 
+    // Same order as the LRU: the most recently inserted chatter first
+    std::sort(matches.begin(), matches.end(), [](const auto &a, const auto &b) {
+        return a.second->lastInsert > b.second->lastInsert;
+    });
+
+    std::vector<std::pair<QString, QString>> result;
+    result.reserve(matches.size());
+    for (const auto &[lowerName, entry] : matches)
+    {
+        result.emplace_back(*lowerName, entry->userName);
+    }
     return result;
 }
 
@@ -65,4 +88,24 @@ std::vector<std::pair<QString, QString>> ChatterSet::all() const
     return {this->items.begin(), this->items.end()};
 }
 
+void ChatterSet::insert(const QString &lowerName, const QString &userName)
+{
+    if (!this->items.exists(lowerName) &&
+        this->items.size() >= ChatterSet::CHATTER_LIMIT)
+    {
+        // The least recently used chatter is about to be evicted by `put`
+        this->sortedNames.erase(std::prev(this->items.end())->first);
+    }
+
+    this->items.put(lowerName, userName);
+    this->sortedNames.insert_or_assign(
+        lowerName, IndexEntry{userName, ++this->insertCount});
+}
+
+void ChatterSet::remove(const QString &lowerName)
+{
+    this->items.erase(lowerName);
+    this->sortedNames.erase(lowerName);
+}
+
 }  // namespace chatterino
@@ -5,6 +5,8 @@
 #include <lrucache/lrucache.hpp>
 #include <QString>
 
+#include <cstdint>
+#include <map>
 #include <unordered_set>
 #include <vector>
 
@@ -25,24 +27,37 @@ public:
     void addRecentChatter(const QString &userName);
 
     /// Removes chatters that aren't online anymore. Adds chatters that aren't
-    /// in the list yet.
+    /// in the list yet. Chatters that are still online keep their position.
     void updateOnlineChatters(
         const std::unordered_set<QString> &lowerCaseUsernames);
 
     /// Checks if a username is in the list.
     bool contains(const QString &userName) const;
 
-    /// Get filtered usernames by a prefix for autocompletion. Contained items
-    /// are in mixed case if available.
-    std::vector<QString> filterByPrefix(const QString &prefix) const;
+    /// Get the chatters whose name starts with `prefix` for autocompletion.
+    /// Like all(), the first pair element contains the username in lowercase,
+    /// the second one the original case and recent chatters come first.
+    std::vector<std::pair<QString, QString>> filterByPrefix(
+        const QString &prefix) const;
 
     /// Get all recent chatters. The first pair element contains the username
     /// in lowercase, while the second pair element is the original case.
     std::vector<std::pair<QString, QString>> all() const;
 
 private:
+    void insert(const QString &lowerName, const QString &userName);
+    void remove(const QString &lowerName);
+
     // user name in lower case -> user name in normal case
     cache::lru_cache<QString, QString> items;
+    struct IndexEntry {
+        QString userName;
+        // the value of `insertCount` when this chatter was last inserted
+        uint64_t lastInsert = 0;
+    };
+    // same as `items`, but sorted by the lower case name for prefix lookups
+    std::map<QString, IndexEntry> sortedNames;
+    uint64_t insertCount = 0;
 };
 
 using ChatterSet = ChatterSet;
@@ -0,0 +1,166 @@
+#include "common/network/IoContextPool.hpp"
+
+#include "common/QLogging.hpp"
+#include "util/DebugCount.hpp"
+#include "util/RenameThread.hpp"
+
+#include <QStringBuilder>
+
+#include <algorithm>
+#include <cassert>
+#include <exception>
+
+namespace {
+
+using namespace chatterino;
+
+/// Websocket clients are mostly idle, two threads are plenty even with every
+/// provider enabled
+constexpr unsigned MAX_THREADS = 2;
+
+void runWorker(boost::asio::io_context &context)
+{
+    while (true)
+    {
+        try
+        {
+            context.run();
+            return;
+        }
+        catch (const std::exception &e)
+        {
+            // A single misbehaving handler shouldn't take down the other
+            // clients on this context
+            qCWarning(chatterinoWebsocket)
+                << "Exception in websocket thread:" << e.what();
+        }
+    }
+}
+
+}  // namespace
+
+namespace chatterino {
+
+IoContextPool::IoContextPool(size_t threadCount)
+    : tlsContext_(std::make_shared<boost::asio::ssl::context>(
+          boost::asio::ssl::context::tlsv12))
+{
+    assert(threadCount > 0);
+
+    try
+    {
+        this->tlsContext_->set_options(
+            boost::asio::ssl::context::default_workarounds |
+            boost::asio::ssl::context::no_sslv2 |
+            boost::asio::ssl::context::single_dh_use);
+    }
+    catch (const std::exception &e)
+    {
+        qCDebug(chatterinoWebsocket)
+            << "Exception caught while creating the TLS context:" << e.what();
+    }
+
+    for (size_t i = 0; i < threadCount; i++)
+    {
+        auto &worker = this->workers_.emplace_back(std::make_unique<Worker>());
+        worker->thread = std::thread([context = &worker->context] {
+            runWorker(*context);
+        });
+        renameThread(worker->thread, "Websockets-" % QString::number(i));
+    }
+
+    DebugCount::configure("websocket bytes received",
+                          DebugCount::Flag::DataSize);
+    DebugCount::configure("websocket bytes sent", DebugCount::Flag::DataSize);
+}
+
+IoContextPool::~IoContextPool()
+{
+    for (auto &worker : this->workers_)
+    {
+        // All clients should have released their context by now, don't wait
+        // for stragglers
+        worker->work.reset();
+        worker->context.stop();
+    }
+
+    for (auto &worker : this->workers_)
+    {
+        if (worker->thread.joinable())
+        {
+            worker->thread.join();
+        }
+    }
+}
+
+IoContextPool &IoContextPool::instance()
+{
+    // Leaked on purpose: clients may still be closing their connections while
+    // static objects are destroyed
+    static auto *instance = new IoContextPool(std::clamp(
+        std::thread::hardware_concurrency() / 4, 1U, MAX_THREADS));
+    return *instance;
+}
+
+boost::asio::io_context &IoContextPool::acquire()
+{
+    std::lock_guard lock(this->mutex_);
+
+    auto it = std::min_element(this->workers_.begin(), this->workers_.end(),
+                               [](const auto &a, const auto &b) {
+                                   return a->clients < b->clients;
+                               });
+    (*it)->clients++;
+    return (*it)->context;
+}
+
+void IoContextPool::release(boost::asio::io_context &context)
+{
+    std::lock_guard lock(this->mutex_);
+
+    auto &worker = this->workerOf(context);
+    assert(worker.clients > 0);
+    worker.clients--;
+}
+
+std::thread::id IoContextPool::threadOf(
+    const boost::asio::io_context &context) const
+{
+    std::lock_guard lock(this->mutex_);
+
+    return this->workerOf(context).thread.get_id();
+}
+
+size_t IoContextPool::threadCount() const
+{
+    return this->workers_.size();
+}
+
+std::shared_ptr<boost::asio::ssl::context> IoContextPool::tlsContext() const
+{
+    return this->tlsContext_;
+}
+
+void IoContextPool::addBytesReceived(size_t bytes)
+{
+    DebugCount::increase("websocket bytes received",
+                         static_cast<int64_t>(bytes));
+}
+
+void IoContextPool::addBytesSent(size_t bytes)
+{
+    DebugCount::increase("websocket bytes sent", static_cast<int64_t>(bytes));
+}
+
+IoContextPool::Worker &IoContextPool::workerOf(
+    const boost::asio::io_context &context) const
+{
+    auto it = std::find_if(this->workers_.begin(), this->workers_.end(),
+                           [&](const auto &worker) {
+                               return &worker->context == &context;
+                           });
+    assert(it != this->workers_.end());
+    return **it;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ssl/context.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace chatterino {
+
+/**
+ * @brief Event loops shared by all websocket clients.
+ *
+ * Twitch PubSub, EventSub and the live update managers (7TV, BTTV) don't run
+ * their own threads. Each of them is pinned to one of a few `io_context`s of
+ * this pool instead. Every context is run by exactly one thread, so a client's
+ * handlers never run concurrently - just like they did on its own thread.
+ *
+ * The pool also owns the TLS context of the websocketpp clients and counts the
+ * bytes they send and receive.
+ */
+class IoContextPool
+{
+public:
+    explicit IoContextPool(size_t threadCount);
+    ~IoContextPool();
+
+    IoContextPool(const IoContextPool &) = delete;
+    IoContextPool(IoContextPool &&) = delete;
+    IoContextPool &operator=(const IoContextPool &) = delete;
+    IoContextPool &operator=(IoContextPool &&) = delete;
+
+    /// The pool used by all websocket clients. It runs until the program
+    /// exits.
+    static IoContextPool &instance();
+
+    /// Returns the context with the fewest clients. The caller counts as a
+    /// client of it until it calls release().
+    boost::asio::io_context &acquire();
+    void release(boost::asio::io_context &context);
+
+    /// Returns the ID of the thread running `context`
+    std::thread::id threadOf(const boost::asio::io_context &context) const;
+
+    size_t threadCount() const;
+
+    /// Returns the TLS context for websocketpp connections
+    std::shared_ptr<boost::asio::ssl::context> tlsContext() const;
+
+    static void addBytesReceived(size_t bytes);
+    static void addBytesSent(size_t bytes);
+
+private:
+    struct Worker {
+        boost::asio::io_context context{1};
+        boost::asio::executor_work_guard<boost::asio::io_context::executor_type>
+            work{context.get_executor()};
+        std::thread thread;
+        size_t clients = 0;
+    };
+
+    Worker &workerOf(const boost::asio::io_context &context) const;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    mutable std::mutex mutex_;
+
+    std::shared_ptr<boost::asio::ssl::context> tlsContext_;
+};
+
+}  // namespace chatterino
@@ -26,6 +26,17 @@ enum class NetworkRequestType {
     Patch,
 };
 
+/// Decides the order in which queued requests are started, see
+/// NetworkScheduler
+enum class NetworkPriority {
+    /// Requests the user is waiting for (API calls, user actions)
+    Interactive,
+    /// Images that are currently being painted
+    Images,
+    /// Prefetching and anything else nobody is actively waiting for
+    Background,
+};
+
 // parseHeaderList takes a list of headers in string form,
 // where each header pair is separated by semicolons (;) and the header name and value is divided by a colon (:)
 //
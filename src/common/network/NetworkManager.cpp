@@ -1,16 +1,20 @@
 #include "common/network/NetworkManager.hpp"
 
+#include "common/network/NetworkScheduler.hpp"
+
 #include <QNetworkAccessManager>
 
 namespace chatterino {
 
 QThread *NetworkManager::workerThread = nullptr;
 QNetworkAccessManager *NetworkManager::accessManager = nullptr;
+network::detail::NetworkScheduler *NetworkManager::scheduler = nullptr;
 
 void NetworkManager::init()
 {
     assert(!NetworkManager::workerThread);
     assert(!NetworkManager::accessManager);
+    assert(!NetworkManager::scheduler);
 
     NetworkManager::workerThread = new QThread;
     NetworkManager::workerThread->setObjectName("NetworkWorker");
@@ -18,12 +22,20 @@ void NetworkManager::init()
 
     NetworkManager::accessManager = new QNetworkAccessManager;
     NetworkManager::accessManager->moveToThread(NetworkManager::workerThread);
+
+    NetworkManager::scheduler = new network::detail::NetworkScheduler;
 }
 
 void NetworkManager::deinit()
 {
     assert(NetworkManager::workerThread);
     assert(NetworkManager::accessManager);
+    assert(NetworkManager::scheduler);
+
+    // stop starting queued requests, the scheduler is deleted once the
+    // worker thread is done
+    auto *scheduler = NetworkManager::scheduler;
+    NetworkManager::scheduler = nullptr;
 
     // delete the access manager first:
     // - put the event on the worker thread
@@ -39,6 +51,8 @@ void NetworkManager::deinit()
 
     NetworkManager::workerThread->deleteLater();
     NetworkManager::workerThread = nullptr;
+
+    delete scheduler;
 }
 
 }  // namespace chatterino
@@ -3,6 +3,12 @@
 #include <QNetworkAccessManager>
 #include <QThread>
 
+namespace chatterino::network::detail {
+
+class NetworkScheduler;
+
+}  // namespace chatterino::network::detail
+
 namespace chatterino {
 
 class NetworkManager : public QObject
@@ -12,6 +18,8 @@ class NetworkManager : public QObject
 public:
     static QThread *workerThread;
     static QNetworkAccessManager *accessManager;
+    /// Only used on the worker thread
+    static network::detail::NetworkScheduler *scheduler;
 
     static void init();
     static void deinit();
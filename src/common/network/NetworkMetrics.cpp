@@ -0,0 +1,220 @@
+#include "common/network/NetworkMetrics.hpp"
+
+#include "common/UniqueAccess.hpp"
+#include "util/QMagicEnum.hpp"
+
+#include <QJsonArray>
+#include <QLocale>
+#include <QStringBuilder>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <utility>
+
+namespace {
+
+using namespace chatterino;
+
+using StatsKey = std::pair<QString, NetworkRequestType>;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+UniqueAccess<std::map<StatsKey, std::unique_ptr<NetworkStats>>> STATS;
+
+uint64_t loadRelaxed(const std::atomic<uint64_t> &counter)
+{
+    return counter.load(std::memory_order_relaxed);
+}
+
+}  // namespace
+
+namespace chatterino {
+
+void LatencyHistogram::record(std::chrono::milliseconds latency)
+{
+    auto ms = static_cast<uint64_t>(std::max<int64_t>(latency.count(), 0));
+    this->buckets_[bucketOf(ms)].fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::count() const
+{
+    uint64_t total = 0;
+    for (const auto &bucket : this->buckets_)
+    {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+std::chrono::milliseconds LatencyHistogram::percentile(double percentile) const
+{
+    std::array<uint64_t, BUCKET_COUNT> counts{};
+    uint64_t total = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++)
+    {
+        counts[i] = this->buckets_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0)
+    {
+        return {};
+    }
+
+    auto target = static_cast<uint64_t>(
+        std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 *
+                  static_cast<double>(total)));
+    target = std::max<uint64_t>(target, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++)
+    {
+        seen += counts[i];
+        if (seen >= target)
+        {
+            return std::chrono::milliseconds(upperBound(i));
+        }
+    }
+    return std::chrono::milliseconds(upperBound(BUCKET_COUNT - 1));
+}
+
+uint64_t LatencyHistogram::upperBound(size_t bucket)
+{
+    if (bucket < 4)
+    {
+        return bucket + 1;
+    }
+
+    auto octave = (bucket - 4) / 4;
+    auto sub = (bucket - 4) % 4;
+    return (5 + sub) << octave;
+}
+
+uint64_t LatencyHistogram::bucketCount(size_t bucket) const
+{
+    return this->buckets_.at(bucket).load(std::memory_order_relaxed);
+}
+
+size_t LatencyHistogram::bucketOf(uint64_t ms)
+{
+    // 0-3ms get a bucket each, after that every power of two is split into
+    // four buckets
+    if (ms < 4)
+    {
+        return static_cast<size_t>(ms);
+    }
+
+    ms = std::min<uint64_t>(ms, (uint64_t{1} << 20) - 1);
+    auto octave = static_cast<size_t>(std::bit_width(ms)) - 3;
+    auto sub = static_cast<size_t>(ms >> octave) & 3;
+    return 4 + (octave * 4) + sub;
+}
+
+NetworkStats &NetworkMetrics::get(const QString &host, NetworkRequestType type)
+{
+    auto stats = STATS.access();
+
+    auto &entry = (*stats)[{host, type}];
+    if (!entry)
+    {
+        entry = std::make_unique<NetworkStats>();
+    }
+    return *entry;
+}
+
+QJsonObject NetworkMetrics::toJson()
+{
+    auto stats = STATS.access();
+
+    QJsonArray entries;
+    for (const auto &[key, entry] : *stats)
+    {
+        const auto &latency = entry->latency;
+
+        QJsonArray buckets;
+        for (size_t i = 0; i < LatencyHistogram::BUCKET_COUNT; i++)
+        {
+            auto count = latency.bucketCount(i);
+            if (count == 0)
+            {
+                continue;
+            }
+            buckets.append(QJsonObject{
+                {"le", static_cast<qint64>(LatencyHistogram::upperBound(i))},
+                {"count", static_cast<qint64>(count)},
+            });
+        }
+
+        entries.append(QJsonObject{
+            {"host", key.first},
+            {"type", qmagicenum::enumNameString(key.second)},
+            {"requests", static_cast<qint64>(loadRelaxed(entry->requests))},
+            {"succeeded", static_cast<qint64>(loadRelaxed(entry->succeeded))},
+            {"failed", static_cast<qint64>(loadRelaxed(entry->failed))},
+            {"timeouts", static_cast<qint64>(loadRelaxed(entry->timeouts))},
+            {"inFlight", static_cast<qint64>(
+                             entry->inFlight.load(std::memory_order_relaxed))},
+            {"bytesIn", static_cast<qint64>(loadRelaxed(entry->bytesIn))},
+            {"bytesOut", static_cast<qint64>(loadRelaxed(entry->bytesOut))},
+            {"cacheHits", static_cast<qint64>(loadRelaxed(entry->cacheHits))},
+            {"cacheMisses", static_cast<qint64>(
+                                loadRelaxed(entry->cacheMisses))},
+            {"revalidations", static_cast<qint64>(
+                                  loadRelaxed(entry->revalidations))},
+            {"coalesced", static_cast<qint64>(loadRelaxed(entry->coalesced))},
+            {"latencyMs",
+             QJsonObject{
+                 {"p50", static_cast<qint64>(latency.percentile(50).count())},
+                 {"p95", static_cast<qint64>(latency.percentile(95).count())},
+                 {"p99", static_cast<qint64>(latency.percentile(99).count())},
+                 {"buckets", buckets},
+             }},
+        });
+    }
+
+    return {{"hosts", entries}};
+}
+
+QString NetworkMetrics::getDebugText()
+{
+    static const QLocale locale(QLocale::English);
+
+    auto stats = STATS.access();
+
+    QString text;
+    for (const auto &[key, entry] : *stats)
+    {
+        const auto &latency = entry->latency;
+        auto number = [](uint64_t value) {
+            return locale.toString(static_cast<qulonglong>(value));
+        };
+
+        text += key.first % ' ' % qmagicenum::enumNameString(key.second) %
+                ": " % number(loadRelaxed(entry->requests)) % " requests (" %
+                number(loadRelaxed(entry->succeeded)) % " ok, " %
+                number(loadRelaxed(entry->failed)) % " failed, " %
+                number(loadRelaxed(entry->timeouts)) % " timed out), " %
+                QString::number(
+                    entry->inFlight.load(std::memory_order_relaxed)) %
+                " in flight\n";
+        text += "  p50/p95/p99: " %
+                QString::number(latency.percentile(50).count()) % '/' %
+                QString::number(latency.percentile(95).count()) % '/' %
+                QString::number(latency.percentile(99).count()) % " ms, in: " %
+                locale.formattedDataSize(
+                    static_cast<qint64>(loadRelaxed(entry->bytesIn))) %
+                ", out: " %
+                locale.formattedDataSize(
+                    static_cast<qint64>(loadRelaxed(entry->bytesOut))) %
+                '\n';
+        text += "  cache: " % number(loadRelaxed(entry->cacheHits)) %
+                " hits, " % number(loadRelaxed(entry->cacheMisses)) %
+                " misses, " % number(loadRelaxed(entry->revalidations)) %
+                " revalidated, " % number(loadRelaxed(entry->coalesced)) %
+                " coalesced\n";
+    }
+    return text;
+}
+
+}  // namespace chatterino
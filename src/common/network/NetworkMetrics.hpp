@@ -0,0 +1,93 @@
+#pragma once
+
+#include "common/network/NetworkCommon.hpp"
+
+#include <QJsonObject>
+#include <QString>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace chatterino {
+
+/**
+ * @brief A lock-free histogram of request latencies.
+ *
+ * Latencies are sorted into buckets with four buckets per power of two
+ * milliseconds, so percentiles are accurate to about 25%. Latencies above
+ * ~17 minutes end up in the last bucket.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr size_t BUCKET_COUNT = 76;
+
+    void record(std::chrono::milliseconds latency);
+
+    uint64_t count() const;
+
+    /// Returns the upper bound of the bucket containing the `percentile`
+    /// (0-100), or 0 if nothing was recorded
+    std::chrono::milliseconds percentile(double percentile) const;
+
+    /// Returns the exclusive upper bound in milliseconds of `bucket`
+    static uint64_t upperBound(size_t bucket);
+
+    /// Returns the number of latencies recorded in `bucket`
+    uint64_t bucketCount(size_t bucket) const;
+
+private:
+    static size_t bucketOf(uint64_t ms);
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_{};
+};
+
+/// Metrics of requests of one type to one host.
+/// All counters are updated with relaxed atomics.
+struct NetworkStats {
+    /// Requests sent over the network
+    std::atomic<uint64_t> requests{};
+    std::atomic<uint64_t> succeeded{};
+    std::atomic<uint64_t> failed{};
+    std::atomic<uint64_t> timeouts{};
+    std::atomic<int64_t> inFlight{};
+
+    std::atomic<uint64_t> bytesIn{};
+    std::atomic<uint64_t> bytesOut{};
+
+    /// Requests answered from the disk cache
+    std::atomic<uint64_t> cacheHits{};
+    /// Cacheable requests that had to go to the network
+    std::atomic<uint64_t> cacheMisses{};
+    /// Replies with "304 Not Modified"
+    std::atomic<uint64_t> revalidations{};
+    /// Requests that joined an identical in-flight request
+    std::atomic<uint64_t> coalesced{};
+
+    /// Time from sending a request until the reply finished
+    LatencyHistogram latency;
+
+    static void add(std::atomic<uint64_t> &counter, uint64_t amount = 1)
+    {
+        counter.fetch_add(amount, std::memory_order_relaxed);
+    }
+};
+
+/// Collects NetworkStats per host and request type
+class NetworkMetrics
+{
+public:
+    /// Returns the stats for requests of `type` to `host`. The reference stays
+    /// valid until the program exits, so it can be held on to.
+    static NetworkStats &get(const QString &host, NetworkRequestType type);
+
+    /// Returns all stats as JSON, e.g. for dashboards
+    static QJsonObject toJson();
+
+    static QString getDebugText();
+};
+
+}  // namespace chatterino
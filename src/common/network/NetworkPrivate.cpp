@@ -2,6 +2,7 @@
 
 #include "Application.hpp"
 #include "common/network/NetworkManager.hpp"
+#include "common/network/NetworkMetrics.hpp"
 #include "common/network/NetworkResult.hpp"
 #include "common/network/NetworkTask.hpp"
 #include "common/QLogging.hpp"
@@ -52,7 +53,7 @@ void loadUncached(std::shared_ptr<NetworkData> &&data)
     worker->moveToThread(NetworkManager::workerThread);
 
     QObject::connect(&requester, &NetworkRequester::requestUrl, worker,
-                     &NetworkTask::run);
+                     &NetworkTask::schedule);
 
     requester.requestUrl();
 }
@@ -61,15 +62,19 @@ void loadCached(std::shared_ptr<NetworkData> &&data)
 {
     QFile cachedFile(getApp()->getPaths().cacheDirectory() + "/" +
                      data->getHash());
+    auto &stats =
+        NetworkMetrics::get(data->request.url().host(), data->requestType);
 
     if (!cachedFile.exists() || !cachedFile.open(QIODevice::ReadOnly))
     {
+        NetworkStats::add(stats.cacheMisses);
         loadUncached(std::move(data));
         return;
     }
 
     // XXX: check if bytes is empty?
     QByteArray bytes = cachedFile.readAll();
+    NetworkStats::add(stats.cacheHits);
 
     qCDebug(chatterinoHTTP).noquote() << data->typeString() << "[CACHED] 200"
                                       << data->request.url().toString();
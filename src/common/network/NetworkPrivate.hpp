@@ -40,6 +40,7 @@ public:
     QPointer<QObject> caller;
     bool cache{};
     bool executeConcurrently{};
+    NetworkPriority priority = NetworkPriority::Interactive;
 
     NetworkSuccessCallback onSuccess;
     NetworkErrorCallback onError;
@@ -128,6 +128,12 @@ NetworkRequest NetworkRequest::concurrent() &&
     return std::move(*this);
 }
 
+NetworkRequest NetworkRequest::priority(NetworkPriority priority) &&
+{
+    this->data->priority = priority;
+    return std::move(*this);
+}
+
 NetworkRequest NetworkRequest::multiPart(QHttpMultiPart *payload) &&
 {
     this->data->multiPartPayload = {payload, {}};
@@ -65,6 +65,9 @@ public:
         const std::vector<std::pair<QByteArray, QByteArray>> &headers) &&;
     NetworkRequest timeout(int ms) &&;
     NetworkRequest concurrent() &&;
+    /// Requests with a higher priority are started first when there are more
+    /// requests than free connections. Defaults to NetworkPriority::Interactive.
+    NetworkRequest priority(NetworkPriority priority) &&;
     NetworkRequest multiPart(QHttpMultiPart *payload) &&;
     /**
      * This will change `RedirectPolicyAttribute`.
@@ -10,8 +10,9 @@
 namespace chatterino {
 
 NetworkResult::NetworkResult(NetworkError error, const QVariant &httpStatusCode,
-                             QByteArray data)
+                             QByteArray data, Headers headers)
     : data_(std::move(data))
+    , headers_(std::move(headers))
     , error_(error)
 {
     if (httpStatusCode.isValid())
@@ -65,6 +66,18 @@ const QByteArray &NetworkResult::getData() const
     return this->data_;
 }
 
+QByteArray NetworkResult::header(const QByteArray &name) const
+{
+    for (const auto &[key, value] : this->headers_)
+    {
+        if (key.compare(name, Qt::CaseInsensitive) == 0)
+        {
+            return value;
+        }
+    }
+    return {};
+}
+
 QString NetworkResult::formatError() const
 {
     // Print the status for errors that mirror HTTP status codes (=0 || >99)
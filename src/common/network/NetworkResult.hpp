@@ -14,8 +14,10 @@ class NetworkResult
 public:
     using NetworkError = QNetworkReply::NetworkError;
 
+    using Headers = QList<QNetworkReply::RawHeaderPair>;
+
     NetworkResult(NetworkError error, const QVariant &httpStatusCode,
-                  QByteArray data);
+                  QByteArray data, Headers headers = {});
 
     /// Parses the result as json and returns the root as an object.
     /// Returns empty object if parsing failed.
@@ -27,6 +29,10 @@ public:
     rapidjson::Document parseRapidJson() const;
     const QByteArray &getData() const;
 
+    /// Returns the value of the response header `name` (case insensitive) or
+    /// an empty array if the header wasn't sent
+    QByteArray header(const QByteArray &name) const;
+
     /// The error code of the reply.
     /// In case of a successful reply, this will be NoError (0)
     NetworkError error() const
@@ -46,6 +52,7 @@ public:
 
 private:
     QByteArray data_;
+    Headers headers_;
 
     NetworkError error_;
     std::optional<int> status_;
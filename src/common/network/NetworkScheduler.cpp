@@ -0,0 +1,193 @@
+#include "common/network/NetworkScheduler.hpp"
+
+#include "util/DebugCount.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace chatterino::network::detail {
+
+NetworkScheduler::NetworkScheduler(size_t perHostLimit, size_t totalLimit,
+                                   size_t reservedSlots)
+    : perHostLimit_(std::max<size_t>(perHostLimit, 1))
+    , totalLimit_(std::max<size_t>(totalLimit, 1))
+    , reservedSlots_(std::min(reservedSlots, this->totalLimit_ - 1))
+{
+}
+
+NetworkScheduler::JobID NetworkScheduler::schedule(NetworkPriority priority,
+                                                   const QString &host,
+                                                   Job start)
+{
+    auto index = static_cast<size_t>(priority);
+    assert(index < PRIORITY_COUNT);
+
+    auto &queue = this->hosts_[host].queues[index];
+    if (queue.empty())
+    {
+        this->waiting_[index].push_back(host);
+    }
+    auto id = this->nextID_++;
+    queue.push_back({id, std::move(start)});
+    this->queued_++;
+
+    this->dispatch();
+    return id;
+}
+
+void NetworkScheduler::raise(const QString &host, JobID id,
+                             NetworkPriority priority)
+{
+    auto target = static_cast<size_t>(priority);
+    assert(target < PRIORITY_COUNT);
+
+    auto it = this->hosts_.find(host);
+    if (it == this->hosts_.end())
+    {
+        return;
+    }
+
+    auto &queues = it->second.queues;
+    for (size_t index = target + 1; index < PRIORITY_COUNT; index++)
+    {
+        auto &queue = queues[index];
+        auto job = std::ranges::find(queue, id, &QueuedJob::id);
+        if (job == queue.end())
+        {
+            continue;
+        }
+
+        auto &targetQueue = queues[target];
+        if (targetQueue.empty())
+        {
+            this->waiting_[target].push_back(host);
+        }
+        targetQueue.push_back(std::move(*job));
+
+        queue.erase(job);
+        if (queue.empty())
+        {
+            std::erase(this->waiting_[index], host);
+        }
+
+        this->dispatch();
+        return;
+    }
+}
+
+void NetworkScheduler::finished(const QString &host)
+{
+    auto it = this->hosts_.find(host);
+    assert(it != this->hosts_.end() && it->second.active > 0);
+    if (it == this->hosts_.end() || it->second.active == 0)
+    {
+        return;
+    }
+
+    it->second.active--;
+    this->active_--;
+
+    if (it->second.active == 0 &&
+        std::ranges::all_of(it->second.queues, [](const auto &queue) {
+            return queue.empty();
+        }))
+    {
+        this->hosts_.erase(it);
+    }
+
+    this->dispatch();
+}
+
+size_t NetworkScheduler::active() const
+{
+    return this->active_;
+}
+
+size_t NetworkScheduler::active(const QString &host) const
+{
+    auto it = this->hosts_.find(host);
+    if (it == this->hosts_.end())
+    {
+        return 0;
+    }
+    return it->second.active;
+}
+
+size_t NetworkScheduler::queued() const
+{
+    return this->queued_;
+}
+
+void NetworkScheduler::dispatch()
+{
+    if (this->dispatching_)
+    {
+        // A job finished or scheduled another one while being started. The
+        // outer dispatch() will pick it up.
+        return;
+    }
+    this->dispatching_ = true;
+
+    bool started = true;
+    while (started)
+    {
+        started = false;
+        for (size_t priority = 0; priority < PRIORITY_COUNT && !started;
+             priority++)
+        {
+            auto &waiting = this->waiting_[priority];
+
+            // Every waiting host gets one turn per pass. Once all slots are
+            // taken, the host in front keeps its turn.
+            for (auto turns = waiting.size();
+                 turns > 0 && this->hasFreeSlot(priority); turns--)
+            {
+                auto name = std::move(waiting.front());
+                waiting.pop_front();
+
+                auto &host = this->hosts_[name];
+                if (host.active >= this->perHostLimit_)
+                {
+                    waiting.push_back(std::move(name));
+                    continue;
+                }
+
+                auto &queue = host.queues[priority];
+                auto job = std::move(queue.front().start);
+                queue.pop_front();
+                this->queued_--;
+
+                host.active++;
+                this->active_++;
+
+                if (!queue.empty())
+                {
+                    waiting.push_back(std::move(name));
+                }
+
+                // `host` and `queue` may be invalidated by this
+                job();
+                started = true;
+            }
+        }
+    }
+
+    this->dispatching_ = false;
+
+    DebugCount::set("http requests queued",
+                    static_cast<int64_t>(this->queued_));
+    DebugCount::set("http requests running",
+                    static_cast<int64_t>(this->active_));
+}
+
+bool NetworkScheduler::hasFreeSlot(size_t priority) const
+{
+    auto limit = this->totalLimit_;
+    if (priority == static_cast<size_t>(NetworkPriority::Background))
+    {
+        limit -= this->reservedSlots_;
+    }
+    return this->active_ < limit;
+}
+
+}  // namespace chatterino::network::detail
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "common/network/NetworkCommon.hpp"
+#include "util/QStringHash.hpp"
+
+#include <QString>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+
+namespace chatterino::network::detail {
+
+/**
+ * @brief Decides when queued requests are started.
+ *
+ * Requests are started in priority order. At most `perHostLimit` requests run
+ * against a single host at the same time, and at most `totalLimit` requests
+ * run in total. Background requests leave `reservedSlots` of the total free,
+ * so a burst of prefetching never delays an interactive request.
+ *
+ * Within a priority, hosts take turns (round robin), so a host with a long
+ * queue (e.g. an emote CDN at startup) can't starve the others.
+ *
+ * Not thread safe; the scheduler lives on the network worker thread.
+ */
+class NetworkScheduler
+{
+public:
+    using Job = std::function<void()>;
+    using JobID = uint64_t;
+
+    static constexpr size_t DEFAULT_PER_HOST_LIMIT = 6;
+    static constexpr size_t DEFAULT_TOTAL_LIMIT = 24;
+    static constexpr size_t DEFAULT_RESERVED_SLOTS = 8;
+
+    NetworkScheduler(size_t perHostLimit = DEFAULT_PER_HOST_LIMIT,
+                     size_t totalLimit = DEFAULT_TOTAL_LIMIT,
+                     size_t reservedSlots = DEFAULT_RESERVED_SLOTS);
+
+    /// Queues `start` to be called once a slot for `host` is free. This might
+    /// call `start` right away. Every started job must be followed by a call
+    /// to finished() with the same host.
+    JobID schedule(NetworkPriority priority, const QString &host, Job start);
+
+    /// Moves the queued job `id` for `host` to `priority` if that's higher
+    /// than its current one. Does nothing if the job already started.
+    void raise(const QString &host, JobID id, NetworkPriority priority);
+
+    /// Frees the slot of a started job for `host` and starts the next jobs
+    void finished(const QString &host);
+
+    size_t active() const;
+    size_t active(const QString &host) const;
+    size_t queued() const;
+
+private:
+    static constexpr size_t PRIORITY_COUNT = 3;
+
+    struct QueuedJob {
+        JobID id;
+        Job start;
+    };
+
+    struct Host {
+        size_t active = 0;
+        std::array<std::deque<QueuedJob>, PRIORITY_COUNT> queues;
+    };
+
+    void dispatch();
+    bool hasFreeSlot(size_t priority) const;
+
+    size_t perHostLimit_;
+    size_t totalLimit_;
+    size_t reservedSlots_;
+
+    size_t active_ = 0;
+    size_t queued_ = 0;
+    bool dispatching_ = false;
+    JobID nextID_ = 1;
+
+    std::unordered_map<QString, Host> hosts_;
+    /// Hosts with queued jobs, per priority. A host appears at most once in
+    /// each list.
+    std::array<std::deque<QString>, PRIORITY_COUNT> waiting_;
+};
+
+}  // namespace chatterino::network::detail
@@ -2,9 +2,12 @@
 
 #include "Application.hpp"
 #include "common/network/NetworkManager.hpp"
+#include "common/network/NetworkMetrics.hpp"
 #include "common/network/NetworkPrivate.hpp"
 #include "common/network/NetworkResult.hpp"
+#include "common/network/NetworkScheduler.hpp"
 #include "common/QLogging.hpp"
+#include "debug/Trace.hpp"
 #include "singletons/Paths.hpp"
 #include "util/AbandonObject.hpp"
 #include "util/DebugCount.hpp"
@@ -13,8 +16,48 @@
 #include <QNetworkReply>
 #include <QtConcurrent>
 
+#include <algorithm>
+
+namespace {
+
+using namespace chatterino;
+
+/// Returns the key to coalesce identical requests by, or an empty key if the
+/// request can't be shared.
+QByteArray coalescingKey(const NetworkData &data)
+{
+    if (data.requestType != NetworkRequestType::Get)
+    {
+        return {};
+    }
+
+    QByteArray key = data.request.url().toEncoded();
+    for (const auto &header : data.request.rawHeaderList())
+    {
+        key += '\n' + header + ": " + data.request.rawHeader(header);
+    }
+    if (data.timeout)
+    {
+        key += "\ntimeout: " + QByteArray::number(data.timeout->count());
+    }
+    return key;
+}
+
+/// Name of the request in traces, the query is left out as it might contain
+/// tokens
+QString traceName(const NetworkData &data)
+{
+    return data.request.url().toString(QUrl::RemoveScheme | QUrl::RemoveQuery |
+                                       QUrl::RemoveUserInfo |
+                                       QUrl::RemoveFragment);
+}
+
+}  // namespace
+
 namespace chatterino::network::detail {
 
+QHash<QByteArray, NetworkTask *> NetworkTask::inFlight;
+
 NetworkTask::NetworkTask(std::shared_ptr<NetworkData> &&data)
     : data_(std::move(data))
 {
@@ -26,17 +69,95 @@ NetworkTask::~NetworkTask()
     {
         this->reply_->deleteLater();
     }
+
+    this->closeForWaiters();
+
+    if (this->stats_)
+    {
+        this->stats_->inFlight.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    if (this->traceID_ != 0)
+    {
+        Trace::asyncEnd("network", traceName(*this->data_), this->traceID_);
+    }
+
+    if (this->started_ && NetworkManager::scheduler)
+    {
+        NetworkManager::scheduler->finished(this->data_->request.url().host());
+    }
+}
+
+void NetworkTask::schedule()
+{
+    auto *scheduler = NetworkManager::scheduler;
+    if (!scheduler)
+    {
+        // shutting down
+        this->deleteLater();
+        return;
+    }
+
+    this->key_ = coalescingKey(*this->data_);
+    if (!this->key_.isEmpty())
+    {
+        auto *running = inFlight.value(this->key_);
+        if (running)
+        {
+            DebugCount::increase("http request coalesced");
+            NetworkStats::add(
+                NetworkMetrics::get(this->data_->request.url().host(),
+                                    this->data_->requestType)
+                    .coalesced);
+            if (!running->started_ &&
+                this->data_->priority < running->data_->priority)
+            {
+                // Don't let the waiter wait behind the queue of a lower
+                // priority
+                running->data_->priority = this->data_->priority;
+                scheduler->raise(running->data_->request.url().host(),
+                                 running->jobID_, this->data_->priority);
+            }
+            running->waiters_.emplace_back(std::move(this->data_));
+            this->key_.clear();
+            this->deleteLater();
+            return;
+        }
+        inFlight.insert(this->key_, this);
+    }
+
+    this->jobID_ = scheduler->schedule(this->data_->priority,
+                                       this->data_->request.url().host(),
+                                       [this] {
+                                           this->run();
+                                       });
 }
 
 void NetworkTask::run()
 {
+    this->started_ = true;
     this->reply_ = this->createReply();
     if (!this->reply_)
     {
+        this->closeForWaiters();
         this->deleteLater();
         return;
     }
 
+    this->sentAt_ = std::chrono::steady_clock::now();
+    this->stats_ = &NetworkMetrics::get(this->data_->request.url().host(),
+                                        this->data_->requestType);
+    NetworkStats::add(this->stats_->requests);
+    NetworkStats::add(this->stats_->bytesOut,
+                      static_cast<uint64_t>(this->data_->payload.size()));
+    this->stats_->inFlight.fetch_add(1, std::memory_order_relaxed);
+
+    if (Trace::isRecording())
+    {
+        this->traceID_ = Trace::newFlowID();
+        Trace::asyncBegin("network", traceName(*this->data_), this->traceID_);
+    }
+
     const auto &timeout = this->data_->timeout;
     if (timeout.has_value())
     {
@@ -141,9 +262,47 @@ void NetworkTask::writeToCache(const QByteArray &bytes) const
     });
 }
 
+void NetworkTask::closeForWaiters()
+{
+    if (this->key_.isEmpty())
+    {
+        return;
+    }
+
+    auto it = inFlight.find(this->key_);
+    if (it != inFlight.end() && it.value() == this)
+    {
+        inFlight.erase(it);
+    }
+    this->key_.clear();
+}
+
+void NetworkTask::emitSuccess(NetworkResult &&result)
+{
+    for (const auto &waiter : this->waiters_)
+    {
+        waiter->emitSuccess(NetworkResult(result));
+        waiter->emitFinally();
+    }
+    this->data_->emitSuccess(std::move(result));
+    this->data_->emitFinally();
+}
+
+void NetworkTask::emitError(NetworkResult &&result)
+{
+    for (const auto &waiter : this->waiters_)
+    {
+        waiter->emitError(NetworkResult(result));
+        waiter->emitFinally();
+    }
+    this->data_->emitError(std::move(result));
+    this->data_->emitFinally();
+}
+
 void NetworkTask::timeout()
 {
     AbandonObject guard(this);
+    this->closeForWaiters();
 
     // prevent abort() from calling finished()
     QObject::disconnect(this->reply_, &QNetworkReply::finished, this,
@@ -153,14 +312,15 @@ void NetworkTask::timeout()
     qCDebug(chatterinoHTTP).noquote()
         << this->data_->typeString() << "[timed out]"
         << this->data_->request.url().toString();
+    NetworkStats::add(this->stats_->timeouts);
 
-    this->data_->emitError({NetworkResult::NetworkError::TimeoutError, {}, {}});
-    this->data_->emitFinally();
+    this->emitError({NetworkResult::NetworkError::TimeoutError, {}, {}});
 }
 
 void NetworkTask::finished()
 {
     AbandonObject guard(this);
+    this->closeForWaiters();
 
     if (this->timer_)
     {
@@ -170,6 +330,14 @@ void NetworkTask::finished()
     auto *reply = this->reply_;
     auto status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute);
 
+    this->stats_->latency.record(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - this->sentAt_));
+    if (status.toInt() == 304)
+    {
+        NetworkStats::add(this->stats_->revalidations);
+    }
+
     if (reply->error() == QNetworkReply::OperationCanceledError)
     {
         // Operation cancelled, most likely timed out
@@ -179,26 +347,32 @@ void NetworkTask::finished()
         return;
     }
 
+    QByteArray bytes = reply->readAll();
+    NetworkStats::add(this->stats_->bytesIn,
+                      static_cast<uint64_t>(bytes.size()));
+
     if (reply->error() != QNetworkReply::NoError)
     {
+        NetworkStats::add(this->stats_->failed);
         this->logReply();
-        this->data_->emitError({reply->error(), status, reply->readAll()});
-        this->data_->emitFinally();
+        this->emitError(
+            {reply->error(), status, bytes, reply->rawHeaderPairs()});
 
         return;
     }
 
-    QByteArray bytes = reply->readAll();
-
-    if (this->data_->cache)
+    if (this->data_->cache ||
+        std::ranges::any_of(this->waiters_, [](const auto &waiter) {
+            return waiter->cache;
+        }))
     {
         this->writeToCache(bytes);
     }
 
     DebugCount::increase("http request success");
+    NetworkStats::add(this->stats_->succeeded);
     this->logReply();
-    this->data_->emitSuccess({reply->error(), status, bytes});
-    this->data_->emitFinally();
+    this->emitSuccess({reply->error(), status, bytes, reply->rawHeaderPairs()});
 }
 
 }  // namespace chatterino::network::detail
@@ -1,15 +1,22 @@
 #pragma once
 
+#include <QByteArray>
+#include <QHash>
 #include <QObject>
 #include <QTimer>
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 class QNetworkReply;
 
 namespace chatterino {
 
 class NetworkData;
+class NetworkResult;
+struct NetworkStats;
 
 }  // namespace chatterino
 
@@ -30,17 +37,42 @@ public:
 
     // NOLINTNEXTLINE(readability-redundant-access-specifiers)
 public Q_SLOTS:
-    void run();
+    /// Queues this task in the NetworkScheduler, which will run it
+    void schedule();
 
 private:
+    void run();
     QNetworkReply *createReply();
 
     void logReply();
     void writeToCache(const QByteArray &bytes) const;
 
+    /// Stops other requests from joining this one
+    void closeForWaiters();
+    void emitSuccess(NetworkResult &&result);
+    void emitError(NetworkResult &&result);
+
+    /// GET requests that are in flight, by URL and headers.
+    /// Identical requests wait for the first one instead of sending their own.
+    /// Only used on the worker thread.
+    static QHash<QByteArray, NetworkTask *> inFlight;
+
     std::shared_ptr<NetworkData> data_;
+    /// Identical requests that joined this one
+    std::vector<std::shared_ptr<NetworkData>> waiters_;
+    QByteArray key_;
+    /// The job of this task in the NetworkScheduler
+    uint64_t jobID_ = 0;
     QNetworkReply *reply_{};  // parent: default (accessManager)
     QTimer *timer_{};         // parent: this
+    bool started_ = false;
+
+    /// Set once the request was sent
+    NetworkStats *stats_{};
+    std::chrono::steady_clock::time_point sentAt_;
+    /// Connects the start and end of the request in a trace, 0 if the request
+    /// isn't traced
+    uint64_t traceID_ = 0;
 
     // NOLINTNEXTLINE(readability-redundant-access-specifiers)
 private Q_SLOTS:
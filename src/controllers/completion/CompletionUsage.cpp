@@ -0,0 +1,250 @@
+#include "controllers/completion/CompletionUsage.hpp"
+
+#include "common/QLogging.hpp"
+#include "singletons/Paths.hpp"
+#include "util/CombinePath.hpp"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+#include <algorithm>
+
+namespace {
+
+using namespace chatterino;
+
+/// Usage in the current channel counts this much more than global usage
+constexpr uint32_t CHANNEL_WEIGHT = 4;
+
+QJsonObject countsToJson(const std::unordered_map<QString, uint32_t> &counts)
+{
+    QJsonObject obj;
+    for (const auto &[word, count] : counts)
+    {
+        obj.insert(word, static_cast<qint64>(count));
+    }
+    return obj;
+}
+
+std::unordered_map<QString, uint32_t> countsFromJson(const QJsonObject &obj)
+{
+    std::unordered_map<QString, uint32_t> counts;
+    for (auto it = obj.begin(); it != obj.end(); ++it)
+    {
+        auto count = it.value().toInt();
+        if (count > 0)
+        {
+            counts[it.key()] = static_cast<uint32_t>(count);
+        }
+    }
+    return counts;
+}
+
+/// Strips mention decoration, so `@Forsen,` is stored as `forsen`
+QString mentionedUser(const QString &word)
+{
+    auto name = word.mid(1);
+    if (name.endsWith(','))
+    {
+        name.chop(1);
+    }
+    return name.toLower();
+}
+
+}  // namespace
+
+namespace chatterino {
+
+CompletionUsage::CompletionUsage()
+{
+}
+
+CompletionUsage::CompletionUsage(const Paths &paths)
+    : path_(combinePath(paths.settingsDirectory, "completion-usage.json"))
+{
+    this->load();
+
+    QObject::connect(&this->saveTimer_, &QTimer::timeout, [this] {
+        this->save();
+    });
+    this->saveTimer_.start(SAVE_INTERVAL);
+}
+
+CompletionUsage::~CompletionUsage()
+{
+    this->save();
+}
+
+void CompletionUsage::recordMessage(const QString &channelName,
+                                    const QString &message,
+                                    const KnownWords &known)
+{
+    if (message.startsWith('/') || message.startsWith('.'))
+    {
+        // Don't count command names and arguments
+        return;
+    }
+
+    // Only emotes and mentions are completed, everything else the user types
+    // stays out of the file
+    for (const auto &word : message.split(' ', Qt::SkipEmptyParts))
+    {
+        if (word.startsWith('@'))
+        {
+            auto name = mentionedUser(word);
+            if (!name.isEmpty() && known.isChatter && known.isChatter(name))
+            {
+                this->recordWord(channelName, name);
+            }
+        }
+        else if (known.isEmote && known.isEmote(word))
+        {
+            this->recordWord(channelName, word);
+        }
+    }
+}
+
+void CompletionUsage::recordWord(const QString &channelName,
+                                 const QString &word)
+{
+    if (word.isEmpty())
+    {
+        return;
+    }
+
+    increment(this->global_, word);
+    if (!channelName.isEmpty())
+    {
+        increment(this->channels_[channelName], word);
+    }
+    this->dirty_ = true;
+}
+
+uint32_t CompletionUsage::weight(const QString &channelName,
+                                 const QString &word) const
+{
+    uint32_t weight = 0;
+
+    auto globalIt = this->global_.find(word);
+    if (globalIt != this->global_.end())
+    {
+        weight += globalIt->second;
+    }
+
+    auto channelIt = this->channels_.find(channelName);
+    if (channelIt != this->channels_.end())
+    {
+        auto it = channelIt->second.find(word);
+        if (it != channelIt->second.end())
+        {
+            weight += it->second * CHANNEL_WEIGHT;
+        }
+    }
+
+    return weight;
+}
+
+std::vector<QString> CompletionUsage::topWords(const QString &channelName,
+                                               size_t count) const
+{
+    auto channelIt = this->channels_.find(channelName);
+    if (channelIt == this->channels_.end())
+    {
+        return {};
+    }
+
+    std::vector<std::pair<QString, uint32_t>> words(channelIt->second.begin(),
+                                                    channelIt->second.end());
+    count = std::min(count, words.size());
+    std::partial_sort(words.begin(), words.begin() + count, words.end(),
+                      [](const auto &a, const auto &b) {
+                          return a.second > b.second;
+                      });
+
+    std::vector<QString> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        result.push_back(words[i].first);
+    }
+    return result;
+}
+
+void CompletionUsage::save()
+{
+    if (!this->dirty_ || this->path_.isEmpty())
+    {
+        return;
+    }
+
+    QJsonObject channels;
+    for (const auto &[channelName, counts] : this->channels_)
+    {
+        channels.insert(channelName, countsToJson(counts));
+    }
+
+    QJsonObject root{
+        {"global", countsToJson(this->global_)},
+        {"channels", channels},
+    };
+
+    QSaveFile file(this->path_);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qCWarning(chatterinoApp)
+            << "Failed to save completion usage:" << file.errorString();
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (file.commit())
+    {
+        this->dirty_ = false;
+    }
+}
+
+void CompletionUsage::load()
+{
+    QFile file(this->path_);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    auto root = QJsonDocument::fromJson(file.readAll()).object();
+
+    this->global_ = countsFromJson(root["global"].toObject());
+
+    auto channels = root["channels"].toObject();
+    for (auto it = channels.begin(); it != channels.end(); ++it)
+    {
+        this->channels_[it.key()] = countsFromJson(it.value().toObject());
+    }
+}
+
+void CompletionUsage::increment(Counts &counts, const QString &word)
+{
+    counts[word]++;
+
+    if (counts.size() <= WORD_LIMIT)
+    {
+        return;
+    }
+
+    // Decay all counts, so old favorites make room for new ones
+    for (auto it = counts.begin(); it != counts.end();)
+    {
+        it->second /= 2;
+        if (it->second == 0)
+        {
+            it = counts.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "util/QStringHash.hpp"
+
+#include <QString>
+#include <QTimer>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+class Paths;
+
+/// CompletionUsage counts how often the user sent an emote or mentioned a
+/// user, both per channel and globally. Other words are never recorded.
+/// Completion strategies use these counts to break ties between otherwise
+/// equally ranked results.
+///
+/// The counts are kept in memory and flushed to
+/// `<settingsDirectory>/completion-usage.json` periodically and on save().
+///
+/// This class must only be used from the GUI thread.
+class CompletionUsage
+{
+public:
+    /// The maximum amount of words we track per channel (and globally).
+    /// Once exceeded, all counts of that scope are halved and words that
+    /// reach zero are dropped.
+    static constexpr size_t WORD_LIMIT = 1000;
+
+    /// How often the counts are written to disk if they changed
+    static constexpr auto SAVE_INTERVAL = std::chrono::minutes(5);
+
+    /// Creates an in-memory store that's never persisted
+    CompletionUsage();
+    explicit CompletionUsage(const Paths &paths);
+    ~CompletionUsage();
+
+    CompletionUsage(const CompletionUsage &) = delete;
+    CompletionUsage(CompletionUsage &&) = delete;
+    CompletionUsage &operator=(const CompletionUsage &) = delete;
+    CompletionUsage &operator=(CompletionUsage &&) = delete;
+
+    /// Decides which words of a sent message are recorded
+    struct KnownWords {
+        /// Returns true if the word is an emote usable in the channel
+        std::function<bool(const QString &)> isEmote;
+        /// Returns true if the lowercase username is a chatter of the channel
+        std::function<bool(const QString &)> isChatter;
+    };
+
+    /// Records the emotes and mentions of a sent message in `channelName`.
+    /// Mentions (`@user`) are stored as the lowercase username.
+    void recordMessage(const QString &channelName, const QString &message,
+                       const KnownWords &known);
+
+    /// Records a single use of `word` in `channelName`.
+    void recordWord(const QString &channelName, const QString &word);
+
+    /// Returns a weight for `word` in `channelName` where a higher weight
+    /// means the word is used more often. Channel specific usage is weighted
+    /// higher than global usage. Returns 0 for unknown words.
+    uint32_t weight(const QString &channelName, const QString &word) const;
+
+    /// Returns up to `count` of the most used words in `channelName`,
+    /// most used first.
+    std::vector<QString> topWords(const QString &channelName,
+                                  size_t count) const;
+
+    /// Writes the counts to disk if they changed since the last save.
+    void save();
+
+private:
+    using Counts = std::unordered_map<QString, uint32_t>;
+
+    void load();
+    static void increment(Counts &counts, const QString &word);
+
+    QString path_;
+    bool dirty_{false};
+
+    Counts global_;
+    std::unordered_map<QString, Counts> channels_;
+
+    QTimer saveTimer_;
+};
+
+/// The usage weights of a single channel, as used by completion strategies
+struct ChannelCompletionUsage {
+    /// Can be nullptr, in which case every word has a weight of 0
+    const CompletionUsage *usage{};
+    QString channelName;
+
+    uint32_t weight(const QString &word) const
+    {
+        if (this->usage == nullptr)
+        {
+            return 0;
+        }
+        return this->usage->weight(this->channelName, word);
+    }
+};
+
+}  // namespace chatterino
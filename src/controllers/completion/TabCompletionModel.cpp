@@ -2,6 +2,7 @@
 
 #include "Application.hpp"
 #include "common/Channel.hpp"
+#include "controllers/completion/CompletionUsage.hpp"
 #include "controllers/completion/sources/CommandSource.hpp"
 #include "controllers/completion/sources/EmoteSource.hpp"
 #include "controllers/completion/sources/UnifiedSource.hpp"
@@ -150,7 +151,8 @@ std::unique_ptr<completion::Source> TabCompletionModel::buildEmoteSource() const
     {
         return std::make_unique<completion::EmoteSource>(
             &this->channel_,
-            std::make_unique<completion::SmartTabEmoteStrategy>());
+            std::make_unique<completion::SmartTabEmoteStrategy>(
+                this->channelUsage()));
     }
 
     return std::make_unique<completion::EmoteSource>(
@@ -162,7 +164,8 @@ std::unique_ptr<completion::Source> TabCompletionModel::buildUserSource(
     bool prependAt) const
 {
     return std::make_unique<completion::UserSource>(
-        &this->channel_, std::make_unique<completion::ClassicUserStrategy>(),
+        &this->channel_,
+        std::make_unique<completion::ClassicUserStrategy>(this->channelUsage()),
         nullptr, prependAt);
 }
 
@@ -173,4 +176,12 @@ std::unique_ptr<completion::Source> TabCompletionModel::buildCommandSource()
         std::make_unique<completion::CommandStrategy>(true));
 }
 
+ChannelCompletionUsage TabCompletionModel::channelUsage() const
+{
+    return {
+        .usage = getApp()->getCompletionUsage(),
+        .channelName = this->channel_.getName(),
+    };
+}
+
 }  // namespace chatterino
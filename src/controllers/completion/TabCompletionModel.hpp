@@ -11,6 +11,7 @@
 namespace chatterino {
 
 class Channel;
+struct ChannelCompletionUsage;
 
 /// @brief TabCompletionModel is a QStringListModel intended to provide tab
 /// completion to a ResizingTextInput. The model automatically selects a completion
@@ -66,6 +67,8 @@ private:
     std::unique_ptr<completion::Source> buildUserSource(bool prependAt) const;
     std::unique_ptr<completion::Source> buildCommandSource() const;
 
+    ChannelCompletionUsage channelUsage() const;
+
     Channel &channel_;
     std::unique_ptr<completion::Source> source_{};
 };
@@ -10,20 +10,47 @@ namespace chatterino::completion {
 UserSource::UserSource(const Channel *channel,
                        std::unique_ptr<UserStrategy> strategy,
                        ActionCallback callback, bool prependAt)
-    : strategy_(std::move(strategy))
+    : channel_(dynamic_cast<const TwitchChannel *>(channel))
+    , strategy_(std::move(strategy))
     , callback_(std::move(callback))
     , prependAt_(prependAt)
 {
-    this->initializeFromChannel(channel);
 }
 
 void UserSource::update(const QString &query)
 {
     this->output_.clear();
-    if (this->strategy_)
+    if (!this->strategy_ || !this->channel_)
     {
-        this->strategy_->apply(this->items_, this->output_, query);
+        return;
+    }
+
+    QString prefix = query;
+    if (prefix.startsWith('@'))
+    {
+        prefix = prefix.mid(1);
+    }
+
+    // Only the chatters matching the prefix are handed to the strategy
+    auto items = this->channel_->accessChatters()->filterByPrefix(prefix);
+
+    if (getSettings()->alwaysIncludeBroadcasterInUserCompletions &&
+        this->channel_->getName().startsWith(prefix, Qt::CaseInsensitive))
+    {
+        auto it = std::find_if(items.begin(), items.end(),
+                               [this](const UserItem &user) {
+                                   return user.first ==
+                                          this->channel_->getName();
+                               });
+
+        if (it == items.end())
+        {
+            items.emplace_back(this->channel_->getName(),
+                               this->channel_->getDisplayName());
+        }
     }
+
+    this->strategy_->apply(items, this->output_, query);
 }
 
 void UserSource::addToListModel(GenericListModel &model, size_t maxCount) const
@@ -50,30 +77,6 @@ void UserSource::addToStringList(QStringList &list, size_t maxCount,
                        });
 }
 
-void UserSource::initializeFromChannel(const Channel *channel)
-{
-    const auto *tc = dynamic_cast<const TwitchChannel *>(channel);
-    if (!tc)
-    {
-        return;
-    }
-
-    this->items_ = tc->accessChatters()->all();
-
-    if (getSettings()->alwaysIncludeBroadcasterInUserCompletions)
-    {
-        auto it = std::find_if(this->items_.begin(), this->items_.end(),
-                               [tc](const UserItem &user) {
-                                   return user.first == tc->getName();
-                               });
-
-        if (it == this->items_.end())
-        {
-            this->items_.emplace_back(tc->getName(), tc->getDisplayName());
-        }
-    }
-}
-
 const std::vector<UserItem> &UserSource::output() const
 {
     return this->output_;
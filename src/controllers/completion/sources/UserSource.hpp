@@ -11,6 +11,12 @@
 #include <utility>
 #include <vector>
 
+namespace chatterino {
+
+class TwitchChannel;
+
+}  // namespace chatterino
+
 namespace chatterino::completion {
 
 using UserItem = std::pair<QString, QString>;
@@ -22,8 +28,8 @@ public:
     using UserStrategy = Strategy<UserItem>;
 
     /// @brief Initializes a source for UserItems from the given channel.
-    /// @param channel Channel to initialize users from. Must be a TwitchChannel
-    /// or completion is a no-op.
+    /// @param channel Channel to look up users in. Must be a TwitchChannel
+    /// or completion is a no-op. Must outlive this source.
     /// @param strategy Strategy to apply
     /// @param callback ActionCallback to invoke upon InputCompletionItem selection.
     /// See InputCompletionItem::action(). Can be nullptr.
@@ -40,13 +46,11 @@ public:
     const std::vector<UserItem> &output() const;
 
 private:
-    void initializeFromChannel(const Channel *channel);
-
+    const TwitchChannel *channel_;
     std::unique_ptr<UserStrategy> strategy_;
     ActionCallback callback_;
     bool prependAt_;
 
-    std::vector<UserItem> items_{};
     std::vector<UserItem> output_{};
 };
 
@@ -1,7 +1,14 @@
 #include "controllers/completion/strategies/ClassicUserStrategy.hpp"
 
+#include <algorithm>
+
 namespace chatterino::completion {
 
+ClassicUserStrategy::ClassicUserStrategy(ChannelCompletionUsage usage)
+    : usage_(std::move(usage))
+{
+}
+
 void ClassicUserStrategy::apply(const std::vector<UserItem> &items,
                                 std::vector<UserItem> &output,
                                 const QString &query) const
@@ -19,5 +26,15 @@ void ClassicUserStrategy::apply(const std::vector<UserItem> &items,
             output.push_back(item);
         }
     }
+
+    if (this->usage_.usage != nullptr)
+    {
+        // Users with equal weight keep their original (most recent) order
+        std::stable_sort(output.begin(), output.end(),
+                         [this](const UserItem &a, const UserItem &b) {
+                             return this->usage_.weight(a.first) >
+                                    this->usage_.weight(b.first);
+                         });
+    }
 }
 }  // namespace chatterino::completion
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "controllers/completion/CompletionUsage.hpp"
 #include "controllers/completion/sources/UserSource.hpp"
 #include "controllers/completion/strategies/Strategy.hpp"
 
@@ -7,9 +8,18 @@ namespace chatterino::completion {
 
 class ClassicUserStrategy : public Strategy<UserItem>
 {
+public:
+    ClassicUserStrategy() = default;
+
+    /// @param usage Users that are mentioned more often are put first
+    explicit ClassicUserStrategy(ChannelCompletionUsage usage);
+
+private:
     void apply(const std::vector<UserItem> &items,
                std::vector<UserItem> &output,
                const QString &query) const override;
+
+    ChannelCompletionUsage usage_;
 };
 
 }  // namespace chatterino::completion
@@ -68,6 +68,7 @@ namespace {
     void completeEmotes(
         const std::vector<EmoteItem> &items, std::vector<EmoteItem> &output,
         QStringView query, bool ignoreColonForCost,
+        const ChannelCompletionUsage &usage,
         const std::function<bool(EmoteItem, Qt::CaseSensitivity)>
             &matchingFunction)
     {
@@ -129,7 +130,7 @@ namespace {
         }
 
         std::sort(output.begin(), output.end(),
-                  [query, prioritizeUpper, ignoreColonForCost](
+                  [query, prioritizeUpper, ignoreColonForCost, &usage](
                       const EmoteItem &a, const EmoteItem &b) -> bool {
                       auto tempA = a.searchName;
                       auto tempB = b.searchName;
@@ -146,6 +147,14 @@ namespace {
                       auto costB = costOfEmote(query, tempB, prioritizeUpper);
                       if (costA == costB)
                       {
+                          // Prefer the emote that's used more often
+                          auto usageA = usage.weight(a.tabCompletionName);
+                          auto usageB = usage.weight(b.tabCompletionName);
+                          if (usageA != usageB)
+                          {
+                              return usageA > usageB;
+                          }
+
                           // Case difference and length came up tied for (a, b), break the tie
                           return QString::compare(tempA, tempB,
                                                   Qt::CaseInsensitive) < 0;
@@ -156,6 +165,11 @@ namespace {
     }
 }  // namespace
 
+SmartEmoteStrategy::SmartEmoteStrategy(ChannelCompletionUsage usage)
+    : usage_(std::move(usage))
+{
+}
+
 void SmartEmoteStrategy::apply(const std::vector<EmoteItem> &items,
                                std::vector<EmoteItem> &output,
                                const QString &query) const
@@ -168,6 +182,7 @@ void SmartEmoteStrategy::apply(const std::vector<EmoteItem> &items,
         ignoreColonForCost = true;
     }
     completeEmotes(items, output, normalizedQuery, ignoreColonForCost,
+                   this->usage_,
                    [normalizedQuery](const EmoteItem &left,
                                      Qt::CaseSensitivity caseHandling) {
                        return left.searchName.contains(normalizedQuery,
@@ -175,6 +190,11 @@ void SmartEmoteStrategy::apply(const std::vector<EmoteItem> &items,
                    });
 }
 
+SmartTabEmoteStrategy::SmartTabEmoteStrategy(ChannelCompletionUsage usage)
+    : usage_(std::move(usage))
+{
+}
+
 void SmartTabEmoteStrategy::apply(const std::vector<EmoteItem> &items,
                                   std::vector<EmoteItem> &output,
                                   const QString &query) const
@@ -188,7 +208,7 @@ void SmartTabEmoteStrategy::apply(const std::vector<EmoteItem> &items,
     }
 
     completeEmotes(
-        items, output, normalizedQuery, false,
+        items, output, normalizedQuery, false, this->usage_,
         [&](const EmoteItem &item, Qt::CaseSensitivity caseHandling) -> bool {
             QStringView itemQuery;
             if (item.isEmoji)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "controllers/completion/CompletionUsage.hpp"
 #include "controllers/completion/sources/EmoteSource.hpp"
 #include "controllers/completion/strategies/Strategy.hpp"
 
@@ -7,16 +8,34 @@ namespace chatterino::completion {
 
 class SmartEmoteStrategy : public Strategy<EmoteItem>
 {
+public:
+    SmartEmoteStrategy() = default;
+
+    /// @param usage Used to break ties between emotes of equal cost
+    explicit SmartEmoteStrategy(ChannelCompletionUsage usage);
+
+private:
     void apply(const std::vector<EmoteItem> &items,
                std::vector<EmoteItem> &output,
                const QString &query) const override;
+
+    ChannelCompletionUsage usage_;
 };
 
 class SmartTabEmoteStrategy : public Strategy<EmoteItem>
 {
+public:
+    SmartTabEmoteStrategy() = default;
+
+    /// @param usage Used to break ties between emotes of equal cost
+    explicit SmartTabEmoteStrategy(ChannelCompletionUsage usage);
+
+private:
     void apply(const std::vector<EmoteItem> &items,
                std::vector<EmoteItem> &output,
                const QString &query) const override;
+
+    ChannelCompletionUsage usage_;
 };
 
 }  // namespace chatterino::completion
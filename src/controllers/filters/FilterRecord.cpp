@@ -1,9 +1,36 @@
 #include "controllers/filters/FilterRecord.hpp"
 
 #include "controllers/filters/lang/Filter.hpp"
+#include "messages/Message.hpp"
+
+#include <algorithm>
+#include <atomic>
 
 namespace chatterino {
 
+static uint32_t nextCacheKey()
+{
+    static std::atomic<uint32_t> key{0};
+    return ++key;
+}
+
+/// Number of existing records whose results are cached
+static std::atomic<size_t> cacheableRecords{0};
+
+static bool isCacheable(const filters::Filter *filter)
+{
+    using namespace filters;
+    if (filter == nullptr)
+    {
+        return false;
+    }
+
+    // These depend on the channel rather than the message
+    const auto &slots = filter->usedSlots();
+    return !slots.contains(BoolSlot::ChannelLive) &&
+           !slots.contains(BoolSlot::ChannelWatching);
+}
+
 static std::unique_ptr<filters::Filter> buildFilter(const QString &filterText)
 {
     using namespace filters;
@@ -35,7 +62,27 @@ FilterRecord::FilterRecord(QString name, QString filter, const QUuid &id)
     , filterText_(std::move(filter))
     , id_(id)
     , filter_(buildFilter(this->filterText_))
+    , cacheKey_(nextCacheKey())
+    , cacheable_(isCacheable(this->filter_.get()))
 {
+    if (this->cacheable_)
+    {
+        cacheableRecords.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+FilterRecord::~FilterRecord()
+{
+    if (this->cacheable_)
+    {
+        cacheableRecords.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+size_t FilterRecord::maxCachedResults()
+{
+    return std::max<size_t>(
+        cacheableRecords.load(std::memory_order_relaxed), 1);
 }
 
 const QString &FilterRecord::getName() const
@@ -58,10 +105,69 @@ bool FilterRecord::valid() const
     return this->filter_ != nullptr;
 }
 
-bool FilterRecord::filter(const filters::ContextMap &context) const
+bool FilterRecord::filter(const filters::FilterContext &context) const
+{
+    assert(this->valid());
+    return this->filter_->matches(context);
+}
+
+const filters::ContextSlotSet &FilterRecord::usedSlots() const
 {
     assert(this->valid());
-    return this->filter_->execute(context).toBool();
+    return this->filter_->usedSlots();
+}
+
+std::optional<bool> FilterRecord::cachedResult(const Message &message) const
+{
+    if (!this->cacheable_)
+    {
+        return std::nullopt;
+    }
+
+    const auto &cache = message.filterCache;
+    auto it = std::find_if(cache.begin(), cache.end(), [&](const auto &entry) {
+        return entry.filterKey == this->cacheKey_;
+    });
+    if (it == cache.end() || it->flags != message.flags)
+    {
+        return std::nullopt;
+    }
+
+    return it->result;
+}
+
+void FilterRecord::cacheResult(const Message &message, bool result) const
+{
+    if (!this->cacheable_)
+    {
+        return;
+    }
+
+    auto &cache = message.filterCache;
+    auto it = std::find_if(cache.begin(), cache.end(), [&](const auto &entry) {
+        return entry.filterKey == this->cacheKey_;
+    });
+    if (it != cache.end())
+    {
+        it->flags = message.flags;
+        it->result = result;
+        return;
+    }
+
+    // Results of edited or removed filters are never used again. There's
+    // room for the results of all existing records, so once the cache is
+    // full, the oldest results usually belong to removed ones.
+    auto capacity = maxCachedResults();
+    if (cache.size() >= capacity)
+    {
+        cache.erase(cache.begin(),
+                    cache.end() - static_cast<std::ptrdiff_t>(capacity - 1));
+    }
+    cache.push_back({
+        .filterKey = this->cacheKey_,
+        .flags = message.flags,
+        .result = result,
+    });
 }
 
 bool FilterRecord::operator==(const FilterRecord &other) const
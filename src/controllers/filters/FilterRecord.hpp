@@ -9,10 +9,14 @@
 #include <QString>
 #include <QUuid>
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 
 namespace chatterino {
 
+struct Message;
+
 class FilterRecord
 {
 public:
@@ -20,6 +24,8 @@ public:
 
     FilterRecord(QString name, QString filter, const QUuid &id);
 
+    ~FilterRecord();
+
     const QString &getName() const;
 
     const QString &getFilter() const;
@@ -28,7 +34,25 @@ public:
 
     bool valid() const;
 
-    bool filter(const filters::ContextMap &context) const;
+    bool filter(const filters::FilterContext &context) const;
+
+    /// Returns the slots of a FilterContext this filter reads.
+    /// Must only be called on valid filters.
+    const filters::ContextSlotSet &usedSlots() const;
+
+    /// Returns the result of this filter for `message` if it was previously
+    /// stored with cacheResult and the message flags didn't change since.
+    ///
+    /// Filters reading the state of the channel (e.g. `channel.live`) are
+    /// never cached, since their result can change without the message
+    /// changing.
+    std::optional<bool> cachedResult(const Message &message) const;
+    void cacheResult(const Message &message, bool result) const;
+
+    /// Returns the maximum amount of filter results cached per message. That's
+    /// the number of cacheable records that exist, so the results of all
+    /// active filters fit.
+    static size_t maxCachedResults();
 
     bool operator==(const FilterRecord &other) const;
 
@@ -38,6 +62,12 @@ private:
     const QUuid id_;
 
     const std::unique_ptr<filters::Filter> filter_;
+
+    /// Identifies this filter in the cache of a message. Every record gets a
+    /// new key, so editing a filter (which creates a new record) invalidates
+    /// its cached results.
+    const uint32_t cacheKey_;
+    const bool cacheable_;
 };
 
 using FilterRecordPtr = std::shared_ptr<FilterRecord>;
@@ -1,8 +1,11 @@
 #include "controllers/filters/FilterSet.hpp"
 
 #include "controllers/filters/FilterRecord.hpp"
+#include "messages/Message.hpp"
 #include "singletons/Settings.hpp"
 
+#include <optional>
+
 namespace chatterino {
 
 FilterSet::FilterSet()
@@ -23,6 +26,7 @@ FilterSet::FilterSet(const QList<QUuid> &filterIds)
             this->filters_.insert(f->getId(), f);
         }
     }
+    this->updateUsedSlots();
 
     this->listener_ =
         getSettings()->filterRecords.delayedItemsChanged.connect([this] {
@@ -42,10 +46,28 @@ bool FilterSet::filter(const MessagePtr &m, ChannelPtr channel) const
         return true;
     }
 
-    filters::ContextMap context = filters::buildContextMap(m, channel.get());
-    for (const auto &f : this->filters_.values())
+    // Only built if a filter doesn't have a cached result for this message
+    std::optional<filters::FilterContext> context;
+    for (const auto &f : this->filters_)
     {
-        if (!f->valid() || !f->filter(context))
+        if (!f->valid())
+        {
+            return false;
+        }
+
+        auto result = f->cachedResult(*m);
+        if (!result)
+        {
+            if (!context)
+            {
+                context = filters::buildFilterContext(m, channel.get(),
+                                                      this->usedSlots_);
+            }
+            result = f->filter(*context);
+            f->cacheResult(*m, *result);
+        }
+
+        if (!*result)
         {
             return false;
         }
@@ -78,6 +100,19 @@ void FilterSet::reloadFilters()
             this->filters_.remove(key);
         }
     }
+    this->updateUsedSlots();
+}
+
+void FilterSet::updateUsedSlots()
+{
+    this->usedSlots_ = {};
+    for (const auto &f : this->filters_)
+    {
+        if (f->valid())
+        {
+            this->usedSlots_ |= f->usedSlots();
+        }
+    }
 }
 
 }  // namespace chatterino
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "controllers/filters/lang/FilterContext.hpp"
+
 #include <pajlada/signals.hpp>
 #include <QList>
 #include <QMap>
@@ -29,9 +31,12 @@ public:
 
 private:
     QMap<QUuid, FilterRecordPtr> filters_;
+    /// The union of the slots read by all valid filters in this set
+    filters::ContextSlotSet usedSlots_;
     pajlada::Signals::Connection listener_;
 
     void reloadFilters();
+    void updateUsedSlots();
 };
 
 using FilterSetPtr = std::shared_ptr<FilterSet>;
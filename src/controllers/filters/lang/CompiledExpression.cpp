@@ -0,0 +1,62 @@
+#include "controllers/filters/lang/CompiledExpression.hpp"
+
+namespace {
+
+using namespace chatterino::filters;
+
+QVariant toQVariant(const QColor &color)
+{
+    return QVariant::fromValue(color);
+}
+
+QVariant toQVariant(const MatchingSpecifier &specifier)
+{
+    return QList<QVariant>{specifier.regex, specifier.group};
+}
+
+QVariant toQVariant(QVariant value)
+{
+    return value;
+}
+
+template <typename T>
+QVariant toQVariant(T value)
+{
+    return QVariant(std::move(value));
+}
+
+}  // namespace
+
+namespace chatterino::filters {
+
+CompiledExpression::CompiledExpression(AnyEvaluator evaluator)
+    : evaluator_(std::move(evaluator))
+{
+}
+
+Evaluator<QVariant> CompiledExpression::toVariant() const
+{
+    if (const auto *fn = this->get<QVariant>())
+    {
+        return *fn;
+    }
+
+    return std::visit(
+        [](const auto &fn) -> Evaluator<QVariant> {
+            return [fn](const FilterContext &context) {
+                return toQVariant(fn(context));
+            };
+        },
+        this->evaluator_);
+}
+
+QVariant CompiledExpression::evaluate(const FilterContext &context) const
+{
+    return std::visit(
+        [&](const auto &fn) {
+            return toQVariant(fn(context));
+        },
+        this->evaluator_);
+}
+
+}  // namespace chatterino::filters
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "controllers/filters/lang/FilterContext.hpp"
+
+#include <QColor>
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+#include <functional>
+#include <variant>
+
+namespace chatterino::filters {
+
+template <typename T>
+using Evaluator = std::function<T(const FilterContext &)>;
+
+/// Runtime value of a `{RegularExpression, Int}` list
+struct MatchingSpecifier {
+    QRegularExpression regex;
+    int group;
+};
+
+/// CompiledExpression is an Expression lowered into a closure that reads its
+/// identifiers from a FilterContext.
+///
+/// Well-typed operations on Bools, Ints, Strings and StringLists are compiled
+/// into evaluators returning that type directly. Everything else (e.g. loose
+/// comparisons between different types, or lists of mixed types) falls back
+/// to an Evaluator<QVariant> with the same semantics as Expression::execute.
+class CompiledExpression
+{
+public:
+    template <typename T, typename Fn>
+    static CompiledExpression of(Fn &&fn)
+    {
+        return CompiledExpression(Evaluator<T>(std::forward<Fn>(fn)));
+    }
+
+    template <typename T>
+    static CompiledExpression constant(T value)
+    {
+        return CompiledExpression::of<T>(
+            [value = std::move(value)](const FilterContext &) {
+                return value;
+            });
+    }
+
+    /// Returns the evaluator if this expression evaluates to `T`, otherwise
+    /// nullptr
+    template <typename T>
+    const Evaluator<T> *get() const
+    {
+        return std::get_if<Evaluator<T>>(&this->evaluator_);
+    }
+
+    template <typename T>
+    bool is() const
+    {
+        return this->get<T>() != nullptr;
+    }
+
+    /// Returns an evaluator producing the same QVariant as
+    /// Expression::execute would.
+    Evaluator<QVariant> toVariant() const;
+
+    QVariant evaluate(const FilterContext &context) const;
+
+private:
+    using AnyEvaluator =
+        std::variant<Evaluator<bool>, Evaluator<int>, Evaluator<QString>,
+                     Evaluator<QColor>, Evaluator<QStringList>,
+                     Evaluator<QRegularExpression>,
+                     Evaluator<MatchingSpecifier>, Evaluator<QVariant>>;
+
+    CompiledExpression(AnyEvaluator evaluator);
+
+    AnyEvaluator evaluator_;
+};
+
+}  // namespace chatterino::filters
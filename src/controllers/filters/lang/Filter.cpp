@@ -8,8 +8,78 @@
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
 
+namespace {
+
+using namespace chatterino;
+using namespace chatterino::filters;
+
+struct FlagSlot {
+    BoolSlot slot;
+    MessageFlag flag;
+};
+
+// Identifiers that map directly to a message flag
+const FlagSlot FLAG_SLOTS[] = {
+    {BoolSlot::FlagsAction, MessageFlag::Action},
+    {BoolSlot::FlagsHighlighted, MessageFlag::Highlighted},
+    {BoolSlot::FlagsPointsRedeemed, MessageFlag::RedeemedHighlight},
+    {BoolSlot::FlagsSubMessage, MessageFlag::Subscription},
+    {BoolSlot::FlagsSystemMessage, MessageFlag::System},
+    {BoolSlot::FlagsWebchatDetected, MessageFlag::WebchatDetected},
+    {BoolSlot::FlagsRewardMessage, MessageFlag::RedeemedChannelPointReward},
+    {BoolSlot::FlagsFirstMessage, MessageFlag::FirstMessage},
+    {BoolSlot::FlagsElevatedMessage, MessageFlag::ElevatedMessage},
+    {BoolSlot::FlagsHypeChat, MessageFlag::ElevatedMessage},
+    {BoolSlot::FlagsCheerMessage, MessageFlag::CheerMessage},
+    {BoolSlot::FlagsWhisper, MessageFlag::Whisper},
+    {BoolSlot::FlagsReply, MessageFlag::ReplyMessage},
+    {BoolSlot::FlagsAutomod, MessageFlag::AutoMod},
+    {BoolSlot::FlagsRestricted, MessageFlag::RestrictedMessage},
+    {BoolSlot::FlagsMonitored, MessageFlag::MonitoredMessage},
+    {BoolSlot::FlagsShared, MessageFlag::SharedMessage},
+    {BoolSlot::FlagsSimilar, MessageFlag::Similar},
+};
+
+}  // namespace
+
 namespace chatterino::filters {
 
+const SlotContext MESSAGE_CONTEXT_SLOTS{
+    {"author.badges", StringListSlot::AuthorBadges},
+    {"author.color", ColorSlot::AuthorColor},
+    {"author.name", StringSlot::AuthorName},
+    {"author.user_id", StringSlot::AuthorUserID},
+    {"author.no_color", BoolSlot::AuthorNoColor},
+    {"author.subbed", BoolSlot::AuthorSubbed},
+    {"author.sub_length", IntSlot::AuthorSubLength},
+    {"channel.name", StringSlot::ChannelName},
+    {"channel.watching", BoolSlot::ChannelWatching},
+    {"channel.live", BoolSlot::ChannelLive},
+    {"flags.action", BoolSlot::FlagsAction},
+    {"flags.highlighted", BoolSlot::FlagsHighlighted},
+    {"flags.points_redeemed", BoolSlot::FlagsPointsRedeemed},
+    {"flags.sub_message", BoolSlot::FlagsSubMessage},
+    {"flags.system_message", BoolSlot::FlagsSystemMessage},
+    {"flags.reward_message", BoolSlot::FlagsRewardMessage},
+    {"flags.first_message", BoolSlot::FlagsFirstMessage},
+    {"flags.elevated_message", BoolSlot::FlagsElevatedMessage},
+    {"flags.hype_chat", BoolSlot::FlagsHypeChat},
+    {"flags.cheer_message", BoolSlot::FlagsCheerMessage},
+    {"flags.whisper", BoolSlot::FlagsWhisper},
+    {"flags.reply", BoolSlot::FlagsReply},
+    {"flags.automod", BoolSlot::FlagsAutomod},
+    {"flags.restricted", BoolSlot::FlagsRestricted},
+    {"flags.monitored", BoolSlot::FlagsMonitored},
+    {"flags.shared", BoolSlot::FlagsShared},
+    {"flags.similar", BoolSlot::FlagsSimilar},
+    {"message.content", StringSlot::MessageContent},
+    {"message.length", IntSlot::MessageLength},
+    {"reward.title", StringSlot::RewardTitle},
+    {"reward.cost", IntSlot::RewardCost},
+    {"reward.id", StringSlot::RewardID},
+    {"flags.webchat_detected", BoolSlot::FlagsWebchatDetected},
+};
+
 const QMap<QString, Type> MESSAGE_TYPING_CONTEXT{
     {"author.badges", Type::StringList},
     {"author.color", Type::Color},
@@ -46,16 +116,19 @@ const QMap<QString, Type> MESSAGE_TYPING_CONTEXT{
     {"flags.webchat_detected", Type::Bool},
 };
 
-ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel)
+FilterContext buildFilterContext(const MessagePtr &m,
+                                 chatterino::Channel *channel,
+                                 const ContextSlotSet &slots)
 {
-    auto watchingChannel = getApp()->getTwitch()->getWatchingChannel().get();
-
     /* 
      * Looking to add a new identifier to filters? Here's what to do: 
      *  1. Update validIdentifiersMap in Tokenizer.cpp
      *  2. Add the identifier to the list below
      *  3. Add the type of the identifier to MESSAGE_TYPING_CONTEXT in Filter.hpp
-     *  4. Add the value for the identifier to the ContextMap returned by this function
+     *  4. Add a slot for the identifier in FilterContext.hpp and map the
+     *     identifier to it in MESSAGE_CONTEXT_SLOTS
+     *  5. Set the slot in the FilterContext built by this function, only if
+     *     `slots` contains it when computing the value is expensive
      * 
      * List of identifiers:
      *
@@ -100,92 +173,99 @@ ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel)
      * 
      */
 
-    using MessageFlag = chatterino::MessageFlag;
+    FilterContext ctx;
 
-    QStringList badges;
-    badges.reserve(m->badges.size());
-    for (const auto &e : m->badges)
+    if (slots.contains(StringListSlot::AuthorBadges) ||
+        slots.contains(BoolSlot::AuthorSubbed) ||
+        slots.contains(IntSlot::AuthorSubLength))
     {
-        badges << e.key_;
-    }
-
-    bool watching = !watchingChannel->getName().isEmpty() &&
-                    watchingChannel->getName().compare(
-                        m->channelName, Qt::CaseInsensitive) == 0;
-
-    bool subscribed = false;
-    int subLength = 0;
-    for (const auto &subBadge : {"subscriber", "founder"})
-    {
-        if (!badges.contains(subBadge))
+        QStringList badges;
+        badges.reserve(m->badges.size());
+        for (const auto &e : m->badges)
         {
-            continue;
+            badges << e.key_;
         }
-        subscribed = true;
-        if (m->badgeInfos.find(subBadge) != m->badgeInfos.end())
+
+        bool subscribed = false;
+        int subLength = 0;
+        for (const auto &subBadge : {"subscriber", "founder"})
         {
-            subLength = m->badgeInfos.at(subBadge).toInt();
+            if (!badges.contains(subBadge))
+            {
+                continue;
+            }
+            subscribed = true;
+            if (m->badgeInfos.find(subBadge) != m->badgeInfos.end())
+            {
+                subLength = m->badgeInfos.at(subBadge).toInt();
+            }
         }
+
+        ctx.at(StringListSlot::AuthorBadges) = std::move(badges);
+        ctx.at(BoolSlot::AuthorSubbed) = subscribed;
+        ctx.at(IntSlot::AuthorSubLength) = subLength;
+    }
+
+    // The remaining string and color slots are implicitly shared copies
+    ctx.at(ColorSlot::AuthorColor) = m->usernameColor;
+    ctx.at(StringSlot::AuthorName) = m->displayName;
+    ctx.at(StringSlot::AuthorUserID) = m->userID;
+    ctx.at(BoolSlot::AuthorNoColor) = !m->usernameColor.isValid();
+
+    ctx.at(StringSlot::ChannelName) = m->channelName;
+    if (slots.contains(BoolSlot::ChannelWatching))
+    {
+        auto watchingChannel =
+            getApp()->getTwitch()->getWatchingChannel().get();
+        ctx.at(BoolSlot::ChannelWatching) =
+            !watchingChannel->getName().isEmpty() &&
+            watchingChannel->getName().compare(m->channelName,
+                                               Qt::CaseInsensitive) == 0;
     }
-    ContextMap vars = {
-        {"author.badges", std::move(badges)},
-        {"author.color", m->usernameColor},
-        {"author.name", m->displayName},
-        {"author.user_id", m->userID},
-        {"author.no_color", !m->usernameColor.isValid()},
-        {"author.subbed", subscribed},
-        {"author.sub_length", subLength},
-
-        {"channel.name", m->channelName},
-        {"channel.watching", watching},
-
-        {"flags.action", m->flags.has(MessageFlag::Action)},
-        {"flags.highlighted", m->flags.has(MessageFlag::Highlighted)},
-        {"flags.points_redeemed", m->flags.has(MessageFlag::RedeemedHighlight)},
-        {"flags.sub_message", m->flags.has(MessageFlag::Subscription)},
-        {"flags.system_message", m->flags.has(MessageFlag::System)},
-        {"flags.webchat_detected", m->flags.has(MessageFlag::WebchatDetected)},
-        {"flags.reward_message",
-         m->flags.has(MessageFlag::RedeemedChannelPointReward)},
-        {"flags.first_message", m->flags.has(MessageFlag::FirstMessage)},
-        {"flags.elevated_message", m->flags.has(MessageFlag::ElevatedMessage)},
-        {"flags.hype_chat", m->flags.has(MessageFlag::ElevatedMessage)},
-        {"flags.cheer_message", m->flags.has(MessageFlag::CheerMessage)},
-        {"flags.whisper", m->flags.has(MessageFlag::Whisper)},
-        {"flags.reply", m->flags.has(MessageFlag::ReplyMessage)},
-        {"flags.automod", m->flags.has(MessageFlag::AutoMod)},
-        {"flags.restricted", m->flags.has(MessageFlag::RestrictedMessage)},
-        {"flags.monitored", m->flags.has(MessageFlag::MonitoredMessage)},
-        {"flags.shared", m->flags.has(MessageFlag::SharedMessage)},
-        {"flags.similar", m->flags.has(MessageFlag::Similar)},
-
-        {"message.content", m->messageText},
-        {"message.length", m->messageText.length()},
-    };
+    if (slots.contains(BoolSlot::ChannelLive))
     {
         auto *tc = dynamic_cast<TwitchChannel *>(channel);
-        if (channel && !channel->isEmpty() && tc)
-        {
-            vars["channel.live"] = tc->isLive();
-        }
-        else
+        ctx.at(BoolSlot::ChannelLive) =
+            channel && !channel->isEmpty() && tc && tc->isLive();
+    }
+
+    for (const auto &[slot, flag] : FLAG_SLOTS)
+    {
+        if (slots.contains(slot))
         {
-            vars["channel.live"] = false;
+            ctx.at(slot) = m->flags.has(flag);
         }
     }
+
+    ctx.at(StringSlot::MessageContent) = m->messageText;
+    ctx.at(IntSlot::MessageLength) = m->messageText.length();
+
+    bool wantsReward = slots.contains(StringSlot::RewardTitle) ||
+                       slots.contains(IntSlot::RewardCost) ||
+                       slots.contains(StringSlot::RewardID);
+    if (!wantsReward)
+    {
+        return ctx;
+    }
+
     if (m->reward != nullptr)
     {
-        vars["reward.title"] = m->reward->title;
-        vars["reward.cost"] = m->reward->cost;
-        vars["reward.id"] = m->reward->id;
+        ctx.at(StringSlot::RewardTitle) = m->reward->title;
+        ctx.at(IntSlot::RewardCost) = m->reward->cost;
+        ctx.at(StringSlot::RewardID) = m->reward->id;
     }
     else
     {
-        vars["reward.title"] = "";
-        vars["reward.cost"] = -1;
-        vars["reward.id"] = "";
+        ctx.at(StringSlot::RewardTitle) = "";
+        ctx.at(IntSlot::RewardCost) = -1;
+        ctx.at(StringSlot::RewardID) = "";
     }
-    return vars;
+    return ctx;
+}
+
+ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel)
+{
+    return buildFilterContext(m, channel).toContextMap(MESSAGE_CONTEXT_SLOTS);
 }
 
 FilterResult Filter::fromString(const QString &str)
@@ -196,16 +276,26 @@ FilterResult Filter::fromString(const QString &str)
     {
         auto exp = parser.release();
         auto typ = parser.returnType();
-        return Filter(std::move(exp), typ);
+        return Filter(std::move(exp), typ, parser.identifiers());
     }
 
     return FilterError{parser.errors().join("\n")};
 }
 
-Filter::Filter(ExpressionPtr expression, Type returnType)
+Filter::Filter(ExpressionPtr expression, Type returnType,
+               const QSet<QString> &identifiers)
     : expression_(std::move(expression))
     , returnType_(returnType)
+    , compiled_(this->expression_->compile(MESSAGE_CONTEXT_SLOTS))
 {
+    for (const auto &identifier : identifiers)
+    {
+        auto it = MESSAGE_CONTEXT_SLOTS.find(identifier);
+        if (it != MESSAGE_CONTEXT_SLOTS.end())
+        {
+            this->usedSlots_.insert(it.value());
+        }
+    }
 }
 
 Type Filter::returnType() const
@@ -213,11 +303,30 @@ Type Filter::returnType() const
     return this->returnType_;
 }
 
+const ContextSlotSet &Filter::usedSlots() const
+{
+    return this->usedSlots_;
+}
+
 QVariant Filter::execute(const ContextMap &context) const
 {
     return this->expression_->execute(context);
 }
 
+QVariant Filter::execute(const FilterContext &context) const
+{
+    return this->compiled_.evaluate(context);
+}
+
+bool Filter::matches(const FilterContext &context) const
+{
+    if (const auto *fn = this->compiled_.get<bool>())
+    {
+        return (*fn)(context);
+    }
+    return this->compiled_.evaluate(context).toBool();
+}
+
 QString Filter::filterString() const
 {
     return this->expression_->filterString();
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "controllers/filters/lang/CompiledExpression.hpp"
 #include "controllers/filters/lang/expressions/Expression.hpp"
+#include "controllers/filters/lang/FilterContext.hpp"
 #include "controllers/filters/lang/Types.hpp"
 
+#include <QSet>
 #include <QString>
 
 #include <memory>
@@ -24,6 +27,15 @@ namespace chatterino::filters {
 // i.e. if all the variables and operators being used have compatible types.
 extern const QMap<QString, Type> MESSAGE_TYPING_CONTEXT;
 
+// MESSAGE_CONTEXT_SLOTS maps filter variables to the slot of a FilterContext
+// that holds their value. Every key of MESSAGE_TYPING_CONTEXT must be present.
+extern const SlotContext MESSAGE_CONTEXT_SLOTS;
+
+/// Builds the context for `m`. Only the slots in `slots` are filled in, the
+/// remaining slots keep their default value.
+FilterContext buildFilterContext(
+    const MessagePtr &m, chatterino::Channel *channel,
+    const ContextSlotSet &slots = ContextSlotSet::all());
 ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel);
 
 class Filter;
@@ -39,16 +51,26 @@ public:
     static FilterResult fromString(const QString &str);
 
     Type returnType() const;
+
+    /// Returns the slots of a FilterContext this filter reads
+    const ContextSlotSet &usedSlots() const;
     QVariant execute(const ContextMap &context) const;
+    QVariant execute(const FilterContext &context) const;
+
+    /// Evaluates the compiled filter and converts the result to a bool
+    bool matches(const FilterContext &context) const;
 
     QString filterString() const;
     QString debugString(const TypingContext &context) const;
 
 private:
-    Filter(ExpressionPtr expression, Type returnType);
+    Filter(ExpressionPtr expression, Type returnType,
+           const QSet<QString> &identifiers);
 
     ExpressionPtr expression_;
     Type returnType_;
+    CompiledExpression compiled_;
+    ContextSlotSet usedSlots_;
 };
 
 }  // namespace chatterino::filters
@@ -0,0 +1,97 @@
+#include "controllers/filters/lang/FilterContext.hpp"
+
+namespace chatterino::filters {
+
+ContextSlotSet ContextSlotSet::all()
+{
+    ContextSlotSet set;
+    set.bits_.set();
+    return set;
+}
+
+void ContextSlotSet::insert(ContextSlot slot)
+{
+    this->bits_.set(flatIndex(slot));
+}
+
+bool ContextSlotSet::contains(ContextSlot slot) const
+{
+    return this->bits_.test(flatIndex(slot));
+}
+
+bool ContextSlotSet::empty() const
+{
+    return this->bits_.none();
+}
+
+ContextSlotSet &ContextSlotSet::operator|=(const ContextSlotSet &other)
+{
+    this->bits_ |= other.bits_;
+    return *this;
+}
+
+bool ContextSlotSet::operator==(const ContextSlotSet &other) const
+{
+    return this->bits_ == other.bits_;
+}
+
+bool ContextSlotSet::operator!=(const ContextSlotSet &other) const
+{
+    return !(*this == other);
+}
+
+size_t ContextSlotSet::flatIndex(ContextSlot slot)
+{
+    // Bools come first, followed by ints, strings, colors and string lists
+    size_t offset = 0;
+    switch (slot.type)
+    {
+        case Type::StringList:
+            offset += static_cast<size_t>(ColorSlot::Count);
+            [[fallthrough]];
+        case Type::Color:
+            offset += static_cast<size_t>(StringSlot::Count);
+            [[fallthrough]];
+        case Type::String:
+            offset += static_cast<size_t>(IntSlot::Count);
+            [[fallthrough]];
+        case Type::Int:
+            offset += static_cast<size_t>(BoolSlot::Count);
+            [[fallthrough]];
+        case Type::Bool:
+        default:
+            break;
+    }
+    return offset + slot.index;
+}
+
+QVariant FilterContext::value(ContextSlot slot) const
+{
+    switch (slot.type)
+    {
+        case Type::Bool:
+            return this->at(static_cast<BoolSlot>(slot.index));
+        case Type::Int:
+            return this->at(static_cast<IntSlot>(slot.index));
+        case Type::String:
+            return this->at(static_cast<StringSlot>(slot.index));
+        case Type::Color:
+            return this->at(static_cast<ColorSlot>(slot.index));
+        case Type::StringList:
+            return this->at(static_cast<StringListSlot>(slot.index));
+        default:
+            return {};
+    }
+}
+
+ContextMap FilterContext::toContextMap(const SlotContext &slots) const
+{
+    ContextMap map;
+    for (auto it = slots.begin(); it != slots.end(); ++it)
+    {
+        map.insert(it.key(), this->value(it.value()));
+    }
+    return map;
+}
+
+}  // namespace chatterino::filters
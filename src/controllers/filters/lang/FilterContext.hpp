@@ -0,0 +1,212 @@
+#pragma once
+
+#include "controllers/filters/lang/Types.hpp"
+
+#include <QColor>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+namespace chatterino::filters {
+
+// Every filter identifier is stored in a typed slot of a FilterContext.
+// The mapping from identifier names to slots is MESSAGE_CONTEXT_SLOTS in
+// Filter.hpp.
+
+enum class BoolSlot : uint8_t {
+    AuthorNoColor,
+    AuthorSubbed,
+    ChannelWatching,
+    ChannelLive,
+    FlagsAction,
+    FlagsHighlighted,
+    FlagsPointsRedeemed,
+    FlagsSubMessage,
+    FlagsSystemMessage,
+    FlagsRewardMessage,
+    FlagsFirstMessage,
+    FlagsElevatedMessage,
+    FlagsHypeChat,
+    FlagsCheerMessage,
+    FlagsWhisper,
+    FlagsReply,
+    FlagsAutomod,
+    FlagsRestricted,
+    FlagsMonitored,
+    FlagsShared,
+    FlagsSimilar,
+    FlagsWebchatDetected,
+
+    Count,
+};
+
+enum class IntSlot : uint8_t {
+    AuthorSubLength,
+    MessageLength,
+    RewardCost,
+
+    Count,
+};
+
+enum class StringSlot : uint8_t {
+    AuthorName,
+    AuthorUserID,
+    ChannelName,
+    MessageContent,
+    RewardTitle,
+    RewardID,
+
+    Count,
+};
+
+enum class ColorSlot : uint8_t {
+    AuthorColor,
+
+    Count,
+};
+
+enum class StringListSlot : uint8_t {
+    AuthorBadges,
+
+    Count,
+};
+
+/// ContextSlot describes where the value of an identifier is stored in a
+/// FilterContext. `type` decides which of the slot enums `index` refers to.
+struct ContextSlot {
+    Type type;
+    uint8_t index;
+
+    ContextSlot(BoolSlot slot)
+        : type(Type::Bool)
+        , index(static_cast<uint8_t>(slot))
+    {
+    }
+
+    ContextSlot(IntSlot slot)
+        : type(Type::Int)
+        , index(static_cast<uint8_t>(slot))
+    {
+    }
+
+    ContextSlot(StringSlot slot)
+        : type(Type::String)
+        , index(static_cast<uint8_t>(slot))
+    {
+    }
+
+    ContextSlot(ColorSlot slot)
+        : type(Type::Color)
+        , index(static_cast<uint8_t>(slot))
+    {
+    }
+
+    ContextSlot(StringListSlot slot)
+        : type(Type::StringList)
+        , index(static_cast<uint8_t>(slot))
+    {
+    }
+};
+
+using SlotContext = QMap<QString, ContextSlot>;
+
+/// ContextSlotSet is a set of slots, e.g. the slots a filter reads.
+/// Only these slots have to be filled in when building a FilterContext.
+class ContextSlotSet
+{
+public:
+    static constexpr size_t SIZE = static_cast<size_t>(BoolSlot::Count) +
+                                   static_cast<size_t>(IntSlot::Count) +
+                                   static_cast<size_t>(StringSlot::Count) +
+                                   static_cast<size_t>(ColorSlot::Count) +
+                                   static_cast<size_t>(StringListSlot::Count);
+
+    /// Returns a set containing every slot
+    static ContextSlotSet all();
+
+    void insert(ContextSlot slot);
+    bool contains(ContextSlot slot) const;
+    bool empty() const;
+
+    ContextSlotSet &operator|=(const ContextSlotSet &other);
+    bool operator==(const ContextSlotSet &other) const;
+    bool operator!=(const ContextSlotSet &other) const;
+
+private:
+    static size_t flatIndex(ContextSlot slot);
+
+    std::bitset<SIZE> bits_;
+};
+
+/// FilterContext is the strongly typed counterpart to ContextMap.
+/// Compiled filters read identifiers straight from these slots.
+class FilterContext
+{
+public:
+    bool &at(BoolSlot slot)
+    {
+        return this->bools_[static_cast<size_t>(slot)];
+    }
+    bool at(BoolSlot slot) const
+    {
+        return this->bools_[static_cast<size_t>(slot)];
+    }
+
+    int &at(IntSlot slot)
+    {
+        return this->ints_[static_cast<size_t>(slot)];
+    }
+    int at(IntSlot slot) const
+    {
+        return this->ints_[static_cast<size_t>(slot)];
+    }
+
+    QString &at(StringSlot slot)
+    {
+        return this->strings_[static_cast<size_t>(slot)];
+    }
+    const QString &at(StringSlot slot) const
+    {
+        return this->strings_[static_cast<size_t>(slot)];
+    }
+
+    QColor &at(ColorSlot slot)
+    {
+        return this->colors_[static_cast<size_t>(slot)];
+    }
+    const QColor &at(ColorSlot slot) const
+    {
+        return this->colors_[static_cast<size_t>(slot)];
+    }
+
+    QStringList &at(StringListSlot slot)
+    {
+        return this->stringLists_[static_cast<size_t>(slot)];
+    }
+    const QStringList &at(StringListSlot slot) const
+    {
+        return this->stringLists_[static_cast<size_t>(slot)];
+    }
+
+    /// Returns the value of the slot as it would appear in a ContextMap
+    QVariant value(ContextSlot slot) const;
+
+    /// Converts this context to a ContextMap using the given slots
+    ContextMap toContextMap(const SlotContext &slots) const;
+
+private:
+    std::array<bool, static_cast<size_t>(BoolSlot::Count)> bools_{};
+    std::array<int, static_cast<size_t>(IntSlot::Count)> ints_{};
+    std::array<QString, static_cast<size_t>(StringSlot::Count)> strings_;
+    std::array<QColor, static_cast<size_t>(ColorSlot::Count)> colors_;
+    std::array<QStringList, static_cast<size_t>(StringListSlot::Count)>
+        stringLists_;
+};
+
+}  // namespace chatterino::filters
@@ -64,6 +64,11 @@ ExpressionPtr FilterParser::release()
     return ret;
 }
 
+const QSet<QString> &FilterParser::identifiers() const
+{
+    return this->identifiers_;
+}
+
 ExpressionPtr FilterParser::parseExpression(bool top)
 {
     auto e = this->parseAnd();
@@ -219,8 +224,9 @@ ExpressionPtr FilterParser::parseValue()
         }
         else if (type == TokenType::IDENTIFIER)
         {
-            return std::make_unique<ValueExpression>(this->tokenizer_.next(),
-                                                     type);
+            auto identifier = this->tokenizer_.next();
+            this->identifiers_.insert(identifier);
+            return std::make_unique<ValueExpression>(identifier, type);
         }
         else if (type == TokenType::REGULAR_EXPRESSION)
         {
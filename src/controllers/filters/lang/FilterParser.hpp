@@ -4,6 +4,8 @@
 #include "controllers/filters/lang/Tokenizer.hpp"
 #include "controllers/filters/lang/Types.hpp"
 
+#include <QSet>
+
 namespace chatterino::filters {
 
 class FilterParser
@@ -18,6 +20,9 @@ public:
     Type returnType() const;
     ExpressionPtr release();
 
+    /// Returns the identifiers (e.g. `message.content`) used in the filter
+    const QSet<QString> &identifiers() const;
+
     const QStringList &errors() const;
     const QString debugString() const;
 
@@ -34,6 +39,7 @@ private:
 
     QStringList parseLog_;
     bool valid_ = true;
+    QSet<QString> identifiers_;
 
     QString text_;
     Tokenizer tokenizer_;
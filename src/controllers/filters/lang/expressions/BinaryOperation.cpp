@@ -2,8 +2,12 @@
 
 #include <QRegularExpression>
 
+#include <optional>
+
 namespace {
 
+using namespace chatterino::filters;
+
 /// Loosely compares `lhs` with `rhs`.
 /// This attempts to convert both variants to a common type if they're not equal.
 bool looselyCompareVariants(QVariant &lhs, QVariant &rhs)
@@ -37,6 +41,193 @@ bool looselyCompareVariants(QVariant &lhs, QVariant &rhs)
     return lhs == rhs;
 }
 
+/// Compiles `op` into a typed evaluator if `left` evaluates to `L` and
+/// `right` evaluates to `R`.
+template <typename L, typename R, typename Result, typename Op>
+std::optional<CompiledExpression> combine(const CompiledExpression &left,
+                                          const CompiledExpression &right,
+                                          Op op)
+{
+    const auto *l = left.get<L>();
+    const auto *r = right.get<R>();
+    if (l == nullptr || r == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    return CompiledExpression::of<Result>(
+        [lhs = *l, rhs = *r, op](const FilterContext &ctx) {
+            return op(lhs(ctx), rhs(ctx));
+        });
+}
+
+/// Compiles the statically typed forms of `op`. Every case here must behave
+/// exactly like the matching case in evaluateBinaryOperation.
+std::optional<CompiledExpression> compileTyped(TokenType op,
+                                               const CompiledExpression &left,
+                                               const CompiledExpression &right)
+{
+    switch (op)
+    {
+        case AND: {
+            const auto *l = left.get<bool>();
+            const auto *r = right.get<bool>();
+            if (l == nullptr || r == nullptr)
+            {
+                return std::nullopt;
+            }
+            return CompiledExpression::of<bool>(
+                [lhs = *l, rhs = *r](const FilterContext &ctx) {
+                    return lhs(ctx) && rhs(ctx);
+                });
+        }
+        case OR: {
+            const auto *l = left.get<bool>();
+            const auto *r = right.get<bool>();
+            if (l == nullptr || r == nullptr)
+            {
+                return std::nullopt;
+            }
+            return CompiledExpression::of<bool>(
+                [lhs = *l, rhs = *r](const FilterContext &ctx) {
+                    return lhs(ctx) || rhs(ctx);
+                });
+        }
+        case PLUS:
+            if (auto res = combine<int, int, int>(left, right,
+                                                  [](int a, int b) {
+                                                      return a + b;
+                                                  }))
+            {
+                return res;
+            }
+            if (auto res = combine<QString, QString, QString>(
+                    left, right, [](QString a, const QString &b) {
+                        return a.append(b);
+                    }))
+            {
+                return res;
+            }
+            return combine<QString, int, QString>(left, right,
+                                                  [](QString a, int b) {
+                                                      return a.append(
+                                                          QString::number(b));
+                                                  });
+        case MINUS:
+            return combine<int, int, int>(left, right, [](int a, int b) {
+                return a - b;
+            });
+        case MULTIPLY:
+            return combine<int, int, int>(left, right, [](int a, int b) {
+                return a * b;
+            });
+        case DIVIDE:
+            return combine<int, int, int>(left, right, [](int a, int b) {
+                return b == 0 ? 0 : a / b;
+            });
+        case MOD:
+            return combine<int, int, int>(left, right, [](int a, int b) {
+                return b == 0 ? 0 : a % b;
+            });
+        case EQ:
+        case NEQ: {
+            bool eq = op == EQ;
+            if (auto res = combine<QString, QString, bool>(
+                    left, right, [eq](const QString &a, const QString &b) {
+                        return (a.compare(b, Qt::CaseInsensitive) == 0) == eq;
+                    }))
+            {
+                return res;
+            }
+            if (auto res = combine<int, int, bool>(left, right,
+                                                   [eq](int a, int b) {
+                                                       return (a == b) == eq;
+                                                   }))
+            {
+                return res;
+            }
+            return combine<bool, bool, bool>(left, right, [eq](bool a, bool b) {
+                return (a == b) == eq;
+            });
+        }
+        case LT:
+            return combine<int, int, bool>(left, right, [](int a, int b) {
+                return a < b;
+            });
+        case GT:
+            return combine<int, int, bool>(left, right, [](int a, int b) {
+                return a > b;
+            });
+        case LTE:
+            return combine<int, int, bool>(left, right, [](int a, int b) {
+                return a <= b;
+            });
+        case GTE:
+            return combine<int, int, bool>(left, right, [](int a, int b) {
+                return a >= b;
+            });
+        case CONTAINS:
+            if (auto res = combine<QStringList, QString, bool>(
+                    left, right, [](const QStringList &a, const QString &b) {
+                        return a.contains(b, Qt::CaseInsensitive);
+                    }))
+            {
+                return res;
+            }
+            return combine<QString, QString, bool>(
+                left, right, [](const QString &a, const QString &b) {
+                    return a.contains(b, Qt::CaseInsensitive);
+                });
+        case STARTS_WITH:
+            if (auto res = combine<QStringList, QString, bool>(
+                    left, right, [](const QStringList &a, const QString &b) {
+                        return !a.isEmpty() &&
+                               a.first().compare(b, Qt::CaseInsensitive) == 0;
+                    }))
+            {
+                return res;
+            }
+            return combine<QString, QString, bool>(
+                left, right, [](const QString &a, const QString &b) {
+                    return a.startsWith(b, Qt::CaseInsensitive);
+                });
+        case ENDS_WITH:
+            if (auto res = combine<QStringList, QString, bool>(
+                    left, right, [](const QStringList &a, const QString &b) {
+                        return !a.isEmpty() &&
+                               a.last().compare(b, Qt::CaseInsensitive) == 0;
+                    }))
+            {
+                return res;
+            }
+            return combine<QString, QString, bool>(
+                left, right, [](const QString &a, const QString &b) {
+                    return a.endsWith(b, Qt::CaseInsensitive);
+                });
+        case MATCH:
+            if (auto res = combine<QString, QRegularExpression, bool>(
+                    left, right,
+                    [](const QString &a, const QRegularExpression &b) {
+                        return b.match(a).hasMatch();
+                    }))
+            {
+                return res;
+            }
+            return combine<QString, MatchingSpecifier, QString>(
+                left, right,
+                [](const QString &a, const MatchingSpecifier &b) -> QString {
+                    auto match = b.regex.match(a);
+                    if (match.hasMatch())
+                    {
+                        return match.captured(b.group);
+                    }
+                    return "";
+                });
+        default:
+            return std::nullopt;
+    }
+}
+
 }  // namespace
 
 namespace chatterino::filters {
@@ -49,11 +240,9 @@ BinaryOperation::BinaryOperation(TokenType op, ExpressionPtr left,
 {
 }
 
-QVariant BinaryOperation::execute(const ContextMap &context) const
+QVariant evaluateBinaryOperation(TokenType op, QVariant left, QVariant right)
 {
-    auto left = this->left_->execute(context);
-    auto right = this->right_->execute(context);
-    switch (this->op_)
+    switch (op)
     {
         case PLUS:
             if (variantIs(left, QMetaType::QString) &&
@@ -81,12 +270,20 @@ QVariant BinaryOperation::execute(const ContextMap &context) const
         case DIVIDE:
             if (convertVariantTypes(left, right, QMetaType::Int))
             {
+                if (right.toInt() == 0)
+                {
+                    return 0;
+                }
                 return left.toInt() / right.toInt();
             }
             return 0;
         case MOD:
             if (convertVariantTypes(left, right, QMetaType::Int))
             {
+                if (right.toInt() == 0)
+                {
+                    return 0;
+                }
                 return left.toInt() % right.toInt();
             }
             return 0;
@@ -269,6 +466,30 @@ QVariant BinaryOperation::execute(const ContextMap &context) const
     }
 }
 
+QVariant BinaryOperation::execute(const ContextMap &context) const
+{
+    return evaluateBinaryOperation(this->op_, this->left_->execute(context),
+                                   this->right_->execute(context));
+}
+
+CompiledExpression BinaryOperation::compile(const SlotContext &context) const
+{
+    auto left = this->left_->compile(context);
+    auto right = this->right_->compile(context);
+
+    if (auto typed = compileTyped(this->op_, left, right))
+    {
+        return std::move(*typed);
+    }
+
+    // Anything we can't type statically keeps the loose QVariant semantics
+    return CompiledExpression::of<QVariant>(
+        [op = this->op_, left = left.toVariant(),
+         right = right.toVariant()](const FilterContext &ctx) {
+            return evaluateBinaryOperation(op, left(ctx), right(ctx));
+        });
+}
+
 PossibleType BinaryOperation::synthesizeType(const TypingContext &context) const
 {
     auto leftSyn = this->left_->synthesizeType(context);
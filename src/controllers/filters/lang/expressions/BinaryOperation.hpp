@@ -5,6 +5,9 @@
 
 namespace chatterino::filters {
 
+/// Applies the binary operator `op` with the loose semantics of QVariants
+QVariant evaluateBinaryOperation(TokenType op, QVariant left, QVariant right);
+
 class BinaryOperation : public Expression
 {
 public:
@@ -14,6 +17,7 @@ public:
     PossibleType synthesizeType(const TypingContext &context) const override;
     QString debug(const TypingContext &context) const override;
     QString filterString() const override;
+    CompiledExpression compile(const SlotContext &context) const override;
 
 private:
     TokenType op_;
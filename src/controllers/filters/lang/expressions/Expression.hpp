@@ -1,5 +1,7 @@
 #pragma once
 
+#include "controllers/filters/lang/CompiledExpression.hpp"
+#include "controllers/filters/lang/FilterContext.hpp"
 #include "controllers/filters/lang/Tokenizer.hpp"
 #include "controllers/filters/lang/Types.hpp"
 
@@ -20,6 +22,10 @@ public:
     virtual PossibleType synthesizeType(const TypingContext &context) const = 0;
     virtual QString debug(const TypingContext &context) const = 0;
     virtual QString filterString() const = 0;
+
+    /// Lowers this expression into a closure over the slots in `context`.
+    /// Must only be called on well-typed expressions.
+    virtual CompiledExpression compile(const SlotContext &context) const = 0;
 };
 
 using ExpressionPtr = std::unique_ptr<Expression>;
@@ -1,5 +1,34 @@
 #include "controllers/filters/lang/expressions/ListExpression.hpp"
 
+#include <algorithm>
+
+namespace {
+
+using namespace chatterino::filters;
+
+QVariant makeListVariant(const QList<QVariant> &results)
+{
+    // if everything is a string return a QStringList for case-insensitive comparison
+    bool allStrings = std::all_of(results.begin(), results.end(),
+                                  [](const QVariant &res) {
+                                      return variantIs(res, QMetaType::QString);
+                                  });
+    if (allStrings)
+    {
+        QStringList strings;
+        strings.reserve(results.size());
+        for (const auto &val : results)
+        {
+            strings << val.toString();
+        }
+        return strings;
+    }
+
+    return results;
+}
+
+}  // namespace
+
 namespace chatterino::filters {
 
 ListExpression::ListExpression(ExpressionList &&list)
@@ -8,30 +37,76 @@ ListExpression::ListExpression(ExpressionList &&list)
 QVariant ListExpression::execute(const ContextMap &context) const
 {
     QList<QVariant> results;
+    for (const auto &exp : this->list_)
+    {
+        results.append(exp->execute(context));
+    }
+
+    return makeListVariant(results);
+}
+
+CompiledExpression ListExpression::compile(const SlotContext &context) const
+{
+    std::vector<CompiledExpression> items;
+    items.reserve(this->list_.size());
     bool allStrings = true;
     for (const auto &exp : this->list_)
     {
-        auto res = exp->execute(context);
-        if (allStrings && variantIsNot(res, QMetaType::QString))
-        {
-            allStrings = false;
-        }
-        results.append(res);
+        items.push_back(exp->compile(context));
+        allStrings = allStrings && items.back().is<QString>();
     }
 
-    // if everything is a string return a QStringList for case-insensitive comparison
     if (allStrings)
     {
-        QStringList strings;
-        strings.reserve(results.size());
-        for (const auto &val : results)
+        std::vector<Evaluator<QString>> strings;
+        strings.reserve(items.size());
+        for (const auto &item : items)
         {
-            strings << val.toString();
+            strings.push_back(*item.get<QString>());
         }
-        return strings;
+
+        return CompiledExpression::of<QStringList>(
+            [strings = std::move(strings)](const FilterContext &ctx) {
+                QStringList list;
+                list.reserve(static_cast<qsizetype>(strings.size()));
+                for (const auto &fn : strings)
+                {
+                    list << fn(ctx);
+                }
+                return list;
+            });
     }
 
-    return results;
+    if (items.size() == 2 && items[0].is<QRegularExpression>() &&
+        items[1].is<int>())
+    {
+        return CompiledExpression::of<MatchingSpecifier>(
+            [regex = *items[0].get<QRegularExpression>(),
+             group = *items[1].get<int>()](const FilterContext &ctx) {
+                return MatchingSpecifier{
+                    .regex = regex(ctx),
+                    .group = group(ctx),
+                };
+            });
+    }
+
+    std::vector<Evaluator<QVariant>> variants;
+    variants.reserve(items.size());
+    for (const auto &item : items)
+    {
+        variants.push_back(item.toVariant());
+    }
+
+    return CompiledExpression::of<QVariant>(
+        [variants = std::move(variants)](const FilterContext &ctx) {
+            QList<QVariant> results;
+            results.reserve(static_cast<qsizetype>(variants.size()));
+            for (const auto &fn : variants)
+            {
+                results.append(fn(ctx));
+            }
+            return makeListVariant(results);
+        });
 }
 
 PossibleType ListExpression::synthesizeType(const TypingContext &context) const
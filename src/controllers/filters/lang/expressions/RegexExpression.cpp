@@ -20,6 +20,12 @@ PossibleType RegexExpression::synthesizeType(
     return TypeClass{Type::RegularExpression};
 }
 
+CompiledExpression RegexExpression::compile(
+    const SlotContext & /*context*/) const
+{
+    return CompiledExpression::constant(this->regex_);
+}
+
 QString RegexExpression::debug(const TypingContext & /*context*/) const
 {
     return QString("RegEx(%1)").arg(this->regexString_);
@@ -16,6 +16,7 @@ public:
     PossibleType synthesizeType(const TypingContext &context) const override;
     QString debug(const TypingContext &context) const override;
     QString filterString() const override;
+    CompiledExpression compile(const SlotContext &context) const override;
 
 private:
     QString regexString_;
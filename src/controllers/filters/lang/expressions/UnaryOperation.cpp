@@ -8,10 +8,9 @@ UnaryOperation::UnaryOperation(TokenType op, ExpressionPtr right)
 {
 }
 
-QVariant UnaryOperation::execute(const ContextMap &context) const
+QVariant evaluateUnaryOperation(TokenType op, const QVariant &right)
 {
-    auto right = this->right_->execute(context);
-    switch (this->op_)
+    switch (op)
     {
         case NOT:
             return right.canConvert<bool>() && !right.toBool();
@@ -20,6 +19,32 @@ QVariant UnaryOperation::execute(const ContextMap &context) const
     }
 }
 
+QVariant UnaryOperation::execute(const ContextMap &context) const
+{
+    return evaluateUnaryOperation(this->op_, this->right_->execute(context));
+}
+
+CompiledExpression UnaryOperation::compile(const SlotContext &context) const
+{
+    auto right = this->right_->compile(context);
+
+    if (this->op_ == NOT)
+    {
+        if (const auto *boolRight = right.get<bool>())
+        {
+            return CompiledExpression::of<bool>(
+                [operand = *boolRight](const FilterContext &ctx) {
+                    return !operand(ctx);
+                });
+        }
+    }
+
+    return CompiledExpression::of<QVariant>(
+        [op = this->op_, right = right.toVariant()](const FilterContext &ctx) {
+            return evaluateUnaryOperation(op, right(ctx));
+        });
+}
+
 PossibleType UnaryOperation::synthesizeType(const TypingContext &context) const
 {
     auto rightSyn = this->right_->synthesizeType(context);
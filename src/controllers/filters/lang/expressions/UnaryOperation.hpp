@@ -5,6 +5,9 @@
 
 namespace chatterino::filters {
 
+/// Applies the unary operator `op` with the loose semantics of QVariants
+QVariant evaluateUnaryOperation(TokenType op, const QVariant &right);
+
 class UnaryOperation : public Expression
 {
 public:
@@ -14,6 +17,7 @@ public:
     PossibleType synthesizeType(const TypingContext &context) const override;
     QString debug(const TypingContext &context) const override;
     QString filterString() const override;
+    CompiledExpression compile(const SlotContext &context) const override;
 
 private:
     TokenType op_;
@@ -41,6 +41,64 @@ PossibleType ValueExpression::synthesizeType(const TypingContext &context) const
     }
 }
 
+CompiledExpression ValueExpression::compile(const SlotContext &context) const
+{
+    switch (this->type_)
+    {
+        case TokenType::IDENTIFIER: {
+            auto it = context.find(this->value_.toString());
+            if (it == context.end())
+            {
+                // Same as looking up a missing key in a ContextMap
+                return CompiledExpression::constant(QVariant());
+            }
+
+            auto contextSlot = it.value();
+            switch (contextSlot.type)
+            {
+                case Type::Bool:
+                    return CompiledExpression::of<bool>(
+                        [slot = static_cast<BoolSlot>(contextSlot.index)](
+                            const FilterContext &ctx) {
+                            return ctx.at(slot);
+                        });
+                case Type::Int:
+                    return CompiledExpression::of<int>(
+                        [slot = static_cast<IntSlot>(contextSlot.index)](
+                            const FilterContext &ctx) {
+                            return ctx.at(slot);
+                        });
+                case Type::String:
+                    return CompiledExpression::of<QString>(
+                        [slot = static_cast<StringSlot>(contextSlot.index)](
+                            const FilterContext &ctx) {
+                            return ctx.at(slot);
+                        });
+                case Type::Color:
+                    return CompiledExpression::of<QColor>(
+                        [slot = static_cast<ColorSlot>(contextSlot.index)](
+                            const FilterContext &ctx) {
+                            return ctx.at(slot);
+                        });
+                case Type::StringList:
+                    return CompiledExpression::of<QStringList>(
+                        [slot = static_cast<StringListSlot>(contextSlot.index)](
+                            const FilterContext &ctx) {
+                            return ctx.at(slot);
+                        });
+                default:
+                    return CompiledExpression::constant(QVariant());
+            }
+        }
+        case TokenType::INT:
+            return CompiledExpression::constant(this->value_.toInt());
+        case TokenType::STRING:
+            return CompiledExpression::constant(this->value_.toString());
+        default:
+            return CompiledExpression::constant(this->value_);
+    }
+}
+
 TokenType ValueExpression::type()
 {
     return this->type_;
@@ -17,17 +17,19 @@ namespace {
 
 using namespace chatterino;
 
-auto highlightPhraseCheck(const HighlightPhrase &highlight) -> HighlightCheck
+auto highlightPhraseCheck(const HighlightPhrase &highlight,
+                          HighlightPhraseMatcher &matcher) -> HighlightCheck
 {
     return HighlightCheck{
-        [highlight](const auto &args, const auto &badges,
-                    const auto &senderName, const auto &originalMessage,
-                    const auto &flags,
-                    const auto self) -> std::optional<HighlightResult> {
-            (void)args;        // unused
-            (void)badges;      // unused
-            (void)senderName;  // unused
-            (void)flags;       // unused
+        .cb = [highlight](const auto &args, const auto &badges,
+                          const auto &senderName, const auto &originalMessage,
+                          const auto &flags,
+                          const auto self) -> std::optional<HighlightResult> {
+            (void)args;             // unused
+            (void)badges;           // unused
+            (void)senderName;       // unused
+            (void)originalMessage;  // unused
+            (void)flags;            // unused
 
             if (self)
             {
@@ -35,10 +37,7 @@ auto highlightPhraseCheck(const HighlightPhrase &highlight) -> HighlightCheck
                 return std::nullopt;
             }
 
-            if (!highlight.isMatch(originalMessage))
-            {
-                return std::nullopt;
-            }
+            // Only called if the phrase matched the original message
 
             std::optional<QUrl> highlightSoundUrl;
             if (highlight.hasCustomSound())
@@ -51,7 +50,10 @@ auto highlightPhraseCheck(const HighlightPhrase &highlight) -> HighlightCheck
                 highlightSoundUrl,          highlight.getColor(),
                 highlight.showInMentions(),
             };
-        }};
+        },
+        .subject = HighlightCheck::Subject::Message,
+        .phraseIndex = matcher.add(highlight),
+    };
 }
 
 void rebuildSubscriptionHighlights(Settings &settings,
@@ -181,7 +183,8 @@ void rebuildReplyThreadHighlight(Settings &settings,
 }
 
 void rebuildMessageHighlights(Settings &settings,
-                              std::vector<HighlightCheck> &checks)
+                              std::vector<HighlightCheck> &checks,
+                              HighlightPhraseMatcher &matcher)
 {
     auto currentUser = getApp()->getAccounts()->twitch.getCurrent();
     QString currentUsername = currentUser->getUserName();
@@ -196,13 +199,13 @@ void rebuildMessageHighlights(Settings &settings,
             settings.selfHighlightSoundUrl.getValue(),
             ColorProvider::instance().color(ColorType::SelfHighlight));
 
-        checks.emplace_back(highlightPhraseCheck(highlight));
+        checks.emplace_back(highlightPhraseCheck(highlight, matcher));
     }
 
     auto messageHighlights = settings.highlightedMessages.readOnly();
     for (const auto &highlight : *messageHighlights)
     {
-        checks.emplace_back(highlightPhraseCheck(highlight));
+        checks.emplace_back(highlightPhraseCheck(highlight, matcher));
     }
 
     if (settings.enableAutomodHighlight)
@@ -244,7 +247,8 @@ void rebuildMessageHighlights(Settings &settings,
 }
 
 void rebuildUserHighlights(Settings &settings,
-                           std::vector<HighlightCheck> &checks)
+                           std::vector<HighlightCheck> &checks,
+                           HighlightPhraseMatcher &matcher)
 {
     auto userHighlights = settings.highlightedUsers.readOnly();
 
@@ -280,20 +284,19 @@ void rebuildUserHighlights(Settings &settings,
     for (const auto &highlight : *userHighlights)
     {
         checks.emplace_back(HighlightCheck{
-            [highlight](const auto &args, const auto &badges,
-                        const auto &senderName, const auto &originalMessage,
-                        const auto &flags,
-                        const auto self) -> std::optional<HighlightResult> {
+            .cb = [highlight](
+                      const auto &args, const auto &badges,
+                      const auto &senderName, const auto &originalMessage,
+                      const auto &flags,
+                      const auto self) -> std::optional<HighlightResult> {
                 (void)args;             // unused
                 (void)badges;           // unused
+                (void)senderName;       // unused
                 (void)originalMessage;  // unused
                 (void)flags;            // unused
                 (void)self;             // unused
 
-                if (!highlight.isMatch(senderName))
-                {
-                    return std::nullopt;
-                }
+                // Only called if the phrase matched the sender name
 
                 std::optional<QUrl> highlightSoundUrl;
                 if (highlight.hasCustomSound())
@@ -308,7 +311,10 @@ void rebuildUserHighlights(Settings &settings,
                     highlight.getColor(),        //
                     highlight.showInMentions(),  //
                 };
-            }});
+            },
+            .subject = HighlightCheck::Subject::Sender,
+            .phraseIndex = matcher.add(highlight),
+        });
     }
 }
 
@@ -523,22 +529,26 @@ void HighlightController::rebuildChecks(Settings &settings)
 {
     // Access checks for modification
     auto checks = this->checks_.access();
-    checks->clear();
+    *checks = {};
 
     // CURRENT ORDER:
     // Subscription -> Whisper -> Message -> User -> Reply Threads -> Badge
 
-    rebuildSubscriptionHighlights(settings, *checks);
+    rebuildSubscriptionHighlights(settings, checks->checks);
+
+    rebuildWhisperHighlights(settings, checks->checks);
 
-    rebuildWhisperHighlights(settings, *checks);
+    rebuildMessageHighlights(settings, checks->checks,
+                             checks->messagePhrases);
 
-    rebuildMessageHighlights(settings, *checks);
+    rebuildUserHighlights(settings, checks->checks, checks->senderPhrases);
 
-    rebuildUserHighlights(settings, *checks);
+    rebuildReplyThreadHighlight(settings, checks->checks);
 
-    rebuildReplyThreadHighlight(settings, *checks);
+    rebuildBadgeHighlights(settings, checks->checks);
 
-    rebuildBadgeHighlights(settings, *checks);
+    checks->messagePhrases.build();
+    checks->senderPhrases.build();
 }
 
 std::pair<bool, HighlightResult> HighlightController::check(
@@ -555,8 +565,39 @@ std::pair<bool, HighlightResult> HighlightController::check(
     auto currentUser = getApp()->getAccounts()->twitch.getCurrent();
     auto self = (senderName == currentUser->getUserName());
 
-    for (const auto &check : *checks)
+    // The phrases are matched lazily, once for all phrase checks
+    std::optional<std::vector<bool>> messageMatches;
+    std::optional<std::vector<bool>> senderMatches;
+
+    for (const auto &check : checks->checks)
     {
+        switch (check.subject)
+        {
+            case HighlightCheck::Subject::Message:
+                if (!messageMatches)
+                {
+                    messageMatches =
+                        checks->messagePhrases.match(originalMessage);
+                }
+                if (!(*messageMatches)[check.phraseIndex])
+                {
+                    continue;
+                }
+                break;
+            case HighlightCheck::Subject::Sender:
+                if (!senderMatches)
+                {
+                    senderMatches = checks->senderPhrases.match(senderName);
+                }
+                if (!(*senderMatches)[check.phraseIndex])
+                {
+                    continue;
+                }
+                break;
+            case HighlightCheck::Subject::None:
+                break;
+        }
+
         if (auto checkResult = check.cb(args, badges, senderName,
                                         originalMessage, messageFlags, self);
             checkResult)
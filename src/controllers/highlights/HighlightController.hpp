@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/UniqueAccess.hpp"
+#include "controllers/highlights/HighlightPhraseMatcher.hpp"
 #include "messages/MessageFlag.hpp"
 #include "singletons/Settings.hpp"
 
@@ -10,6 +11,7 @@
 #include <QColor>
 #include <QUrl>
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -81,6 +83,29 @@ struct HighlightCheck {
         const QString &senderName, const QString &originalMessage,
         const MessageFlags &messageFlags, bool self)>;
     Checker cb;
+
+    enum class Subject : uint8_t {
+        /// `cb` is always called
+        None,
+        /// `cb` is only called if the phrase at `phraseIndex` of the message
+        /// phrase matcher matched the original message
+        Message,
+        /// `cb` is only called if the phrase at `phraseIndex` of the sender
+        /// phrase matcher matched the sender name
+        Sender,
+    };
+    Subject subject = Subject::None;
+    size_t phraseIndex = 0;
+};
+
+struct HighlightChecks {
+    /// Checks in order of their priority
+    std::vector<HighlightCheck> checks;
+
+    /// Phrases matched against the original message
+    HighlightPhraseMatcher messagePhrases;
+    /// Phrases matched against the sender name
+    HighlightPhraseMatcher senderPhrases;
 };
 
 class HighlightController final
@@ -104,7 +129,7 @@ private:
      **/
     void rebuildChecks(Settings &settings);
 
-    UniqueAccess<std::vector<HighlightCheck>> checks_;
+    UniqueAccess<HighlightChecks> checks_;
 
     pajlada::SettingListener rebuildListener_;
     pajlada::Signals::SignalHolder signalHolder_;
@@ -0,0 +1,45 @@
+#include "controllers/highlights/HighlightPhraseMatcher.hpp"
+
+namespace chatterino {
+
+size_t HighlightPhraseMatcher::add(const HighlightPhrase &phrase)
+{
+    this->phrases_.push_back(phrase);
+
+    // Non-regex phrases are wrapped in word boundaries, the pattern itself
+    // still has to occur in the subject
+    return this->prefilter_.add(phrase.getPattern(), phrase.isRegex(),
+                                phrase.isCaseSensitive() ? Qt::CaseSensitive
+                                                         : Qt::CaseInsensitive);
+}
+
+void HighlightPhraseMatcher::build()
+{
+    this->prefilter_.build();
+}
+
+std::vector<bool> HighlightPhraseMatcher::match(const QString &subject) const
+{
+    if (this->phrases_.empty())
+    {
+        return {};
+    }
+
+    auto matched = this->prefilter_.candidates(subject);
+    for (size_t i = 0; i < matched.size(); i++)
+    {
+        if (matched[i] && !this->prefilter_.isExact(i))
+        {
+            matched[i] = this->phrases_[i].isMatch(subject);
+        }
+    }
+
+    return matched;
+}
+
+size_t HighlightPhraseMatcher::size() const
+{
+    return this->phrases_.size();
+}
+
+}  // namespace chatterino
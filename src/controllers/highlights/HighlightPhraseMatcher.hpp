@@ -0,0 +1,38 @@
+#pragma once
+
+#include "controllers/highlights/HighlightPhrase.hpp"
+#include "util/PatternPrefilter.hpp"
+
+#include <QString>
+
+#include <vector>
+
+namespace chatterino {
+
+/// HighlightPhraseMatcher checks a subject against many HighlightPhrases at
+/// once, with the same result as calling HighlightPhrase::isMatch on each.
+///
+/// All phrases are run through a PatternPrefilter first. Regex phrases are
+/// matched by it directly, other phrases that pass it are checked with their
+/// own regex.
+class HighlightPhraseMatcher
+{
+public:
+    /// Adds `phrase` and returns its index in the result of match()
+    size_t add(const HighlightPhrase &phrase);
+
+    /// Must be called after all phrases have been added
+    void build();
+
+    /// Returns the phrases matching `subject`. The n-th entry is true if the
+    /// phrase with index n matched.
+    std::vector<bool> match(const QString &subject) const;
+
+    size_t size() const;
+
+private:
+    std::vector<HighlightPhrase> phrases_;
+    PatternPrefilter prefilter_;
+};
+
+}  // namespace chatterino
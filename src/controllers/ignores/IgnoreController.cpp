@@ -5,6 +5,7 @@
 #include "common/QLogging.hpp"
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/ignores/IgnorePhrase.hpp"
+#include "controllers/ignores/IgnorePhraseMatcher.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchIrc.hpp"
 #include "singletons/Settings.hpp"
@@ -135,17 +136,14 @@ bool isIgnoredMessage(IgnoredMessageParameters &&params)
 {
     if (!params.message.isEmpty())
     {
-        // TODO(pajlada): Do we need to check if the phrase is valid first?
-        auto phrases = getSettings()->ignoredMessages.readOnly();
-        for (const auto &phrase : *phrases)
+        const auto *phrase =
+            IgnorePhraseMatcher::current()->findBlockingPhrase(params.message);
+        if (phrase != nullptr)
         {
-            if (phrase.isBlock() && phrase.isMatch(params.message))
-            {
-                qCDebug(chatterinoMessage)
-                    << "Blocking message because it contains ignored phrase"
-                    << phrase.getPattern();
-                return true;
-            }
+            qCDebug(chatterinoMessage)
+                << "Blocking message because it contains ignored phrase"
+                << phrase->getPattern();
+            return true;
         }
     }
 
@@ -190,6 +188,12 @@ bool isIgnoredMessage(IgnoredMessageParameters &&params)
 void processIgnorePhrases(const std::vector<IgnorePhrase> &phrases,
                           QString &content,
                           std::vector<TwitchEmoteOccurrence> &twitchEmotes)
+{
+    processIgnorePhrases(IgnorePhraseMatcher(phrases), content, twitchEmotes);
+}
+
+void processIgnorePhrases(const IgnorePhraseMatcher &matcher, QString &content,
+                          std::vector<TwitchEmoteOccurrence> &twitchEmotes)
 {
     using SizeType = QString::size_type;
 
@@ -258,8 +262,10 @@ void processIgnorePhrases(const std::vector<IgnorePhrase> &phrases,
         }
     };
 
+    size_t replacementCount = 0;
     auto replaceMessageAt = [&](const IgnorePhrase &phrase, SizeType from,
                                 SizeType length, const QString &replacement) {
+        replacementCount++;
         auto removedEmotes = removeEmotesInRange(from, length);
         content.replace(from, length, replacement);
         auto wordStart = from;
@@ -314,17 +320,21 @@ void processIgnorePhrases(const std::vector<IgnorePhrase> &phrases,
         addReplEmotes(phrase, midExtendedRef, wordStart);
     };
 
-    for (const auto &phrase : phrases)
+    const auto &phrases = matcher.replacements();
+    // Phrases are applied in order, so a replacement can introduce text
+    // matched by a later phrase. The candidates are updated whenever the
+    // content changes.
+    auto candidates = matcher.replacementCandidates(content);
+    for (size_t i = 0; i < phrases.size(); i++)
     {
-        if (phrase.isBlock())
+        if (!candidates[i])
         {
             continue;
         }
+
+        const auto &phrase = phrases[i];
         const auto &pattern = phrase.getPattern();
-        if (pattern.isEmpty())
-        {
-            continue;
-        }
+        auto countBefore = replacementCount;
         if (phrase.isRegex())
         {
             const auto &regex = phrase.getRegex();
@@ -355,17 +365,22 @@ void processIgnorePhrases(const std::vector<IgnorePhrase> &phrases,
                     return;
                 }
             }
-
-            continue;
+        }
+        else
+        {
+            SizeType from = 0;
+            while ((from = content.indexOf(pattern, from,
+                                           phrase.caseSensitivity())) != -1)
+            {
+                replaceMessageAt(phrase, from, pattern.length(),
+                                 phrase.getReplace());
+                from += phrase.getReplace().length();
+            }
         }
 
-        SizeType from = 0;
-        while ((from = content.indexOf(pattern, from,
-                                       phrase.caseSensitivity())) != -1)
+        if (replacementCount != countBefore)
         {
-            replaceMessageAt(phrase, from, pattern.length(),
-                             phrase.getReplace());
-            from += phrase.getReplace().length();
+            candidates = matcher.replacementCandidates(content);
         }
     }
 }
@@ -7,6 +7,7 @@
 namespace chatterino {
 
 class IgnorePhrase;
+class IgnorePhraseMatcher;
 struct TwitchEmoteOccurrence;
 
 enum class ShowIgnoredUsersMessages { Never, IfModerator, IfBroadcaster };
@@ -34,4 +35,11 @@ void processIgnorePhrases(const std::vector<IgnorePhrase> &phrases,
                           QString &content,
                           std::vector<TwitchEmoteOccurrence> &twitchEmotes);
 
+/// @brief Processes the replacement ignore-phrases of a precompiled matcher
+///
+/// Same as the overload above, but phrases that can't match the message are
+/// skipped without scanning the message for each of them.
+void processIgnorePhrases(const IgnorePhraseMatcher &matcher, QString &content,
+                          std::vector<TwitchEmoteOccurrence> &twitchEmotes);
+
 }  // namespace chatterino
@@ -0,0 +1,87 @@
+#include "controllers/ignores/IgnorePhraseMatcher.hpp"
+
+#include "singletons/Settings.hpp"
+
+#include <mutex>
+
+namespace chatterino {
+
+IgnorePhraseMatcher::IgnorePhraseMatcher(
+    const std::vector<IgnorePhrase> &phrases)
+{
+    for (const auto &phrase : phrases)
+    {
+        if (phrase.isBlock())
+        {
+            this->blocks_.push_back(phrase);
+            this->blockPrefilter_.add(phrase.getPattern(), phrase.isRegex(),
+                                      phrase.caseSensitivity());
+        }
+        else
+        {
+            this->replacements_.push_back(phrase);
+            this->replacementPrefilter_.add(phrase.getPattern(),
+                                            phrase.isRegex(),
+                                            phrase.caseSensitivity());
+        }
+    }
+
+    this->blockPrefilter_.build();
+    this->replacementPrefilter_.build();
+}
+
+std::shared_ptr<const IgnorePhraseMatcher> IgnorePhraseMatcher::current()
+{
+    struct Cache {
+        std::mutex mutex;
+        std::shared_ptr<const std::vector<IgnorePhrase>> source;
+        std::shared_ptr<const IgnorePhraseMatcher> matcher;
+    };
+    // Intentionally leaked, the phrases might hold emotes which must not be
+    // destroyed after the application
+    static auto *cache = new Cache;
+
+    auto phrases = getSettings()->ignoredMessages.readOnly();
+
+    std::lock_guard lock(cache->mutex);
+    if (cache->source != phrases || !cache->matcher)
+    {
+        cache->source = phrases;
+        cache->matcher = std::make_shared<const IgnorePhraseMatcher>(*phrases);
+    }
+    return cache->matcher;
+}
+
+const IgnorePhrase *IgnorePhraseMatcher::findBlockingPhrase(
+    const QString &message) const
+{
+    if (this->blocks_.empty())
+    {
+        return nullptr;
+    }
+
+    auto candidates = this->blockPrefilter_.candidates(message);
+    for (size_t i = 0; i < this->blocks_.size(); i++)
+    {
+        if (candidates[i] && (this->blockPrefilter_.isExact(i) ||
+                              this->blocks_[i].isMatch(message)))
+        {
+            return &this->blocks_[i];
+        }
+    }
+
+    return nullptr;
+}
+
+const std::vector<IgnorePhrase> &IgnorePhraseMatcher::replacements() const
+{
+    return this->replacements_;
+}
+
+std::vector<bool> IgnorePhraseMatcher::replacementCandidates(
+    const QString &content) const
+{
+    return this->replacementPrefilter_.candidates(content);
+}
+
+}  // namespace chatterino
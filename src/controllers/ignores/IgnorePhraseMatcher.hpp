@@ -0,0 +1,48 @@
+#pragma once
+
+#include "controllers/ignores/IgnorePhrase.hpp"
+#include "util/PatternPrefilter.hpp"
+
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+/// IgnorePhraseMatcher is a precompiled set of IgnorePhrases.
+///
+/// Block and replacement phrases are each run through a PatternPrefilter,
+/// so a message only has to be scanned once to find the phrases that can
+/// apply to it.
+class IgnorePhraseMatcher
+{
+public:
+    explicit IgnorePhraseMatcher(const std::vector<IgnorePhrase> &phrases);
+
+    /// Returns the matcher for the ignored phrases from the settings.
+    /// The matcher is only rebuilt if the phrases changed.
+    ///
+    /// This can be called from any thread.
+    static std::shared_ptr<const IgnorePhraseMatcher> current();
+
+    /// Returns the first block phrase matching `message` or nullptr if no
+    /// block phrase matches
+    const IgnorePhrase *findBlockingPhrase(const QString &message) const;
+
+    /// Returns the replacement phrases in the order they should be applied
+    const std::vector<IgnorePhrase> &replacements() const;
+
+    /// Returns the replacement phrases that might match `content`.
+    /// If the n-th entry is false, replacements()[n] doesn't match.
+    std::vector<bool> replacementCandidates(const QString &content) const;
+
+private:
+    std::vector<IgnorePhrase> blocks_;
+    PatternPrefilter blockPrefilter_;
+
+    std::vector<IgnorePhrase> replacements_;
+    PatternPrefilter replacementPrefilter_;
+};
+
+}  // namespace chatterino
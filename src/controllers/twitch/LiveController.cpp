@@ -93,9 +93,9 @@ void TwitchLiveController::request(std::optional<QStringList> optChannelIDs)
 
     qCDebug(LOG) << "Make" << batches.size() << "requests";
 
+    // Helix sends the batches concurrently
     for (const auto &batch : batches)
     {
-        // TODO: Explore making this concurrent
         getHelix()->fetchStreams(
             batch, {},
             [this, batch{batch}](const auto &streams) {
@@ -148,7 +148,6 @@ void TwitchLiveController::request(std::optional<QStringList> optChannelIDs)
             },
             [] {});
 
-        // TODO: Explore making this concurrent
         getHelix()->fetchChannels(
             batch,
             [this, batch{batch}](const auto &helixChannels) {
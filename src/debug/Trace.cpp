@@ -0,0 +1,324 @@
+#include "debug/Trace.hpp"
+
+#include "common/Literals.hpp"
+#include "common/QLogging.hpp"
+#include "debug/AssertInGuiThread.hpp"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringBuilder>
+#include <QThread>
+#include <QTimer>
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace chatterino;
+using namespace literals;
+
+/// Stop recording if something records in a loop - about 100MB of memory
+constexpr size_t MAX_EVENTS = 1'000'000;
+
+struct Event {
+    /// Phase as in the trace-event format ("X", "b", "e", "i", "M")
+    char phase;
+    const char *category;
+    QString name;
+    int tid;
+    int64_t ts;
+    int64_t duration;
+    uint64_t flowID;
+};
+
+struct State {
+    std::mutex mutex;
+    std::vector<Event> events;
+    QString path;
+    std::chrono::steady_clock::time_point start;
+    int nextTid = 1;
+};
+
+std::atomic<bool> recording{false};
+std::atomic<uint64_t> nextFlowID{1};
+
+State &state()
+{
+    // Leaked on purpose: events may be recorded while static objects are
+    // destroyed
+    static auto *state = new State;
+    return *state;
+}
+
+QString currentThreadName(int tid)
+{
+    if (isGuiThread())
+    {
+        return u"GUI"_s;
+    }
+
+    auto name = QThread::currentThread()->objectName();
+    if (!name.isEmpty())
+    {
+        return name;
+    }
+    return u"Thread " % QString::number(tid);
+}
+
+/// Must be called with the mutex held
+int currentTid(State &s)
+{
+    // 0 is "not assigned yet", ids are only valid for one recording, which
+    // is fine since we only record once per run
+    thread_local int tid = 0;
+    if (tid == 0)
+    {
+        tid = s.nextTid++;
+        s.events.push_back({
+            .phase = 'M',
+            .category = "",
+            .name = currentThreadName(tid),
+            .tid = tid,
+            .ts = 0,
+            .duration = 0,
+            .flowID = 0,
+        });
+    }
+    return tid;
+}
+
+void record(Event event)
+{
+    auto &s = state();
+    std::lock_guard lock(s.mutex);
+    if (!recording)
+    {
+        return;
+    }
+    if (s.events.size() >= MAX_EVENTS)
+    {
+        qCWarning(chatterinoApp)
+            << "Trace is full, no more events are recorded";
+        recording = false;
+        return;
+    }
+
+    event.tid = currentTid(s);
+    s.events.push_back(std::move(event));
+}
+
+QJsonObject toJson(const Event &event, qint64 pid)
+{
+    QJsonObject object{
+        {"ph", QString(QChar::fromLatin1(event.phase))},
+        {"pid", pid},
+        {"tid", event.tid},
+    };
+
+    switch (event.phase)
+    {
+        case 'M':
+            object["name"] = "thread_name";
+            object["args"] = QJsonObject{{"name", event.name}};
+            return object;
+        case 'X':
+            object["dur"] = event.duration;
+            break;
+        case 'b':
+        case 'e':
+            // ids are strings so they don't lose precision in JS
+            object["id"] = QString::number(event.flowID);
+            break;
+        case 'i':
+            // Draw the instant event across all tracks of the process
+            object["s"] = "p";
+            break;
+        default:
+            break;
+    }
+
+    object["name"] = event.name;
+    object["cat"] = event.category;
+    object["ts"] = event.ts;
+    return object;
+}
+
+}  // namespace
+
+namespace chatterino {
+
+void Trace::start(const QString &path, std::chrono::milliseconds duration)
+{
+    auto &s = state();
+    {
+        std::lock_guard lock(s.mutex);
+        if (recording)
+        {
+            return;
+        }
+        s.path = path;
+        s.start = std::chrono::steady_clock::now();
+        s.events.reserve(4096);
+        recording = true;
+    }
+
+    qCDebug(chatterinoApp) << "Recording a trace to" << path << "for"
+                           << duration.count() << "ms";
+    QTimer::singleShot(duration, QCoreApplication::instance(), [] {
+        Trace::finish();
+    });
+}
+
+void Trace::finish()
+{
+    std::vector<Event> events;
+    QString path;
+    {
+        auto &s = state();
+        std::lock_guard lock(s.mutex);
+        if (s.path.isEmpty())
+        {
+            // Never started or already written
+            return;
+        }
+        recording = false;
+        events = std::move(s.events);
+        path = std::exchange(s.path, {});
+    }
+
+    auto pid = QCoreApplication::applicationPid();
+    QJsonArray traceEvents;
+    for (const auto &event : events)
+    {
+        traceEvents.append(toJson(event, pid));
+    }
+
+    QFile file(path);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate))
+    {
+        qCWarning(chatterinoApp)
+            << "Failed to write trace to" << path << file.errorString();
+        return;
+    }
+    file.write(QJsonDocument(QJsonObject{
+                                 {"traceEvents", traceEvents},
+                                 {"displayTimeUnit", "ms"},
+                             })
+                   .toJson(QJsonDocument::Compact));
+
+    qCDebug(chatterinoApp) << "Wrote" << events.size() << "trace events to"
+                           << path;
+}
+
+bool Trace::isRecording()
+{
+    return recording.load();
+}
+
+uint64_t Trace::newFlowID()
+{
+    return nextFlowID.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Trace::asyncBegin(const char *category, const QString &name,
+                       uint64_t flowID)
+{
+    if (!Trace::isRecording())
+    {
+        return;
+    }
+
+    record({
+        .phase = 'b',
+        .category = category,
+        .name = name,
+        .tid = 0,
+        .ts = Trace::now(),
+        .duration = 0,
+        .flowID = flowID,
+    });
+}
+
+void Trace::asyncEnd(const char *category, const QString &name,
+                     uint64_t flowID)
+{
+    if (!Trace::isRecording())
+    {
+        return;
+    }
+
+    record({
+        .phase = 'e',
+        .category = category,
+        .name = name,
+        .tid = 0,
+        .ts = Trace::now(),
+        .duration = 0,
+        .flowID = flowID,
+    });
+}
+
+void Trace::instant(const char *category, const QString &name)
+{
+    if (!Trace::isRecording())
+    {
+        return;
+    }
+
+    record({
+        .phase = 'i',
+        .category = category,
+        .name = name,
+        .tid = 0,
+        .ts = Trace::now(),
+        .duration = 0,
+        .flowID = 0,
+    });
+}
+
+int64_t Trace::now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - state().start)
+        .count();
+}
+
+void Trace::complete(const char *category, const QString &name, int64_t start)
+{
+    record({
+        .phase = 'X',
+        .category = category,
+        .name = name,
+        .tid = 0,
+        .ts = start,
+        .duration = Trace::now() - start,
+        .flowID = 0,
+    });
+}
+
+TraceSpan::TraceSpan(const char *name, const char *category)
+    : name_(name)
+    , category_(category)
+{
+    if (Trace::isRecording())
+    {
+        this->start_ = Trace::now();
+    }
+}
+
+TraceSpan::~TraceSpan()
+{
+    if (this->start_ >= 0 && Trace::isRecording())
+    {
+        Trace::complete(this->category_, QString::fromUtf8(this->name_),
+                        this->start_);
+    }
+}
+
+}  // namespace chatterino
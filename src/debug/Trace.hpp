@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QString>
+
+#include <chrono>
+#include <cstdint>
+
+namespace chatterino {
+
+/**
+ * @brief Records a trace in the Chrome trace-event format.
+ *
+ * The trace can be opened in Perfetto (https://ui.perfetto.dev) or
+ * chrome://tracing. Recording is started with `--trace-startup <file>`.
+ * While nothing is recorded, all functions return after checking a single
+ * atomic flag.
+ *
+ * Events may be recorded from any thread. Each thread shows up as its own
+ * track.
+ */
+class Trace
+{
+public:
+    /// Starts recording. The trace is written to `path` after `duration` or
+    /// when finish() is called, whichever is first.
+    static void start(const QString &path, std::chrono::milliseconds duration);
+
+    /// Stops recording and writes the trace. Does nothing if nothing is
+    /// recorded.
+    static void finish();
+
+    static bool isRecording();
+
+    /// Returns a new ID to connect the start and end of an async operation
+    static uint64_t newFlowID();
+
+    /// Starts an async operation, which may end on another thread
+    static void asyncBegin(const char *category, const QString &name,
+                           uint64_t flowID);
+    /// Ends an async operation started with asyncBegin
+    static void asyncEnd(const char *category, const QString &name,
+                         uint64_t flowID);
+
+    /// Records a single point in time (e.g. the first paint)
+    static void instant(const char *category, const QString &name);
+
+private:
+    friend class TraceSpan;
+
+    static int64_t now();
+    static void complete(const char *category, const QString &name,
+                         int64_t start);
+};
+
+/// Records the time from its construction until its destruction as a span on
+/// the current thread
+class TraceSpan
+{
+public:
+    /// @param name must outlive the span, so prefer string literals
+    explicit TraceSpan(const char *name, const char *category = "app");
+    ~TraceSpan();
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+    TraceSpan(TraceSpan &&) = delete;
+    TraceSpan &operator=(TraceSpan &&) = delete;
+
+private:
+    const char *name_;
+    const char *category_;
+    /// Start in microseconds, negative if nothing is recorded
+    int64_t start_ = -1;
+};
+
+}  // namespace chatterino
@@ -4,6 +4,7 @@
 #include "common/Modes.hpp"
 #include "common/QLogging.hpp"
 #include "common/Version.hpp"
+#include "debug/Trace.hpp"
 #include "providers/IvrApi.hpp"
 #include "providers/NetworkConfigurationProvider.hpp"
 #include "providers/twitch/api/Helix.hpp"
@@ -101,6 +102,11 @@ int main(int argc, char **argv)
             attachToConsole();
         }
 
+        if (args.traceFile)
+        {
+            Trace::start(*args.traceFile, std::chrono::seconds(30));
+        }
+
         qCInfo(chatterinoApp).noquote()
             << "Chatterino Qt SSL library build version:"
             << QSslSocket::sslLibraryBuildVersionString();
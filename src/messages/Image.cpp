@@ -406,7 +406,7 @@ std::optional<QPixmap> Image::pixmapOrLoad() const
     return this->frames_->current();
 }
 
-void Image::load() const
+void Image::load(NetworkPriority priority) const
 {
     assertInGuiThread();
 
@@ -414,7 +414,7 @@ void Image::load() const
     {
         Image *this2 = const_cast<Image *>(this);
         this2->shouldLoad_ = false;
-        this2->actuallyLoad();
+        this2->actuallyLoad(priority);
 #ifndef DISABLE_IMAGE_EXPIRATION_POOL
         ImageExpirationPool::instance().addImagePtr(this2->shared_from_this());
 #endif
@@ -464,12 +464,13 @@ int Image::height() const
     return static_cast<int>(this->expectedSize_.height() * this->scale_);
 }
 
-void Image::actuallyLoad()
+void Image::actuallyLoad(NetworkPriority priority)
 {
     auto weak = weakOf(this);
     NetworkRequest(this->url().string)
         .concurrent()
         .cache()
+        .priority(priority)
         .onSuccess([weak](auto result) {
             auto shared = weak.lock();
             if (!shared)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/Aliases.hpp"
+#include "common/network/NetworkCommon.hpp"
 
 #include <boost/variant.hpp>
 #include <pajlada/signals/signal.hpp>
@@ -93,7 +94,9 @@ public:
     bool loaded() const;
     // either returns the current pixmap, or triggers loading it (lazy loading)
     std::optional<QPixmap> pixmapOrLoad() const;
-    void load() const;
+    /// Starts loading the image if it isn't loaded yet. Use
+    /// NetworkPriority::Background for images that aren't visible yet.
+    void load(NetworkPriority priority = NetworkPriority::Images) const;
     qreal scale() const;
     bool isEmpty() const;
     int width() const;
@@ -109,7 +112,7 @@ private:
     Image(qreal scale);
 
     void setPixmap(const QPixmap &pixmap);
-    void actuallyLoad();
+    void actuallyLoad(NetworkPriority priority);
     void expireFrames();
 
     const Url url_{};
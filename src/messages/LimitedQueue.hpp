@@ -109,6 +109,23 @@ public:
         return this->buffer_.back();
     }
 
+    /**
+     * @brief Get the last item from the queue together with its index
+     *
+     * @return the index and item at the back of the queue if it's populated, or none the queue is empty
+     */
+    [[nodiscard]] std::optional<std::pair<size_t, T>> lastWithIndex() const
+    {
+        std::shared_lock lock(this->mutex_);
+
+        if (this->buffer_.empty())
+        {
+            return std::nullopt;
+        }
+
+        return std::pair{this->buffer_.size() - 1, this->buffer_.back()};
+    }
+
     /// Modifiers
 
     // Clear the buffer
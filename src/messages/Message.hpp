@@ -70,6 +70,18 @@ struct Message {
 
     std::shared_ptr<ChannelPointReward> reward = nullptr;
 
+    /// A cached result of a filter applied to this message.
+    /// See FilterRecord::cachedResult.
+    struct FilterCacheEntry {
+        /// FilterRecord::cacheKey of the filter
+        uint32_t filterKey;
+        /// Flags of the message when the filter was applied
+        MessageFlags flags;
+        bool result;
+    };
+    /// Must only be accessed from the GUI thread
+    mutable std::vector<FilterCacheEntry> filterCache;
+
     /**
      * Clones this message. Before contructing the shared pointer, 
      * `fn` is called with a reference to the new message.
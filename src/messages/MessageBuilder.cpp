@@ -8,6 +8,7 @@
 #include "controllers/highlights/HighlightController.hpp"
 #include "controllers/ignores/IgnoreController.hpp"
 #include "controllers/ignores/IgnorePhrase.hpp"
+#include "controllers/ignores/IgnorePhraseMatcher.hpp"
 #include "controllers/userdata/UserDataController.hpp"
 #include "messages/ast/Parser.hpp"
 #include "messages/Emote.hpp"
@@ -2291,7 +2292,7 @@ std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
         parseTwitchEmotes(tags, content, static_cast<int>(messageOffset));
 
     // This runs through all ignored phrases and runs its replacements on content
-    processIgnorePhrases(*getSettings()->ignoredMessages.readOnly(), content,
+    processIgnorePhrases(*IgnorePhraseMatcher::current(), content,
                          twitchEmotes);
 
     std::ranges::sort(twitchEmotes, [](const auto &a, const auto &b) {
@@ -7,60 +7,108 @@
 #include "singletons/Settings.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <vector>
 
 namespace {
 
 using namespace chatterino;
 
-float relativeSimilarity(QStringView str1, QStringView str2)
+using SizeType = QStringView::size_type;
+
+/// Characters are counted in this many buckets for the histogram bound
+constexpr size_t HISTOGRAM_BUCKETS = 64;
+using Histogram = std::array<uint32_t, HISTOGRAM_BUCKETS>;
+
+Histogram histogram(QStringView str)
+{
+    Histogram result{};
+    for (QChar c : str)
+    {
+        result[c.unicode() % HISTOGRAM_BUCKETS]++;
+    }
+    return result;
+}
+
+/// Returns an upper bound of the length of the longest common substring.
+/// A common substring can't contain a character more often than either
+/// string does.
+SizeType commonCharacters(QStringView str1, QStringView str2)
 {
-    using SizeType = QStringView::size_type;
+    auto histogram1 = histogram(str1);
+    auto histogram2 = histogram(str2);
 
-    // Longest Common Substring Problem
-    std::vector<std::vector<int>> tree(str1.size(),
-                                       std::vector<int>(str2.size(), 0));
-    int z = 0;
+    SizeType result = 0;
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+    {
+        result += std::min(histogram1[i], histogram2[i]);
+    }
+    return result;
+}
 
-    for (SizeType i = 0; i < str1.size(); ++i)
+/// Calls `cb(i, j, length)` for every diagonal of the table of the
+/// Longest Common Substring Problem. A diagonal compares
+/// `str1[i..i + length]` with `str2[j..j + length]`.
+/// Diagonals through the middle of the table are visited first.
+template <typename Callback>
+void forEachDiagonal(QStringView str1, QStringView str2, Callback &&cb)
+{
+    for (SizeType offset = 0; offset < std::max(str1.size(), str2.size());
+         offset++)
     {
-        for (SizeType j = 0; j < str2.size(); ++j)
+        if (offset < str1.size())
         {
-            if (str1[i] == str2[j])
+            auto length = std::min(str1.size() - offset, str2.size());
+            if (!cb(offset, 0, length))
             {
-                if (i == 0 || j == 0)
-                {
-                    tree[i][j] = 1;
-                }
-                else
-                {
-                    tree[i][j] = tree[i - 1][j - 1] + 1;
-                }
-                z = std::max(tree[i][j], z);
+                return;
             }
-            else
+        }
+        if (offset > 0 && offset < str2.size())
+        {
+            auto length = std::min(str2.size() - offset, str1.size());
+            if (!cb(0, offset, length))
             {
-                tree[i][j] = 0;
+                return;
             }
         }
     }
+}
 
-    // ensure that no div by 0
-    if (z == 0)
-    {
-        return 0.F;
-    }
-
-    auto div = std::max<>({static_cast<SizeType>(1), str1.size(), str2.size()});
-
-    return float(z) / float(div);
+/// Returns the length of the longest common substring of `str1` and `str2`,
+/// or any length >= `enough` once one was found.
+///
+/// Instead of filling the whole table, each diagonal is walked while counting
+/// runs of equal characters. This needs no memory and skips diagonals and
+/// their tails that are too short to beat the longest run so far.
+SizeType longestCommonSubstring(QStringView str1, QStringView str2,
+                                SizeType enough)
+{
+    SizeType best = 0;
+    forEachDiagonal(str1, str2, [&](SizeType i, SizeType j, SizeType length) {
+        SizeType run = 0;
+        for (SizeType k = 0; k < length && run + (length - k) > best; k++)
+        {
+            if (str1[i + k] == str2[j + k])
+            {
+                run++;
+                best = std::max(best, run);
+            }
+            else
+            {
+                run = 0;
+            }
+        }
+        return best < enough;
+    });
+    return best;
 }
 
 template <std::ranges::bidirectional_range T>
-float inMessages(const MessagePtr &msg, const T &messages)
+bool inMessages(const MessagePtr &msg, const T &messages, float threshold)
 {
-    float similarityPercent = 0.0F;
-
     for (const auto &prevMsg :
          messages | std::views::reverse |
              std::views::take(getSettings()->hideSimilarMaxMessagesToCheck))
@@ -75,18 +123,59 @@ float inMessages(const MessagePtr &msg, const T &messages)
         {
             continue;
         }
-        similarityPercent = std::max(
-            similarityPercent,
-            relativeSimilarity(msg->messageText, prevMsg->messageText));
+        if (isSimilar(msg->messageText, prevMsg->messageText, threshold))
+        {
+            return true;
+        }
     }
 
-    return similarityPercent;
+    return false;
 }
 
 }  // namespace
 
 namespace chatterino {
 
+float relativeSimilarity(QStringView str1, QStringView str2)
+{
+    auto z = longestCommonSubstring(
+        str1, str2, std::numeric_limits<SizeType>::max());
+
+    // ensure that no div by 0
+    if (z == 0)
+    {
+        return 0.F;
+    }
+
+    auto div = std::max<>({static_cast<SizeType>(1), str1.size(), str2.size()});
+
+    return float(z) / float(div);
+}
+
+bool isSimilar(QStringView str1, QStringView str2, float threshold)
+{
+    auto div = std::max<>({static_cast<SizeType>(1), str1.size(), str2.size()});
+    auto shorter = std::min(str1.size(), str2.size());
+
+    // The shortest common substring that passes the threshold
+    auto needed = static_cast<SizeType>(std::max(threshold * float(div), 0.F));
+    while (needed <= div && float(needed) / float(div) <= threshold)
+    {
+        needed++;
+    }
+
+    if (needed == 0)
+    {
+        return true;
+    }
+    if (needed > shorter || commonCharacters(str1, str2) < needed)
+    {
+        return false;
+    }
+
+    return longestCommonSubstring(str1, str2, needed) >= needed;
+}
+
 template <std::ranges::bidirectional_range T>
 void setSimilarityFlags(const MessagePtr &message, const T &messages)
 {
@@ -102,7 +191,7 @@ void setSimilarityFlags(const MessagePtr &message, const T &messages)
             return;
         }
 
-        if (inMessages(message, messages) > getSettings()->similarityPercentage)
+        if (inMessages(message, messages, getSettings()->similarityPercentage))
         {
             message->flags.set(MessageFlag::Similar);
             if (getSettings()->colorSimilarDisabled)
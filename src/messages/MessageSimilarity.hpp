@@ -2,9 +2,19 @@
 
 #include "messages/Message.hpp"
 
+#include <QStringView>
+
 #include <ranges>
 namespace chatterino {
 
+/// Returns the length of the longest common substring of `str1` and `str2`
+/// relative to the length of the longer string
+float relativeSimilarity(QStringView str1, QStringView str2);
+
+/// Returns true if `relativeSimilarity(str1, str2) > threshold`.
+/// Pairs that can't pass are rejected without comparing the strings.
+bool isSimilar(QStringView str1, QStringView str2, float threshold);
+
 template <std::ranges::bidirectional_range T>
 void setSimilarityFlags(const MessagePtr &message, const T &messages);
 
@@ -0,0 +1,159 @@
+#include "messages/UserMessageIndex.hpp"
+
+#include "messages/Message.hpp"
+
+#include <algorithm>
+
+namespace chatterino {
+
+void UserMessageIndex::append(const MessagePtr &message)
+{
+    for (const auto &user : usersOf(*message))
+    {
+        this->users_[user].push_back(message);
+    }
+}
+
+void UserMessageIndex::prepend(const std::vector<MessagePtr> &messages)
+{
+    for (auto it = messages.rbegin(); it != messages.rend(); ++it)
+    {
+        for (const auto &user : usersOf(**it))
+        {
+            this->users_[user].push_front(*it);
+        }
+    }
+}
+
+void UserMessageIndex::remove(const MessagePtr &message)
+{
+    for (const auto &user : usersOf(*message))
+    {
+        auto it = this->users_.find(user);
+        if (it == this->users_.end())
+        {
+            continue;
+        }
+
+        // Messages are usually removed because they were evicted from the
+        // start of the channel
+        auto &messages = it->second;
+        auto pos = std::find(messages.begin(), messages.end(), message);
+        if (pos != messages.end())
+        {
+            messages.erase(pos);
+        }
+        if (messages.empty())
+        {
+            this->users_.erase(it);
+        }
+    }
+}
+
+void UserMessageIndex::replace(const MessagePtr &message,
+                               const MessagePtr &replacement)
+{
+    auto before = usersOf(*message);
+    auto after = usersOf(*replacement);
+
+    for (const auto &user : before)
+    {
+        auto it = this->users_.find(user);
+        if (it == this->users_.end())
+        {
+            continue;
+        }
+
+        // Replaced messages are usually recent
+        auto &messages = it->second;
+        auto pos = std::find(messages.rbegin(), messages.rend(), message);
+        if (pos == messages.rend())
+        {
+            continue;
+        }
+
+        if (std::ranges::find(after, user) != after.end())
+        {
+            *pos = replacement;
+        }
+        else
+        {
+            messages.erase(std::next(pos).base());
+            if (messages.empty())
+            {
+                this->users_.erase(it);
+            }
+        }
+    }
+
+    for (const auto &user : after)
+    {
+        if (std::ranges::find(before, user) != before.end())
+        {
+            continue;
+        }
+
+        // We don't know the position in the channel, so keep the messages
+        // sorted by time
+        auto &messages = this->users_[user];
+        auto pos = std::upper_bound(
+            messages.begin(), messages.end(), replacement,
+            [](const auto &a, const auto &b) {
+                return a->serverReceivedTime < b->serverReceivedTime;
+            });
+        messages.insert(pos, replacement);
+    }
+}
+
+void UserMessageIndex::reset(const LimitedQueueSnapshot<MessagePtr> &snapshot)
+{
+    this->users_.clear();
+    for (const auto &message : snapshot)
+    {
+        this->append(message);
+    }
+}
+
+void UserMessageIndex::clear()
+{
+    this->users_.clear();
+}
+
+std::vector<MessagePtr> UserMessageIndex::find(const QString &userName) const
+{
+    auto it = this->users_.find(userName.toCaseFolded());
+    if (it == this->users_.end())
+    {
+        return {};
+    }
+    return {it->second.begin(), it->second.end()};
+}
+
+std::vector<QString> UserMessageIndex::usersOf(const Message &message)
+{
+    std::vector<QString> users;
+    auto add = [&](const QString &user) {
+        if (user.isEmpty())
+        {
+            return;
+        }
+        auto folded = user.toCaseFolded();
+        if (std::ranges::find(users, folded) == users.end())
+        {
+            users.push_back(std::move(folded));
+        }
+    };
+
+    add(message.loginName);
+    add(message.timeoutUser);
+    if (message.flags.has(MessageFlag::Subscription) &&
+        message.loginName.isEmpty())
+    {
+        // Sub notices start with the name of the user
+        add(message.messageText.section(' ', 0, 0));
+    }
+
+    return users;
+}
+
+}  // namespace chatterino
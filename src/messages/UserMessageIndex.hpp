@@ -0,0 +1,54 @@
+#pragma once
+
+#include "messages/LimitedQueueSnapshot.hpp"
+
+#include <QString>
+
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+
+/**
+ * @brief Index of the messages of a channel by the users they concern.
+ *
+ * A message concerns a user if they sent it, if it's a moderation action
+ * against them or if it's a subscription notice about them.
+ * The messages of every user are kept in channel order, so looking them up
+ * is proportional to the amount of messages of that user rather than the
+ * size of the channel.
+ *
+ * All user names are case folded.
+ */
+class UserMessageIndex
+{
+public:
+    /// Adds a message that was appended to the channel
+    void append(const MessagePtr &message);
+
+    /// Adds messages that were added to the start of the channel
+    void prepend(const std::vector<MessagePtr> &messages);
+
+    void remove(const MessagePtr &message);
+    void replace(const MessagePtr &message, const MessagePtr &replacement);
+
+    /// Makes the index contain exactly the messages in `snapshot`
+    void reset(const LimitedQueueSnapshot<MessagePtr> &snapshot);
+    void clear();
+
+    /// Returns the messages concerning `userName`, oldest first
+    std::vector<MessagePtr> find(const QString &userName) const;
+
+private:
+    /// Returns the (case folded) users `message` concerns
+    static std::vector<QString> usersOf(const Message &message);
+
+    std::unordered_map<QString, std::deque<MessagePtr>> users_;
+};
+
+}  // namespace chatterino
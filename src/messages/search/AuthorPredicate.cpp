@@ -15,10 +15,17 @@ AuthorPredicate::AuthorPredicate(const QString &authors, bool negate)
     }
 }
 
-bool AuthorPredicate::appliesToImpl(const Message &message)
+bool AuthorPredicate::appliesToImpl(const Message &message,
+                                    MessageFlags /*flags*/)
 {
     return authors_.contains(message.displayName, Qt::CaseInsensitive) ||
            authors_.contains(message.loginName, Qt::CaseInsensitive);
 }
 
+std::optional<SearchIndex::Postings> AuthorPredicate::candidatesImpl(
+    const SearchIndex &index) const
+{
+    return index.byAuthors(this->authors_);
+}
+
 }  // namespace chatterino
@@ -33,7 +33,15 @@ protected:
      * @return true if the message was authored by one of the specified users,
      *         false otherwise
      */
-    bool appliesToImpl(const Message &message) override;
+    bool appliesToImpl(const Message &message,
+                       MessageFlags flags) override;
+
+    /**
+     * @brief Looks up the messages sent by any of the users passed in the
+     *        constructor.
+     */
+    std::optional<SearchIndex::Postings> candidatesImpl(
+        const SearchIndex &index) const override;
 
 private:
     /// Holds the user names that will be searched for
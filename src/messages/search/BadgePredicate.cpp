@@ -31,7 +31,8 @@ BadgePredicate::BadgePredicate(const QString &badges, bool negate)
     }
 }
 
-bool BadgePredicate::appliesToImpl(const Message &message)
+bool BadgePredicate::appliesToImpl(const Message &message,
+                                   MessageFlags /*flags*/)
 {
     for (const Badge &badge : message.badges)
     {
@@ -44,4 +45,10 @@ bool BadgePredicate::appliesToImpl(const Message &message)
     return false;
 }
 
+std::optional<SearchIndex::Postings> BadgePredicate::candidatesImpl(
+    const SearchIndex &index) const
+{
+    return index.byBadges(this->badges_);
+}
+
 }  // namespace chatterino
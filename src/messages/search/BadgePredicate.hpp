@@ -33,7 +33,15 @@ protected:
      * @return true if the message contains a badge listed in the specified badges,
      *         false otherwise
      */
-    bool appliesToImpl(const Message &message) override;
+    bool appliesToImpl(const Message &message,
+                       MessageFlags flags) override;
+
+    /**
+     * @brief Looks up the messages with any of the badges passed in the
+     *        constructor.
+     */
+    std::optional<SearchIndex::Postings> candidatesImpl(
+        const SearchIndex &index) const override;
 
 private:
     /// Holds the badges that will be searched for
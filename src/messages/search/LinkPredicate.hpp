@@ -28,7 +28,8 @@ protected:
      * @param message the message to check
      * @return true if the message contains a link, false otherwise
      */
-    bool appliesToImpl(const Message &message) override;
+    bool appliesToImpl(const Message &message,
+                       MessageFlags flags) override;
 };
 
 }  // namespace chatterino
@@ -0,0 +1,341 @@
+#include "messages/search/LogFileIndex.hpp"
+
+#include "messages/search/LogLine.hpp"
+
+#include <QDataStream>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <mutex>
+
+namespace {
+
+using namespace chatterino;
+
+/// "C2LI"
+constexpr quint32 SIDECAR_MAGIC = 0x43324c49;
+constexpr quint32 SIDECAR_VERSION = 1;
+
+constexpr uint64_t AUTHOR_SEED = 0x9e37'79b9'7f4a'7c15;
+
+/// Finalizer of splitmix64. The keys are persisted, so we can't use qHash,
+/// which is seeded per process.
+uint64_t mix(uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xbf58'476d'1ce4'e5b9;
+    x = (x ^ (x >> 27)) * 0x94d0'49bb'1331'11eb;
+    return x ^ (x >> 31);
+}
+
+uint64_t authorKey(const QString &author)
+{
+    // FNV-1a over the UTF-16 units
+    uint64_t hash = 0xcbf2'9ce4'8422'2325;
+    for (QChar c : author.toCaseFolded())
+    {
+        hash = (hash ^ c.unicode()) * 0x0000'0100'0000'01b3;
+    }
+    return mix(hash ^ AUTHOR_SEED);
+}
+
+/// Returns the amount of bytes the sidecar at `path` indexes, or -1 if
+/// there's no valid sidecar. Only the header is read.
+qint64 storedIndexedSize(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return -1;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_15);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint64 indexedSize = 0;
+    stream >> magic >> version >> indexedSize;
+    if (stream.status() != QDataStream::Ok || magic != SIDECAR_MAGIC ||
+        version != SIDECAR_VERSION)
+    {
+        return -1;
+    }
+    return indexedSize;
+}
+
+}  // namespace
+
+namespace chatterino {
+
+QString LogFileIndex::sidecarPath(const QString &logPath)
+{
+    return logPath + QStringLiteral(".idx");
+}
+
+std::optional<LogFileIndex> LogFileIndex::load(const QString &logPath)
+{
+    QFile file(sidecarPath(logPath));
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return std::nullopt;
+    }
+
+    auto index = deserialize(file.readAll());
+    if (!index || index->indexedSize() > QFileInfo(logPath).size())
+    {
+        // The log file was replaced or truncated
+        return std::nullopt;
+    }
+    return index;
+}
+
+bool LogFileIndex::save(const QString &logPath) const
+{
+    // Log files are searched by multiple tasks at once. Checking the stored
+    // index and replacing it has to happen in one step, so an older index
+    // never replaces a newer one.
+    static std::mutex saveMutex;
+    std::lock_guard lock(saveMutex);
+
+    auto path = sidecarPath(logPath);
+    auto stored = storedIndexedSize(path);
+    if (stored >= this->indexedSize_ && stored <= QFileInfo(logPath).size())
+    {
+        // Another task already saved this or a newer index
+        return true;
+    }
+
+    // The index is written to a temporary file and renamed, so readers never
+    // see a partially written index
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+    file.write(this->serialize());
+    return file.commit();
+}
+
+QByteArray LogFileIndex::serialize() const
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_15);
+
+    stream << SIDECAR_MAGIC << SIDECAR_VERSION
+           << static_cast<qint64>(this->indexedSize_);
+
+    QStringList authors(this->authors_.begin(), this->authors_.end());
+    stream << authors;
+
+    stream << static_cast<quint32>(this->blocks_.size());
+    for (size_t i = 0; i < this->blocks_.size(); i++)
+    {
+        stream << static_cast<qint64>(this->blocks_[i].begin)
+               << static_cast<qint64>(this->blocks_[i].end);
+        for (uint64_t word : this->blooms_[i])
+        {
+            stream << static_cast<quint64>(word);
+        }
+    }
+
+    return data;
+}
+
+std::optional<LogFileIndex> LogFileIndex::deserialize(const QByteArray &data)
+{
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_15);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint64 indexedSize = 0;
+    stream >> magic >> version >> indexedSize;
+    if (magic != SIDECAR_MAGIC || version != SIDECAR_VERSION)
+    {
+        return std::nullopt;
+    }
+
+    LogFileIndex index;
+    index.indexedSize_ = static_cast<qsizetype>(indexedSize);
+
+    QStringList authors;
+    stream >> authors;
+    index.authors_.insert(authors.begin(), authors.end());
+
+    quint32 blockCount = 0;
+    stream >> blockCount;
+    for (quint32 i = 0; i < blockCount && stream.status() == QDataStream::Ok;
+         i++)
+    {
+        qint64 begin = 0;
+        qint64 end = 0;
+        stream >> begin >> end;
+        index.blocks_.push_back({
+            .begin = static_cast<qsizetype>(begin),
+            .end = static_cast<qsizetype>(end),
+        });
+
+        auto &bloom = index.blooms_.emplace_back();
+        for (auto &word : bloom)
+        {
+            quint64 value = 0;
+            stream >> value;
+            word = value;
+        }
+    }
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        return std::nullopt;
+    }
+    return index;
+}
+
+bool LogFileIndex::extend(const QByteArray &data)
+{
+    auto end = data.lastIndexOf('\n') + 1;
+    if (end <= this->indexedSize_)
+    {
+        return false;
+    }
+
+    // Bloom filters can always take more keys, so a block that isn't full
+    // yet is continued
+    bool continueBlock = !this->blocks_.empty() &&
+                         this->blocks_.back().end - this->blocks_.back().begin <
+                             BLOCK_SIZE;
+
+    auto pos = this->indexedSize_;
+    while (pos < end)
+    {
+        if (!continueBlock)
+        {
+            this->blocks_.push_back({.begin = pos, .end = pos});
+            this->blooms_.emplace_back();
+        }
+        auto &block = this->blocks_.back();
+        auto &bloom = this->blooms_.back();
+
+        auto lineEnd = data.indexOf('\n', pos);
+        auto length = lineEnd - pos;
+        if (length > 0 && data[lineEnd - 1] == '\r')
+        {
+            length--;
+        }
+
+        auto line = parseLogLine(
+            QString::fromUtf8(data.constData() + pos, length));
+        if (line)
+        {
+            forEachTrigram(line->searchText, [&](uint64_t trigram) {
+                addKey(bloom, mix(trigram));
+            });
+
+            for (const auto *author : {&line->loginName, &line->localizedName})
+            {
+                if (!author->isEmpty())
+                {
+                    addKey(bloom, authorKey(*author));
+                    this->authors_.insert(author->toCaseFolded());
+                }
+            }
+        }
+
+        pos = lineEnd + 1;
+        block.end = pos;
+        continueBlock = block.end - block.begin < BLOCK_SIZE;
+    }
+
+    this->indexedSize_ = end;
+    return true;
+}
+
+qsizetype LogFileIndex::indexedSize() const
+{
+    return this->indexedSize_;
+}
+
+const std::vector<LogFileIndex::Block> &LogFileIndex::blocks() const
+{
+    return this->blocks_;
+}
+
+std::optional<SearchIndex::Postings> LogFileIndex::byAuthors(
+    const QStringList &authors) const
+{
+    Postings result;
+    for (const auto &author : authors)
+    {
+        if (this->authors_.contains(author.toCaseFolded()))
+        {
+            result = unite(result, this->blocksContaining({authorKey(author)}));
+        }
+    }
+    return result;
+}
+
+std::optional<SearchIndex::Postings> LogFileIndex::byBadges(
+    const QStringList & /*badges*/) const
+{
+    // Badges aren't logged
+    return std::nullopt;
+}
+
+std::optional<SearchIndex::Postings> LogFileIndex::bySubstring(
+    const QString &text) const
+{
+    if (!hasTrigrams(text))
+    {
+        return std::nullopt;
+    }
+
+    std::vector<uint64_t> keys;
+    forEachTrigram(text, [&](uint64_t trigram) {
+        keys.push_back(mix(trigram));
+    });
+    return this->blocksContaining(keys);
+}
+
+void LogFileIndex::addKey(Bloom &bloom, uint64_t key)
+{
+    constexpr uint64_t bits = BLOOM_WORDS * 64;
+    for (uint64_t bit : {key % bits, (key >> 32) % bits})
+    {
+        bloom[bit / 64] |= uint64_t{1} << (bit % 64);
+    }
+}
+
+bool LogFileIndex::mightContain(const Bloom &bloom, uint64_t key)
+{
+    constexpr uint64_t bits = BLOOM_WORDS * 64;
+    for (uint64_t bit : {key % bits, (key >> 32) % bits})
+    {
+        if ((bloom[bit / 64] & (uint64_t{1} << (bit % 64))) == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+SearchIndex::Postings LogFileIndex::blocksContaining(
+    const std::vector<uint64_t> &keys) const
+{
+    Postings result;
+    for (uint32_t i = 0; i < this->blooms_.size(); i++)
+    {
+        const auto &bloom = this->blooms_[i];
+        if (std::all_of(keys.begin(), keys.end(), [&](uint64_t key) {
+                return mightContain(bloom, key);
+            }))
+        {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+}  // namespace chatterino
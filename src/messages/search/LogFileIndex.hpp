@@ -0,0 +1,87 @@
+#pragma once
+
+#include "messages/search/SearchIndex.hpp"
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+namespace chatterino {
+
+/**
+ * @brief Sidecar index of a log file written by LoggingChannel.
+ *
+ * The file is split into blocks of whole lines. Every block has a bloom
+ * filter over the case folded authors and the trigrams of the `searchText` of
+ * its lines. The ids handed out by the lookups are block indices.
+ *
+ * Log files only ever grow, so the index can be extended with the lines that
+ * were appended since it was built. It's stored next to the log file as
+ * `<file>.idx`.
+ */
+class LogFileIndex : public SearchIndex
+{
+public:
+    /// Blocks are closed once they contain at least this many bytes
+    static constexpr qsizetype BLOCK_SIZE = 32 * 1024;
+
+    struct Block {
+        /// Byte offset of the first line
+        qsizetype begin = 0;
+        /// Byte offset past the line break of the last line
+        qsizetype end = 0;
+    };
+
+    /// Returns the path of the sidecar index of `logPath`
+    static QString sidecarPath(const QString &logPath);
+
+    /// Loads the sidecar index of `logPath`. Returns std::nullopt if there's
+    /// none or it's outdated.
+    static std::optional<LogFileIndex> load(const QString &logPath);
+
+    /// Atomically replaces the sidecar of `logPath` with this index, unless
+    /// the stored index already covers as much of the log file. This may be
+    /// called from multiple threads.
+    bool save(const QString &logPath) const;
+
+    QByteArray serialize() const;
+    static std::optional<LogFileIndex> deserialize(const QByteArray &data);
+
+    /// Indexes the complete lines of `data` (the contents of the log file)
+    /// that aren't indexed yet. Returns true if any lines were added.
+    bool extend(const QByteArray &data);
+
+    /// Returns the amount of bytes of the log file that are indexed
+    qsizetype indexedSize() const;
+
+    const std::vector<Block> &blocks() const;
+
+    std::optional<Postings> byAuthors(
+        const QStringList &authors) const override;
+    std::optional<Postings> byBadges(const QStringList &badges) const override;
+    std::optional<Postings> bySubstring(const QString &text) const override;
+
+private:
+    static constexpr size_t BLOOM_WORDS = 256;
+    using Bloom = std::array<uint64_t, BLOOM_WORDS>;
+
+    static void addKey(Bloom &bloom, uint64_t key);
+    static bool mightContain(const Bloom &bloom, uint64_t key);
+
+    /// Returns the blocks whose bloom filters contain all `keys`
+    Postings blocksContaining(const std::vector<uint64_t> &keys) const;
+
+    qsizetype indexedSize_ = 0;
+    std::vector<Block> blocks_;
+    std::vector<Bloom> blooms_;
+    /// Case folded names of everyone who sent a message in this file
+    std::unordered_set<QString> authors_;
+};
+
+}  // namespace chatterino
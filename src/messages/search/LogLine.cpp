@@ -0,0 +1,77 @@
+#include "messages/search/LogLine.hpp"
+
+#include <algorithm>
+
+namespace {
+
+/// Length of "[HH:mm:ss] "
+constexpr qsizetype TIMESTAMP_LENGTH = 11;
+
+bool isLoginName(QStringView text)
+{
+    return !text.isEmpty() &&
+           std::all_of(text.begin(), text.end(), [](QChar c) {
+               return (c >= u'a' && c <= u'z') || (c >= u'0' && c <= u'9') ||
+                      c == u'_';
+           });
+}
+
+}  // namespace
+
+namespace chatterino {
+
+std::optional<LogLine> parseLogLine(QStringView line)
+{
+    LogLine result;
+
+    // Logs of /mentions and /automod prefix every message with its channel
+    if (line.startsWith(u'#'))
+    {
+        auto space = line.indexOf(u' ');
+        if (space <= 1)
+        {
+            return std::nullopt;
+        }
+        result.channelName = line.mid(1, space - 1).toString();
+        line = line.mid(space + 1);
+    }
+
+    if (line.size() < TIMESTAMP_LENGTH || line[0] != u'[' ||
+        line[9] != u']' || line[10] != u' ')
+    {
+        return std::nullopt;
+    }
+
+    result.time = QTime::fromString(line.mid(1, 8).toString(), "HH:mm:ss");
+    if (!result.time.isValid())
+    {
+        return std::nullopt;
+    }
+
+    auto text = line.mid(TIMESTAMP_LENGTH);
+    result.searchText = text.toString();
+
+    // User messages are "login: text" or "localized login: text", anything
+    // else was logged from a system message
+    auto colon = text.indexOf(u": ");
+    if (colon > 0)
+    {
+        auto author = text.left(colon);
+        auto space = author.indexOf(u' ');
+        auto login = space < 0 ? author : author.mid(space + 1);
+        auto localized = space < 0 ? QStringView() : author.left(space);
+
+        if (isLoginName(login) && (space < 0 || !localized.isEmpty()))
+        {
+            result.loginName = login.toString();
+            result.localizedName = localized.toString();
+            result.messageText = text.mid(colon + 2).toString();
+            return result;
+        }
+    }
+
+    result.messageText = result.searchText;
+    return result;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <QString>
+#include <QStringView>
+#include <QTime>
+
+#include <optional>
+
+namespace chatterino {
+
+/// A message as it's written to a log file by LoggingChannel
+struct LogLine {
+    /// The channel the message was sent in. This is only part of the line in
+    /// logs of special channels like /mentions.
+    QString channelName;
+    QTime time;
+
+    /// Empty for system messages
+    QString loginName;
+    QString localizedName;
+    QString messageText;
+
+    /// Everything after the timestamp. Searches match against this, just like
+    /// they match against Message::searchText.
+    QString searchText;
+};
+
+/// Parses a single line (without the line break) of a log file.
+/// Returns std::nullopt for lines that aren't messages, like the
+/// "# Start logging at ..." markers.
+std::optional<LogLine> parseLogLine(QStringView line);
+
+}  // namespace chatterino
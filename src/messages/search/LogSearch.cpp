@@ -0,0 +1,222 @@
+#include "messages/search/LogSearch.hpp"
+
+#include "messages/Message.hpp"
+#include "messages/MessageBuilder.hpp"
+#include "messages/MessageElement.hpp"
+#include "messages/search/LogFileIndex.hpp"
+#include "messages/search/PredicateParser.hpp"
+#include "singletons/Fonts.hpp"
+#include "util/CancellationToken.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+using namespace chatterino;
+
+/// Length of "yyyy-MM-dd"
+constexpr qsizetype DATE_LENGTH = 10;
+
+/// Log files are named `<channel>-<yyyy-MM-dd>.log` or
+/// `<channel>-<stream id>.log`
+LogSearchResult describeFile(const QFileInfo &info)
+{
+    LogSearchResult result;
+
+    auto name = info.completeBaseName();
+    auto date = QDate::fromString(name.right(DATE_LENGTH), "yyyy-MM-dd");
+    if (date.isValid())
+    {
+        result.date = date;
+        result.channelName = name.chopped(DATE_LENGTH + 1);
+    }
+    else
+    {
+        result.date = info.lastModified().date();
+        result.channelName = name.left(name.lastIndexOf('-'));
+    }
+
+    return result;
+}
+
+void assignProbe(Message &probe, const LogSearchResult &file,
+                 const LogLine &line)
+{
+    probe.channelName =
+        line.channelName.isEmpty() ? file.channelName : line.channelName;
+    probe.loginName = line.loginName;
+    probe.localizedName = line.localizedName;
+    probe.displayName =
+        line.localizedName.isEmpty() ? line.loginName : line.localizedName;
+    probe.messageText = line.messageText;
+    probe.searchText = line.searchText;
+    probe.serverReceivedTime = QDateTime(file.date, line.time);
+    probe.flags = {};
+    if (line.loginName.isEmpty())
+    {
+        probe.flags.set(MessageFlag::System);
+    }
+}
+
+}  // namespace
+
+namespace chatterino {
+
+QStringList findLogFiles(const QString &directory)
+{
+    QStringList files;
+    const auto entries =
+        QDir(directory).entryInfoList({"*.log"}, QDir::Files,
+                                      QDir::Time | QDir::Reversed);
+    for (const auto &entry : entries)
+    {
+        files.append(entry.absoluteFilePath());
+    }
+    return files;
+}
+
+std::vector<LogSearchResult> searchLogFile(const QString &path,
+                                           const QString &query,
+                                           const CancellationToken &token)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly) || file.size() == 0)
+    {
+        return {};
+    }
+
+    // The mapping is released when `file` is closed
+    QByteArray data;
+    if (auto *mapped = file.map(0, file.size()))
+    {
+        data = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped),
+                                       static_cast<qsizetype>(file.size()));
+    }
+    else
+    {
+        data = file.readAll();
+    }
+
+    auto index = LogFileIndex::load(path).value_or(LogFileIndex{});
+    if (index.extend(data))
+    {
+        index.save(path);
+    }
+
+    auto predicates = parsePredicates(query);
+
+    std::optional<SearchIndex::Postings> blocks;
+    for (const auto &predicate : predicates)
+    {
+        auto candidates = predicate->candidates(index);
+        if (!candidates)
+        {
+            continue;
+        }
+        blocks = blocks ? SearchIndex::intersect(*blocks, *candidates)
+                        : std::move(*candidates);
+    }
+    if (!blocks)
+    {
+        blocks.emplace(index.blocks().size());
+        std::iota(blocks->begin(), blocks->end(), 0);
+    }
+
+    auto fileInfo = describeFile(QFileInfo(path));
+    std::vector<LogSearchResult> results;
+    Message probe;
+
+    for (auto id : *blocks)
+    {
+        if (token.isCancelled())
+        {
+            return {};
+        }
+
+        const auto &block = index.blocks()[id];
+        auto pos = block.begin;
+        while (pos < block.end)
+        {
+            auto lineEnd = data.indexOf('\n', pos);
+            auto length = lineEnd - pos;
+            if (length > 0 && data[lineEnd - 1] == '\r')
+            {
+                length--;
+            }
+
+            auto line = parseLogLine(
+                QString::fromUtf8(data.constData() + pos, length));
+            pos = lineEnd + 1;
+            if (!line)
+            {
+                continue;
+            }
+
+            assignProbe(probe, fileInfo, *line);
+            bool accept = std::all_of(
+                predicates.begin(), predicates.end(),
+                [&](const auto &predicate) {
+                    return predicate->appliesTo(probe, probe.flags);
+                });
+            if (accept)
+            {
+                results.push_back({
+                    .channelName = probe.channelName,
+                    .date = fileInfo.date,
+                    .line = std::move(*line),
+                });
+            }
+        }
+    }
+
+    return results;
+}
+
+MessagePtr makeLogMessage(const LogSearchResult &result)
+{
+    const auto &line = result.line;
+
+    MessageBuilder builder;
+    builder.emplace<TimestampElement>(line.time);
+    builder.emplace<TextElement>(
+        result.date.toString(Qt::ISODate) + " #" + result.channelName,
+        MessageElementFlag::Text, MessageColor::System);
+
+    if (!line.loginName.isEmpty())
+    {
+        auto name =
+            line.localizedName.isEmpty()
+                ? line.loginName
+                : line.localizedName + "(" + line.loginName + ")";
+        builder.emplace<TextElement>(name + ":", MessageElementFlag::Username,
+                                     MessageColor::Text,
+                                     FontStyle::ChatMediumBold);
+    }
+    builder.emplace<TextElement>(line.messageText, MessageElementFlag::Text,
+                                 line.loginName.isEmpty() ? MessageColor::System
+                                                          : MessageColor::Text);
+
+    auto &message = builder.message();
+    message.flags.set(MessageFlag::DoNotLog);
+    if (line.loginName.isEmpty())
+    {
+        message.flags.set(MessageFlag::System);
+    }
+    message.channelName = result.channelName;
+    message.loginName = line.loginName;
+    message.localizedName = line.localizedName;
+    message.displayName =
+        line.localizedName.isEmpty() ? line.loginName : line.localizedName;
+    message.messageText = line.messageText;
+    message.searchText = line.searchText;
+    message.serverReceivedTime = QDateTime(result.date, line.time);
+
+    return builder.release();
+}
+
+}  // namespace chatterino
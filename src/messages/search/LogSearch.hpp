@@ -0,0 +1,51 @@
+#pragma once
+
+#include "messages/search/LogLine.hpp"
+
+#include <QDate>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+class CancellationToken;
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+
+/// A message found in a log file
+struct LogSearchResult {
+    /// The channel of the log file, overridden by the channel of the line
+    QString channelName;
+    QDate date;
+    LogLine line;
+};
+
+/// Returns the log files in `directory`, oldest first
+QStringList findLogFiles(const QString &directory);
+
+/**
+ * @brief Searches a log file written by LoggingChannel.
+ *
+ * The file is memory mapped and only the blocks that its sidecar index (see
+ * LogFileIndex) can't rule out are scanned. The sidecar is created or
+ * extended if it doesn't cover the whole file.
+ *
+ * This can be called from any thread.
+ *
+ * @param path the path of the log file
+ * @param query the search query, see parsePredicates
+ * @param token stops the search early once cancelled
+ * @return the matching messages in the order they were logged
+ */
+std::vector<LogSearchResult> searchLogFile(const QString &path,
+                                           const QString &query,
+                                           const CancellationToken &token);
+
+/// Builds the message to display `result` with.
+/// This must be called from the GUI thread.
+MessagePtr makeLogMessage(const LogSearchResult &result);
+
+}  // namespace chatterino
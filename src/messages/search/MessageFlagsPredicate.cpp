@@ -65,16 +65,16 @@ MessageFlagsPredicate::MessageFlagsPredicate(const QString &flags, bool negate)
     }
 }
 
-bool MessageFlagsPredicate::appliesToImpl(const Message &message)
+bool MessageFlagsPredicate::appliesToImpl(const Message & /*message*/,
+                                          MessageFlags flags)
 {
     // Exclude timeout messages from system flag when timeout flag isn't present
     if (this->flags_.has(MessageFlag::System) &&
         !this->flags_.has(MessageFlag::Timeout))
     {
-        return message.flags.hasAny(flags_) &&
-               !message.flags.has(MessageFlag::Timeout);
+        return flags.hasAny(flags_) && !flags.has(MessageFlag::Timeout);
     }
-    return message.flags.hasAny(flags_);
+    return flags.hasAny(flags_);
 }
 
 }  // namespace chatterino
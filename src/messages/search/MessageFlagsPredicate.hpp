@@ -38,10 +38,12 @@ protected:
      *        in the constructor.
      *
      * @param message the message to check
+     * @param flags the flags of the message
      * @return true if the message has at least one of the specified flags,
      *         false otherwise
      */
-    bool appliesToImpl(const Message &message) override;
+    bool appliesToImpl(const Message &message,
+                       MessageFlags flags) override;
 
 private:
     /// Holds the flags that will be searched for
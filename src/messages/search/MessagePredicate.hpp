@@ -1,6 +1,10 @@
 #pragma once
 
+#include "messages/MessageFlag.hpp"
+#include "messages/search/SearchIndex.hpp"
+
 #include <memory>
+#include <optional>
 
 namespace chatterino {
 
@@ -25,12 +29,16 @@ public:
      * Calls the derived classes `appliedTo` implementation, and respects the `isNegated_` flag
      * it's set.
      *
+     * The flags are passed separately, since the GUI thread changes them
+     * (e.g. when a user is timed out) while other threads search the message.
+     *
      * @param message the message to check for this predicate
+     * @param flags the flags of the message, read on the GUI thread
      * @return true if this predicate applies, false otherwise
      **/
-    bool appliesTo(const Message &message)
+    bool appliesTo(const Message &message, MessageFlags flags)
     {
-        auto result = this->appliesToImpl(message);
+        auto result = this->appliesToImpl(message, flags);
         if (this->isNegated_)
         {
             return !result;
@@ -38,6 +46,25 @@ public:
         return result;
     }
 
+    /**
+     * @brief Looks up the messages this predicate might apply to
+     *
+     * Negated predicates can't be looked up.
+     *
+     * @param index the index of the messages to search in
+     * @return a superset of the messages this predicate applies to, or
+     *         std::nullopt if the index can't narrow them down
+     **/
+    std::optional<SearchIndex::Postings> candidates(
+        const SearchIndex &index) const
+    {
+        if (this->isNegated_)
+        {
+            return std::nullopt;
+        }
+        return this->candidatesImpl(index);
+    }
+
 protected:
     explicit MessagePredicate(bool negate)
         : isNegated_(negate)
@@ -51,9 +78,26 @@ protected:
      * in order to be compatible with other MessagePredicates.
      *
      * @param message the message to check for this predicate
+     * @param flags the flags of the message, don't read `message.flags`
      * @return true if this predicate applies, false otherwise
      */
-    virtual bool appliesToImpl(const Message &message) = 0;
+    virtual bool appliesToImpl(const Message &message, MessageFlags flags) = 0;
+
+    /**
+     * @brief Looks up the messages this predicate might apply to.
+     *
+     * Predicates that can't be answered by the index don't need to override
+     * this.
+     *
+     * @param index the index of the messages to search in
+     * @return a superset of the messages this predicate applies to, or
+     *         std::nullopt if the index can't narrow them down
+     */
+    virtual std::optional<SearchIndex::Postings> candidatesImpl(
+        const SearchIndex & /*index*/) const
+    {
+        return std::nullopt;
+    }
 
 private:
     const bool isNegated_ = false;
@@ -0,0 +1,247 @@
+#include "messages/search/MessageSearchIndex.hpp"
+
+#include "messages/Message.hpp"
+#include "providers/twitch/TwitchBadge.hpp"
+
+#include <algorithm>
+
+namespace {
+
+using namespace chatterino;
+
+QString foldKey(const QString &key)
+{
+    return key.toCaseFolded();
+}
+
+void addPosting(MessageSearchIndex::Postings &postings, uint32_t id)
+{
+    // Ids are handed out in increasing order, so appending keeps the postings
+    // sorted. A key might occur multiple times in the same message.
+    if (postings.empty() || postings.back() != id)
+    {
+        postings.push_back(id);
+    }
+}
+
+}  // namespace
+
+namespace chatterino {
+
+bool MessageSearchIndex::isActive() const
+{
+    return this->active_;
+}
+
+void MessageSearchIndex::sync(const LimitedQueueSnapshot<MessagePtr> &snapshot)
+{
+    this->active_ = true;
+
+    std::unordered_set<const Message *> current;
+    current.reserve(snapshot.size());
+    for (const auto &message : snapshot)
+    {
+        current.insert(message.get());
+        this->add(*message);
+    }
+
+    std::vector<const Message *> removed;
+    for (const auto &[message, id] : this->ids_)
+    {
+        if (!current.contains(message))
+        {
+            removed.push_back(message);
+        }
+    }
+    for (const auto *message : removed)
+    {
+        this->remove(*message);
+    }
+}
+
+void MessageSearchIndex::add(const Message &message)
+{
+    if (!this->active_ || this->ids_.contains(&message))
+    {
+        return;
+    }
+
+    auto id = this->nextId_++;
+    this->ids_.emplace(&message, id);
+    this->messages_.emplace(id, &message);
+
+    for (const auto *name : {&message.loginName, &message.displayName})
+    {
+        if (!name->isEmpty())
+        {
+            addPosting(this->authors_[foldKey(*name)], id);
+        }
+    }
+
+    for (const auto &badge : message.badges)
+    {
+        addPosting(this->badges_[foldKey(badge.key_)], id);
+    }
+
+    forEachTrigram(message.searchText, [&](uint64_t trigram) {
+        addPosting(this->trigrams_[trigram], id);
+    });
+}
+
+void MessageSearchIndex::remove(const Message &message)
+{
+    auto it = this->ids_.find(&message);
+    if (it == this->ids_.end())
+    {
+        return;
+    }
+
+    // The postings are cleaned up lazily, resolve() skips ids of removed
+    // messages until then
+    this->messages_.erase(it->second);
+    this->ids_.erase(it);
+    this->removedIds_++;
+    this->removals_++;
+
+    if (this->removedIds_ > this->ids_.size())
+    {
+        this->compact();
+    }
+}
+
+void MessageSearchIndex::clear()
+{
+    this->removals_ += this->ids_.size();
+    this->ids_.clear();
+    this->messages_.clear();
+    this->removedIds_ = 0;
+    this->authors_.clear();
+    this->badges_.clear();
+    this->trigrams_.clear();
+}
+
+size_t MessageSearchIndex::size() const
+{
+    return this->ids_.size();
+}
+
+bool MessageSearchIndex::contains(const Message &message) const
+{
+    return this->ids_.contains(&message);
+}
+
+uint64_t MessageSearchIndex::removals() const
+{
+    return this->removals_;
+}
+
+std::optional<MessageSearchIndex::Postings> MessageSearchIndex::byAuthors(
+    const QStringList &authors) const
+{
+    Postings result;
+    for (const auto &author : authors)
+    {
+        auto it = this->authors_.find(foldKey(author));
+        if (it != this->authors_.end())
+        {
+            result = unite(result, it->second);
+        }
+    }
+    return result;
+}
+
+std::optional<MessageSearchIndex::Postings> MessageSearchIndex::byBadges(
+    const QStringList &badges) const
+{
+    Postings result;
+    for (const auto &badge : badges)
+    {
+        auto it = this->badges_.find(foldKey(badge));
+        if (it != this->badges_.end())
+        {
+            result = unite(result, it->second);
+        }
+    }
+    return result;
+}
+
+std::optional<MessageSearchIndex::Postings> MessageSearchIndex::bySubstring(
+    const QString &text) const
+{
+    if (!hasTrigrams(text))
+    {
+        return std::nullopt;
+    }
+
+    std::vector<const Postings *> lists;
+    bool missing = false;
+    forEachTrigram(text, [&](uint64_t trigram) {
+        auto it = this->trigrams_.find(trigram);
+        if (it == this->trigrams_.end())
+        {
+            missing = true;
+            return;
+        }
+        lists.push_back(&it->second);
+    });
+    if (missing)
+    {
+        return Postings{};
+    }
+
+    // Start with the rarest trigram to keep the intermediate results small
+    std::sort(lists.begin(), lists.end(), [](const auto *a, const auto *b) {
+        return a->size() < b->size();
+    });
+
+    Postings result = *lists.front();
+    for (size_t i = 1; i < lists.size() && !result.empty(); i++)
+    {
+        result = intersect(result, *lists[i]);
+    }
+    return result;
+}
+
+std::unordered_set<const Message *> MessageSearchIndex::resolve(
+    const Postings &postings) const
+{
+    std::unordered_set<const Message *> result;
+    result.reserve(postings.size());
+    for (auto id : postings)
+    {
+        auto it = this->messages_.find(id);
+        if (it != this->messages_.end())
+        {
+            result.insert(it->second);
+        }
+    }
+    return result;
+}
+
+void MessageSearchIndex::compact()
+{
+    auto isRemoved = [this](uint32_t id) {
+        return !this->messages_.contains(id);
+    };
+    auto compactMap = [&](auto &map) {
+        for (auto it = map.begin(); it != map.end();)
+        {
+            std::erase_if(it->second, isRemoved);
+            if (it->second.empty())
+            {
+                it = map.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    };
+
+    compactMap(this->authors_);
+    compactMap(this->badges_);
+    compactMap(this->trigrams_);
+    this->removedIds_ = 0;
+}
+
+}  // namespace chatterino
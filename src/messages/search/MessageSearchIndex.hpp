@@ -0,0 +1,82 @@
+#pragma once
+
+#include "messages/LimitedQueueSnapshot.hpp"
+#include "messages/search/SearchIndex.hpp"
+
+#include <QString>
+#include <QStringList>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace chatterino {
+
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+
+/**
+ * @brief Inverted index over the messages of a channel.
+ *
+ * Messages are indexed by their author (login and display name), their
+ * badges and the trigrams of their `searchText`. All keys are case folded.
+ *
+ * The index is inactive until sync() is called for the first time. Until
+ * then, add() and remove() are no-ops, so channels that are never searched
+ * don't pay for the index.
+ *
+ * Queries return a superset of the matching messages. The predicates still
+ * have to be checked on every candidate.
+ */
+class MessageSearchIndex : public SearchIndex
+{
+public:
+    bool isActive() const;
+
+    /// Makes the index contain exactly the messages in `snapshot` and
+    /// activates it
+    void sync(const LimitedQueueSnapshot<MessagePtr> &snapshot);
+
+    void add(const Message &message);
+    void remove(const Message &message);
+    void clear();
+
+    /// Returns the number of indexed messages
+    size_t size() const;
+
+    bool contains(const Message &message) const;
+
+    /// Returns how many messages were removed from this index so far.
+    /// This can be used to tell if a set of messages is still indexed.
+    uint64_t removals() const;
+
+    std::optional<Postings> byAuthors(
+        const QStringList &authors) const override;
+    std::optional<Postings> byBadges(const QStringList &badges) const override;
+    std::optional<Postings> bySubstring(const QString &text) const override;
+
+    /// Returns the messages referred to by `postings`
+    std::unordered_set<const Message *> resolve(const Postings &postings) const;
+
+private:
+    /// Drops the ids of removed messages from all postings
+    void compact();
+
+    bool active_ = false;
+
+    uint32_t nextId_ = 0;
+    std::unordered_map<const Message *, uint32_t> ids_;
+    std::unordered_map<uint32_t, const Message *> messages_;
+    /// Amount of ids in the postings that refer to removed messages
+    size_t removedIds_ = 0;
+    uint64_t removals_ = 0;
+
+    std::unordered_map<QString, Postings> authors_;
+    std::unordered_map<QString, Postings> badges_;
+    std::unordered_map<uint64_t, Postings> trigrams_;
+};
+
+}  // namespace chatterino
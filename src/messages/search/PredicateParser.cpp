@@ -0,0 +1,87 @@
+#include "messages/search/PredicateParser.hpp"
+
+#include "messages/search/AuthorPredicate.hpp"
+#include "messages/search/BadgePredicate.hpp"
+#include "messages/search/ChannelPredicate.hpp"
+#include "messages/search/LinkPredicate.hpp"
+#include "messages/search/MessageFlagsPredicate.hpp"
+#include "messages/search/RegexPredicate.hpp"
+#include "messages/search/SubstringPredicate.hpp"
+#include "messages/search/SubtierPredicate.hpp"
+
+#include <QRegularExpression>
+
+namespace chatterino {
+
+std::vector<std::unique_ptr<MessagePredicate>> parsePredicates(
+    const QString &input)
+{
+    // This regex captures all name:value predicate pairs into named capturing
+    // groups and matches all other inputs seperated by spaces as normal
+    // strings.
+    // It also ignores whitespaces in values when being surrounded by quotation
+    // marks, to enable inputs like this => regex:"kappa 123"
+    static QRegularExpression predicateRegex(
+        R"lit((?<negation>[!\-])?(?:(?<name>\w+):(?<value>".+?"|[^\s]+))|[^\s]+?(?=$|\s))lit");
+    static QRegularExpression trimQuotationMarksRegex(R"(^"|"$)");
+
+    QRegularExpressionMatchIterator it = predicateRegex.globalMatch(input);
+
+    std::vector<std::unique_ptr<MessagePredicate>> predicates;
+
+    while (it.hasNext())
+    {
+        QRegularExpressionMatch match = it.next();
+
+        QString name = match.captured("name");
+        bool isNegated = !match.captured("negation").isEmpty();
+        QString value = match.captured("value");
+        value.remove(trimQuotationMarksRegex);
+
+        // match predicates
+
+        if (name == "from")
+        {
+            predicates.push_back(
+                std::make_unique<AuthorPredicate>(value, isNegated));
+        }
+        else if (name == "badge")
+        {
+            predicates.push_back(
+                std::make_unique<BadgePredicate>(value, isNegated));
+        }
+        else if (name == "subtier")
+        {
+            predicates.push_back(
+                std::make_unique<SubtierPredicate>(value, isNegated));
+        }
+        else if (name == "has" && value == "link")
+        {
+            predicates.push_back(std::make_unique<LinkPredicate>(isNegated));
+        }
+        else if (name == "in")
+        {
+            predicates.push_back(
+                std::make_unique<ChannelPredicate>(value, isNegated));
+        }
+        else if (name == "is")
+        {
+            predicates.push_back(
+                std::make_unique<MessageFlagsPredicate>(value, isNegated));
+        }
+        else if (name == "regex")
+        {
+            predicates.push_back(
+                std::make_unique<RegexPredicate>(value, isNegated));
+        }
+        else
+        {
+            predicates.push_back(
+                std::make_unique<SubstringPredicate>(match.captured()));
+        }
+    }
+
+    return predicates;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "messages/search/MessagePredicate.hpp"
+
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+/**
+ * @brief Checks the input for tags and registers their corresponding
+ *        predicates.
+ *
+ * @param input the string to check for tags
+ * @return a vector of MessagePredicates requested in the input
+ */
+std::vector<std::unique_ptr<MessagePredicate>> parsePredicates(
+    const QString &input);
+
+}  // namespace chatterino
@@ -10,7 +10,8 @@ RegexPredicate::RegexPredicate(const QString &regex, bool negate)
 {
 }
 
-bool RegexPredicate::appliesToImpl(const Message &message)
+bool RegexPredicate::appliesToImpl(const Message &message,
+                                   MessageFlags /*flags*/)
 {
     if (!regex_.isValid())
     {
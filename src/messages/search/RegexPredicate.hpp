@@ -36,7 +36,8 @@ protected:
      * @param message the message to check
      * @return true if the message matches the regex, false otherwise
      */
-    bool appliesToImpl(const Message &message) override;
+    bool appliesToImpl(const Message &message,
+                       MessageFlags flags) override;
 
 private:
     /// Holds the regular expression to match the message against
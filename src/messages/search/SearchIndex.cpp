@@ -0,0 +1,34 @@
+#include "messages/search/SearchIndex.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace chatterino {
+
+SearchIndex::Postings SearchIndex::intersect(const Postings &a,
+                                             const Postings &b)
+{
+    Postings result;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                          std::back_inserter(result));
+    return result;
+}
+
+SearchIndex::Postings SearchIndex::unite(const Postings &a, const Postings &b)
+{
+    Postings result;
+    result.reserve(a.size() + b.size());
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                   std::back_inserter(result));
+    return result;
+}
+
+bool SearchIndex::hasTrigrams(const QString &text)
+{
+    return text.size() >= TRIGRAM_LENGTH &&
+           std::none_of(text.begin(), text.end(), [](QChar c) {
+               return c.isSurrogate();
+           });
+}
+
+}  // namespace chatterino
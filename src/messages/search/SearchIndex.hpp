@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace chatterino {
+
+/**
+ * @brief Interface of indices that MessagePredicates can be looked up in.
+ *
+ * An index hands out ids for the things it indexes (e.g. messages or blocks
+ * of a log file). Lookups return a superset of the ids a predicate applies
+ * to, or std::nullopt if the index can't answer the lookup.
+ */
+class SearchIndex
+{
+public:
+    /// Sorted ids
+    using Postings = std::vector<uint32_t>;
+
+    virtual ~SearchIndex() = default;
+
+    /// Returns the ids of messages sent by any of `authors`
+    virtual std::optional<Postings> byAuthors(
+        const QStringList &authors) const = 0;
+
+    /// Returns the ids of messages with any of the `badges`
+    virtual std::optional<Postings> byBadges(
+        const QStringList &badges) const = 0;
+
+    /// Returns the ids of messages whose `searchText` might contain `text`
+    /// (case-insensitive)
+    virtual std::optional<Postings> bySubstring(const QString &text) const = 0;
+
+    static Postings intersect(const Postings &a, const Postings &b);
+    static Postings unite(const Postings &a, const Postings &b);
+
+protected:
+    static constexpr qsizetype TRIGRAM_LENGTH = 3;
+
+    /// Returns true if `text` can be looked up by its trigrams.
+    /// Text that's too short or contains characters outside the BMP (which
+    /// QString::contains folds as a whole) can't be looked up.
+    static bool hasTrigrams(const QString &text);
+
+    /// Calls `cb` with every trigram of `text`, case folded per UTF-16 unit
+    /// like QString::contains with Qt::CaseInsensitive does
+    template <typename Callback>
+    static void forEachTrigram(const QString &text, Callback &&cb)
+    {
+        if (text.size() < TRIGRAM_LENGTH)
+        {
+            return;
+        }
+
+        auto fold = [](QChar c) -> uint64_t {
+            return c.toCaseFolded().unicode();
+        };
+
+        uint64_t key = (fold(text[0]) << 16) | fold(text[1]);
+        for (qsizetype i = TRIGRAM_LENGTH - 1; i < text.size(); i++)
+        {
+            key = ((key << 16) | fold(text[i])) & 0xffff'ffff'ffff;
+            cb(key);
+        }
+    }
+};
+
+}  // namespace chatterino
@@ -10,9 +10,16 @@ SubstringPredicate::SubstringPredicate(const QString &search)
 {
 }
 
-bool SubstringPredicate::appliesToImpl(const Message &message)
+bool SubstringPredicate::appliesToImpl(const Message &message,
+                                       MessageFlags /*flags*/)
 {
     return message.searchText.contains(this->search_, Qt::CaseInsensitive);
 }
 
+std::optional<SearchIndex::Postings> SubstringPredicate::candidatesImpl(
+    const SearchIndex &index) const
+{
+    return index.bySubstring(this->search_);
+}
+
 }  // namespace chatterino
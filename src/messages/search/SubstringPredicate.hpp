@@ -34,7 +34,15 @@ protected:
      * @param message the message to check
      * @return true if the message contains the substring, false otherwise
      */
-    bool appliesToImpl(const Message &message) override;
+    bool appliesToImpl(const Message &message,
+                       MessageFlags flags) override;
+
+    /**
+     * @brief Looks up the messages that might contain the substring passed in
+     *        the constructor.
+     */
+    std::optional<SearchIndex::Postings> candidatesImpl(
+        const SearchIndex &index) const override;
 
 private:
     /// Holds the substring to search for in a message's `messageText`
@@ -15,7 +15,8 @@ SubtierPredicate::SubtierPredicate(const QString &subtiers, bool negate)
     }
 }
 
-bool SubtierPredicate::appliesToImpl(const Message &message)
+bool SubtierPredicate::appliesToImpl(const Message &message,
+                                     MessageFlags /*flags*/)
 {
     for (const Badge &badge : message.badges)
     {
@@ -35,6 +35,7 @@ void ChatterinoBadges::loadChatterinoBadges()
 
     NetworkRequest(url)
         .concurrent()
+        .priority(NetworkPriority::Background)
         .onSuccess([this](auto result) {
             auto jsonRoot = result.parseJson();
 
@@ -53,6 +53,7 @@ void FfzBadges::load()
     static QUrl url("https://api.frankerfacez.com/v1/badges/ids");
 
     NetworkRequest(url)
+        .priority(NetworkPriority::Background)
         .onSuccess([this](auto result) {
             std::unique_lock lock(this->mutex_);
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/network/IoContextPool.hpp"
 #include "common/QLogging.hpp"
 #include "providers/liveupdates/BasicPubSubWebsocket.hpp"
 #include "singletons/Settings.hpp"
@@ -10,6 +11,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstring>
 #include <unordered_set>
 
 namespace chatterino {
@@ -67,6 +69,8 @@ protected:
             return false;
         }
 
+        IoContextPool::addBytesSent(std::strlen(payload));
+
         return true;
     }
 
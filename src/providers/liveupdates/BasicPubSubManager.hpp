@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/network/IoContextPool.hpp"
 #include "common/QLogging.hpp"
 #include "common/Version.hpp"
 #include "providers/liveupdates/BasicPubSubClient.hpp"
@@ -9,11 +10,11 @@
 #include "util/DebugCount.hpp"
 #include "util/ExponentialBackoff.hpp"
 #include "util/OnceFlag.hpp"
-#include "util/RenameThread.hpp"
 
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <pajlada/signals/signal.hpp>
 #include <QJsonObject>
-#include <QScopeGuard>
 #include <QString>
 #include <QStringBuilder>
 #include <websocketpp/client.hpp>
@@ -21,11 +22,12 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
-#include <exception>
+#include <deque>
 #include <map>
 #include <memory>
-#include <thread>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -39,14 +41,23 @@ namespace chatterino {
  * You can customize the clients, by creating your custom
  * client in ::createClient.
  *
+ * The connections run on a context of the shared IoContextPool,
+ * so all handlers of one manager run on the same thread.
+ *
  * You **must** implement #onMessage. The method gets called for every
  * received message on every connection.
  * If you want to get the connection this message was received on,
  * use #findClient.
  *
  * You must expose your own subscribe and unsubscribe methods
- * (e.g. [un-]subscribeTopic).
- * This manager does not keep track of the subscriptions.
+ * (e.g. [un-]subscribeTopic). They may be called from any thread.
+ *
+ * Subscriptions are planned rather than sent right away: duplicates are
+ * dropped, a subscription that's removed before it was sent is never sent, and
+ * frames go out in paced batches of SUBSCRIBE_BATCH_SIZE. Each subscription
+ * goes to the fullest connection with room left, so the subscriptions are
+ * packed into as few connections as possible. When a connection drops, only
+ * its subscriptions are placed again.
  *
  * @tparam Subscription
  * The subscription has the following requirements:
@@ -63,6 +74,11 @@ template <typename Subscription>
 class BasicPubSubManager
 {
 public:
+    /// Maximum number of (un-)subscribe frames sent at once
+    static constexpr size_t SUBSCRIBE_BATCH_SIZE = 50;
+    /// Time between two batches of (un-)subscribe frames
+    static constexpr std::chrono::milliseconds SUBSCRIBE_BATCH_INTERVAL{250};
+
     BasicPubSubManager(QString host, QString shortName)
         : host_(std::move(host))
         , shortName_(std::move(shortName))
@@ -73,14 +89,13 @@ public:
             websocketpp::log::alevel::frame_payload |
             websocketpp::log::alevel::frame_header);
 
-        this->websocketClient_.init_asio();
-
         // SSL Handshake
-        this->websocketClient_.set_tls_init_handler([this](auto hdl) {
-            return this->onTLSInit(hdl);
+        this->websocketClient_.set_tls_init_handler([](auto /*hdl*/) {
+            return IoContextPool::instance().tlsContext();
         });
 
         this->websocketClient_.set_message_handler([this](auto hdl, auto msg) {
+            IoContextPool::addBytesReceived(msg->get_payload().size());
             this->onMessage(hdl, msg);
         });
         this->websocketClient_.set_open_handler([this](auto hdl) {
@@ -119,19 +134,22 @@ public:
 
     void start()
     {
-        this->work_ = std::make_shared<boost::asio::executor_work_guard<
-            boost::asio::io_context::executor_type>>(
-            this->websocketClient_.get_io_service().get_executor());
-        this->mainThread_.reset(new std::thread([this] {
-            // make sure we set in any case, even exceptions
-            auto guard = qScopeGuard([&] {
-                this->stoppedFlag_.set();
-            });
+        assert(this->ioContext_ == nullptr);
 
-            runThread();
-        }));
+        auto &ioContext = IoContextPool::instance().acquire();
+        this->websocketClient_.init_asio(&ioContext);
+        this->reconnectTimer_ =
+            std::make_shared<boost::asio::steady_timer>(ioContext);
+        this->drainTimer_ =
+            std::make_shared<boost::asio::steady_timer>(ioContext);
 
-        renameThread(*this->mainThread_.get(), "BPSM-" % this->shortName_);
+        qCDebug(chatterinoLiveupdates)
+            << "Started" << this->shortName_ << "LiveUpdates manager";
+
+        std::lock_guard lock(this->plannerMutex_);
+        this->ioContext_ = &ioContext;
+        // Send what was subscribed before we started
+        this->scheduleDrain();
     }
 
     void stop()
@@ -143,41 +161,55 @@ public:
 
         this->stopping_ = true;
 
-        for (const auto &client : this->clients_)
+        if (this->ioContext_ == nullptr)
         {
-            client.second->close("Shutting down");
+            return;
         }
 
-        this->work_.reset();
+        boost::asio::post(*this->ioContext_, [this] {
+            for (const auto &client : this->clients_)
+            {
+                client.second->close("Shutting down");
+            }
+            this->reconnectTimer_->cancel();
+            this->drainTimer_->cancel();
+            this->checkStopped();
+        });
 
-        if (!this->mainThread_->joinable())
+        // The context is shared, so we can't wait for it to run out of work.
+        // Wait until all connections (including one that's still being
+        // opened) are closed instead.
+        if (!this->stoppedFlag_.waitFor(std::chrono::seconds{1}))
         {
-            return;
+            qCWarning(chatterinoLiveupdates)
+                << "Connections didn't close within 1 second, terminate them";
+
+            // Handlers of the connections refer to us. They must be gone
+            // before we're destroyed, while the context keeps running.
+            OnceFlag terminated;
+            boost::asio::post(*this->ioContext_, [this, &terminated] {
+                this->terminateConnections();
+                terminated.set();
+            });
+            terminated.wait();
         }
 
-        // NOTE:
-        // There is a case where a new client was initiated but not added to the clients list.
-        // We just don't join the thread & let the operating system nuke the thread if joining fails
-        // within 1s.
-        if (this->stoppedFlag_.waitFor(std::chrono::seconds{1}))
-        {
-            this->mainThread_->join();
-            return;
-        }
+        IoContextPool::instance().release(*this->ioContext_);
+    }
 
-        qCWarning(chatterinoLiveupdates)
-            << "Thread didn't finish within 1 second, force-stop the client";
-        this->websocketClient_.stop();
-        if (this->stoppedFlag_.waitFor(std::chrono::milliseconds{100}))
-        {
-            this->mainThread_->join();
-            return;
-        }
+    /// Returns the number of subscriptions, including the ones that weren't
+    /// sent yet
+    size_t subscriptionCount()
+    {
+        std::lock_guard lock(this->plannerMutex_);
 
-        qCWarning(chatterinoLiveupdates)
-            << "Thread didn't finish after stopping, discard it";
-        // detach the thread so the destructor doesn't attempt any joining
-        this->mainThread_->detach();
+        return this->desired_.size();
+    }
+
+    /// Returns the number of open connections
+    size_t connectionCount() const
+    {
+        return this->connectionCount_.load(std::memory_order_acquire);
     }
 
 protected:
@@ -214,25 +246,30 @@ protected:
 
     void unsubscribe(const Subscription &subscription)
     {
-        for (auto &client : this->clients_)
+        std::lock_guard lock(this->plannerMutex_);
+
+        if (this->desired_.erase(subscription) == 0)
         {
-            if (client.second->unsubscribe(subscription))
-            {
-                return;
-            }
+            return;
         }
+
+        DebugCount::set(this->shortName_ % " subscriptions",
+                        static_cast<int64_t>(this->desired_.size()));
+        this->enqueue(subscription, false);
     }
 
     void subscribe(const Subscription &subscription)
     {
-        if (this->trySubscribe(subscription))
+        std::lock_guard lock(this->plannerMutex_);
+
+        if (!this->desired_.insert(subscription).second)
         {
             return;
         }
 
-        this->addClient();
-        this->pendingSubscriptions_.emplace_back(subscription);
-        DebugCount::increase("LiveUpdates subscription backlog");
+        DebugCount::set(this->shortName_ % " subscriptions",
+                        static_cast<int64_t>(this->desired_.size()));
+        this->enqueue(subscription, true);
     }
 
 private:
@@ -240,6 +277,7 @@ private:
     {
         DebugCount::increase("LiveUpdates connections");
         this->addingClient_ = false;
+        this->connectingHandle_.reset();
         this->diag.connectionsOpened.fetch_add(1, std::memory_order_acq_rel);
 
         this->connectBackoff_.reset();
@@ -251,33 +289,32 @@ private:
         client->start();
 
         this->clients_.emplace(hdl, client);
+        this->connectionCount_.fetch_add(1, std::memory_order_acq_rel);
+        DebugCount::set(this->shortName_ % " connections",
+                        static_cast<int64_t>(this->clients_.size()));
 
-        auto pendingSubsToTake = std::min(this->pendingSubscriptions_.size(),
-                                          client->maxSubscriptions);
-
-        qCDebug(chatterinoLiveupdates)
-            << "LiveUpdate connection opened, subscribing to"
-            << pendingSubsToTake << "subscriptions!";
-
-        while (pendingSubsToTake > 0 && !this->pendingSubscriptions_.empty())
+        if (this->stopping_)
         {
-            const auto last = std::move(this->pendingSubscriptions_.back());
-            this->pendingSubscriptions_.pop_back();
-            if (!client->subscribe(last))
-            {
-                qCDebug(chatterinoLiveupdates)
-                    << "Failed to subscribe to" << last << "on new client.";
-                // TODO: should we try to add a new client here?
-                return;
-            }
-            DebugCount::decrease("LiveUpdates subscription backlog");
-            pendingSubsToTake--;
+            // This connection was opened while we were shutting down
+            client->close("Shutting down");
+            return;
         }
 
-        if (!this->pendingSubscriptions_.empty())
+        qCDebug(chatterinoLiveupdates)
+            << "LiveUpdate connection opened, placing"
+            << this->pendingSubscriptions_.size() << "pending subscriptions!";
+
+        // The pending subscriptions go through the queue again, so they're
+        // paced like all others
+        std::lock_guard lock(this->plannerMutex_);
+        for (const auto &subscription : this->pendingSubscriptions_)
         {
-            this->addClient();
+            this->enqueue(subscription, true);
         }
+        DebugCount::decrease(
+            "LiveUpdates subscription backlog",
+            static_cast<int64_t>(this->pendingSubscriptions_.size()));
+        this->pendingSubscriptions_.clear();
     }
 
     void onConnectionFail(websocketpp::connection_hdl hdl)
@@ -298,10 +335,17 @@ private:
                    "connection from a handle.";
         }
         this->addingClient_ = false;
+        this->connectingHandle_.reset();
+        if (this->stopping_)
+        {
+            this->checkStopped();
+            return;
+        }
+
         if (!this->pendingSubscriptions_.empty())
         {
-            runAfter(this->websocketClient_.get_io_service(),
-                     this->connectBackoff_.next(), [this](auto /*timer*/) {
+            runAfter(this->reconnectTimer_, this->connectBackoff_.next(),
+                     [this](auto /*timer*/) {
                          this->addClient();
                      });
         }
@@ -322,44 +366,208 @@ private:
         auto client = clientIt->second;
 
         this->clients_.erase(clientIt);
+        this->connectionCount_.fetch_sub(1, std::memory_order_acq_rel);
+        DebugCount::set(this->shortName_ % " connections",
+                        static_cast<int64_t>(this->clients_.size()));
 
         client->stop();
 
-        if (!this->stopping_)
+        if (this->stopping_)
         {
-            for (const auto &sub : client->subscriptions_)
+            this->checkStopped();
+            return;
+        }
+
+        // Only the subscriptions of this connection need to be placed again
+        std::lock_guard lock(this->plannerMutex_);
+        for (const auto &sub : client->subscriptions_)
+        {
+            if (this->desired_.contains(sub))
             {
-                this->subscribe(sub);
+                this->enqueue(sub, true);
             }
         }
     }
 
-    WebsocketContextPtr onTLSInit(const websocketpp::connection_hdl & /*hdl*/)
+    /// Queues an (un-)subscription to be sent. An unsent (un-)subscription of
+    /// the same subscription cancels out with this one.
+    ///
+    /// Must be called with `plannerMutex_` held.
+    void enqueue(const Subscription &subscription, bool subscribe)
     {
-        WebsocketContextPtr ctx(
-            new boost::asio::ssl::context(boost::asio::ssl::context::tlsv12));
+        auto it = this->queuedOps_.find(subscription);
+        if (it != this->queuedOps_.end())
+        {
+            if (it->second != subscribe)
+            {
+                this->queuedOps_.erase(it);
+            }
+            return;
+        }
+
+        this->queuedOps_.emplace(subscription, subscribe);
+        this->queueOrder_.push_back(subscription);
+        this->scheduleDrain();
+    }
 
-        try
+    /// Must be called with `plannerMutex_` held.
+    void scheduleDrain()
+    {
+        if (this->drainScheduled_ || this->ioContext_ == nullptr ||
+            this->stopping_ || this->queueOrder_.empty())
         {
-            ctx->set_options(boost::asio::ssl::context::default_workarounds |
-                             boost::asio::ssl::context::no_sslv2 |
-                             boost::asio::ssl::context::single_dh_use);
+            return;
         }
-        catch (const std::exception &e)
+
+        this->drainScheduled_ = true;
+        boost::asio::post(*this->ioContext_, [this] {
+            this->drain();
+        });
+    }
+
+    /// Sends the next batch of queued (un-)subscriptions
+    void drain()
+    {
+        std::vector<std::pair<Subscription, bool>> batch;
+        bool more = false;
         {
-            qCDebug(chatterinoLiveupdates)
-                << "Exception caught in OnTLSInit:" << e.what();
+            std::lock_guard lock(this->plannerMutex_);
+
+            while (batch.size() < SUBSCRIBE_BATCH_SIZE &&
+                   !this->queueOrder_.empty())
+            {
+                auto it = this->queuedOps_.find(this->queueOrder_.front());
+                this->queueOrder_.pop_front();
+                if (it == this->queuedOps_.end())
+                {
+                    // Cancelled out
+                    continue;
+                }
+
+                batch.emplace_back(it->first, it->second);
+                this->queuedOps_.erase(it);
+            }
+
+            more = !this->queueOrder_.empty();
+            this->drainScheduled_ = more;
+        }
+
+        if (this->stopping_)
+        {
+            return;
         }
 
-        return ctx;
+        for (const auto &[subscription, subscribe] : batch)
+        {
+            if (subscribe)
+            {
+                this->place(subscription);
+            }
+            else
+            {
+                this->remove(subscription);
+            }
+        }
+
+        if (more)
+        {
+            runAfter(this->drainTimer_, SUBSCRIBE_BATCH_INTERVAL,
+                     [this](auto /*timer*/) {
+                         this->drain();
+                     });
+        }
     }
 
-    void runThread()
+    /// Subscribes on the fullest connection that still has room, or queues the
+    /// subscription for a new connection
+    void place(const Subscription &subscription)
     {
-        qCDebug(chatterinoLiveupdates) << "Start LiveUpdates manager thread";
-        this->websocketClient_.run();
-        qCDebug(chatterinoLiveupdates)
-            << "Done with LiveUpdates manager thread";
+        BasicPubSubClient<Subscription> *target = nullptr;
+        for (const auto &[hdl, client] : this->clients_)
+        {
+            (void)hdl;
+
+            auto size = client->subscriptions_.size();
+            if (size < client->maxSubscriptions &&
+                (target == nullptr || size > target->subscriptions_.size()))
+            {
+                target = client.get();
+            }
+        }
+
+        if (target != nullptr && target->subscribe(subscription))
+        {
+            return;
+        }
+
+        this->pendingSubscriptions_.emplace_back(subscription);
+        DebugCount::increase("LiveUpdates subscription backlog");
+        this->addClient();
+    }
+
+    void remove(const Subscription &subscription)
+    {
+        auto pending = std::find(this->pendingSubscriptions_.begin(),
+                                 this->pendingSubscriptions_.end(),
+                                 subscription);
+        if (pending != this->pendingSubscriptions_.end())
+        {
+            // Never sent
+            this->pendingSubscriptions_.erase(pending);
+            DebugCount::decrease("LiveUpdates subscription backlog");
+            return;
+        }
+
+        for (const auto &[hdl, client] : this->clients_)
+        {
+            (void)hdl;
+
+            if (client->unsubscribe(subscription))
+            {
+                return;
+            }
+        }
+    }
+
+    /// Drops all connections without waiting for the server. Their handlers
+    /// are removed first, so none of them calls us afterwards.
+    void terminateConnections()
+    {
+        auto terminate = [this](const liveupdates::WebsocketHandle &hdl) {
+            liveupdates::WebsocketErrorCode ec;
+            auto conn = this->websocketClient_.get_con_from_hdl(hdl, ec);
+            if (ec)
+            {
+                // Already gone
+                return;
+            }
+
+            conn->set_open_handler(nullptr);
+            conn->set_close_handler(nullptr);
+            conn->set_fail_handler(nullptr);
+            conn->set_message_handler(nullptr);
+            conn->terminate({});
+        };
+
+        terminate(this->connectingHandle_);
+        for (const auto &[hdl, client] : this->clients_)
+        {
+            terminate(hdl);
+            client->stop();
+        }
+
+        this->clients_.clear();
+        this->connectionCount_.store(0, std::memory_order_release);
+        this->addingClient_ = false;
+    }
+
+    /// Signals stop() once the last connection is gone
+    void checkStopped()
+    {
+        if (this->stopping_ && this->clients_.empty() && !this->addingClient_)
+        {
+            this->stoppedFlag_.set();
+        }
     }
 
     void addClient()
@@ -381,41 +589,46 @@ private:
         {
             qCDebug(chatterinoLiveupdates)
                 << "Unable to establish connection:" << ec.message().c_str();
+            this->addingClient_ = false;
             return;
         }
 
         NetworkConfigurationProvider::applyToWebSocket(con);
 
+        this->connectingHandle_ = con->get_handle();
         this->websocketClient_.connect(con);
     }
 
-    bool trySubscribe(const Subscription &subscription)
-    {
-        for (auto &client : this->clients_)
-        {
-            if (client.second->subscribe(subscription))
-            {
-                return true;
-            }
-        }
-        return false;
-    }
-
     std::map<liveupdates::WebsocketHandle,
              std::shared_ptr<BasicPubSubClient<Subscription>>,
              std::owner_less<liveupdates::WebsocketHandle>>
         clients_;
 
+    /// Subscriptions waiting for a new connection
     std::vector<Subscription> pendingSubscriptions_;
     std::atomic<bool> addingClient_{false};
+    /// The connection that's being opened while `addingClient_` is set
+    liveupdates::WebsocketHandle connectingHandle_;
+    std::atomic<size_t> connectionCount_{0};
     ExponentialBackoff<5> connectBackoff_{std::chrono::milliseconds(1000)};
 
-    std::shared_ptr<boost::asio::executor_work_guard<
-        boost::asio::io_context::executor_type>>
-        work_{nullptr};
+    /// Guards the planner state below, it's shared with the subscribers'
+    /// threads
+    std::mutex plannerMutex_;
+    /// All subscriptions we want, sent or not
+    std::unordered_set<Subscription> desired_;
+    /// Unsent operations: true to subscribe, false to unsubscribe
+    std::unordered_map<Subscription, bool> queuedOps_;
+    /// Order of `queuedOps_`. Might contain subscriptions that cancelled out.
+    std::deque<Subscription> queueOrder_;
+    bool drainScheduled_ = false;
+    /// The context of the IoContextPool our connections run on
+    boost::asio::io_context *ioContext_ = nullptr;
+
+    std::shared_ptr<boost::asio::steady_timer> reconnectTimer_;
+    std::shared_ptr<boost::asio::steady_timer> drainTimer_;
 
     liveupdates::WebsocketClient websocketClient_;
-    std::unique_ptr<std::thread> mainThread_;
     OnceFlag stoppedFlag_;
 
     const QString host_;
@@ -423,7 +636,7 @@ private:
     /// Short name of the service (e.g. "7TV" or "BTTV")
     const QString shortName_;
 
-    bool stopping_{false};
+    std::atomic<bool> stopping_{false};
 };
 
 }  // namespace chatterino
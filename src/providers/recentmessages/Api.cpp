@@ -5,6 +5,13 @@
 #include "common/QLogging.hpp"
 #include "providers/recentmessages/Impl.hpp"
 #include "util/PostToThread.hpp"
+#include "util/VectorMessageSink.hpp"
+
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <algorithm>
 
 namespace {
 
@@ -17,6 +24,114 @@ namespace chatterino::recentmessages {
 
 using namespace recentmessages::detail;
 
+namespace {
+
+/// How many messages are built before they're posted to the GUI thread
+constexpr std::ptrdiff_t CHUNK_SIZE = 100;
+
+/// Timeouts and clears may replace one of the last 20 built messages (see
+/// addOrReplaceChannelTimeout), so these aren't posted before the end
+constexpr size_t REPLACEABLE_MESSAGES = 20;
+
+/// Parsing and building recent messages is CPU bound, so it gets its own pool.
+/// Loading the history of many channels at once can't starve other tasks.
+QThreadPool &buildPool()
+{
+    // This is leaked on purpose, its threads may outlive the application
+    static auto *pool = [] {
+        auto *pool = new QThreadPool;
+        pool->setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+        return pool;
+    }();
+    return *pool;
+}
+
+/// Builds the messages in chunks of CHUNK_SIZE and posts every chunk to the
+/// GUI thread once it's built, so the channel fills before all messages are
+/// built.
+///
+/// `lastDate` is the channel's lastDate_ when the response arrived. It's
+/// written back with the last chunk, the channel itself is only changed on
+/// the GUI thread.
+void deliverInChunks(ChannelPtr channel, ParsedRecentMessages parsed,
+                     QDate lastDate, const ResultCallback &onLoaded)
+{
+    // Notify user about a possible gap in logs if it returned some messages
+    // but isn't currently joined to a channel
+    if (!parsed.errorCode.isEmpty())
+    {
+        qCDebug(LOG) << QString("Got error from API: error_code=%1, "
+                                "channel=%2")
+                            .arg(parsed.errorCode, channel->getName());
+        if (parsed.errorCode == "channel_not_joined" &&
+            !parsed.messages.empty())
+        {
+            postToThread([channel] {
+                channel->addSystemMessage(
+                    "Message history service recovering, there may "
+                    "be gaps in the message history.");
+            });
+        }
+    }
+
+    if (parsed.messages.empty())
+    {
+        postToThread([owner = std::move(channel), onLoaded] {
+            onLoaded({}, true);
+        });
+        return;
+    }
+
+    // All chunks are built into one sink, so replies, timeouts and similar
+    // messages can refer to messages of earlier chunks
+    VectorMessageSink sink({}, MessageFlag::RecentMessage);
+    const auto &built = sink.messages();
+    size_t posted = 0;
+
+    auto it = parsed.messages.begin();
+    while (it != parsed.messages.end())
+    {
+        auto chunkEnd =
+            it + std::min(CHUNK_SIZE, parsed.messages.end() - it);
+        std::vector<Communi::IrcMessage *> chunk(it, chunkEnd);
+        it = chunkEnd;
+
+        // build the Communi messages into chatterino messages
+        buildRecentMessages(chunk, channel.get(), sink, lastDate);
+
+        bool done = it == parsed.messages.end();
+        size_t ready = built.size();
+        if (!done)
+        {
+            ready = ready > REPLACEABLE_MESSAGES ? ready - REPLACEABLE_MESSAGES
+                                                 : 0;
+            if (ready <= posted)
+            {
+                continue;
+            }
+        }
+
+        std::vector<MessagePtr> messages(
+            built.begin() + static_cast<std::ptrdiff_t>(posted),
+            built.begin() + static_cast<std::ptrdiff_t>(ready));
+        posted = ready;
+
+        // The last chunk takes our reference, so the channel is never
+        // destroyed on this thread
+        auto owner = done ? std::move(channel) : channel;
+        postToThread([owner = std::move(owner), messages = std::move(messages),
+                      onLoaded, done, lastDate] {
+            if (done)
+            {
+                owner->lastDate_ = lastDate;
+            }
+            onLoaded(messages, done);
+        });
+    }
+}
+
+}  // namespace
+
 void load(
     const QString &channelName, std::weak_ptr<Channel> channelPtr,
     ResultCallback onLoaded, ErrorCallback onError, const int limit,
@@ -35,46 +150,31 @@ void load(
     QTimer::singleShot(delayMs, [=] {
         NetworkRequest(url)
             .onSuccess([channelPtr, onLoaded](const auto &result) {
-                auto shared = channelPtr.lock();
-                if (!shared)
+                auto channel = channelPtr.lock();
+                if (!channel)
                 {
                     return;
                 }
 
-                qCDebug(LOG) << "Successfully loaded recent messages for"
-                             << shared->getName();
-
-                auto root = result.parseJson();
-                auto parsedMessages = parseRecentMessages(root);
-
-                // build the Communi messages into chatterino messages
-                auto builtMessages =
-                    buildRecentMessages(parsedMessages, shared.get());
-
-                postToThread([shared = std::move(shared),
-                              root = std::move(root),
-                              messages = std::move(builtMessages),
-                              onLoaded]() mutable {
-                    // Notify user about a possible gap in logs if it returned some messages
-                    // but isn't currently joined to a channel
-                    const auto errorCode = root.value("error_code").toString();
-                    if (!errorCode.isEmpty())
-                    {
-                        qCDebug(LOG)
-                            << QString("Got error from API: error_code=%1, "
-                                       "channel=%2")
-                                   .arg(errorCode, shared->getName());
-                        if (errorCode == "channel_not_joined" &&
-                            !messages.empty())
+                // Only hand the body to the build pool here, parsing and
+                // building happens there
+                std::ignore = QtConcurrent::run(
+                    &buildPool(), [channelPtr, onLoaded,
+                                   lastDate = channel->lastDate_,
+                                   data = result.getData()] {
+                        auto shared = channelPtr.lock();
+                        if (!shared)
                         {
-                            shared->addSystemMessage(
-                                "Message history service recovering, there may "
-                                "be gaps in the message history.");
+                            return;
                         }
-                    }
 
-                    onLoaded(messages);
-                });
+                        qCDebug(LOG) << "Successfully loaded recent messages for"
+                                     << shared->getName();
+
+                        auto parsed = parseRecentMessages(data);
+                        deliverInChunks(std::move(shared), std::move(parsed),
+                                        lastDate, onLoaded);
+                    });
             })
             .onError([channelPtr, onError](const NetworkResult &result) {
                 auto shared = channelPtr.lock();
@@ -20,7 +20,10 @@ using MessagePtr = std::shared_ptr<const Message>;
 
 namespace chatterino::recentmessages {
 
-using ResultCallback = std::function<void(const std::vector<MessagePtr> &)>;
+/// Called with consecutive chunks of the loaded messages, oldest chunk first.
+/// `done` is set for the last chunk.
+using ResultCallback =
+    std::function<void(const std::vector<MessagePtr> &messages, bool done)>;
 using ErrorCallback = std::function<void()>;
 
 /**
@@ -28,7 +31,10 @@ using ErrorCallback = std::function<void()>;
  *
  * @param channelName Name of Twitch channel
  * @param channelPtr Weak pointer to Channel to use to build messages
- * @param onLoaded Callback taking the built messages as a const std::vector<MessagePtr> &
+ * The messages are parsed and built on a worker thread and delivered in
+ * chunks on the GUI thread.
+ *
+ * @param onLoaded Callback taking a chunk of the built messages, see ResultCallback
  * @param onError Callback called when the network request fails
  * @param limit Maximum number of messages to query
  * @param after Only return messages that were received after this timestamp; ignored if `std::nullopt`
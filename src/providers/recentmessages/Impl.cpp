@@ -1,35 +1,85 @@
 #include "providers/recentmessages/Impl.hpp"
 
 #include "common/Env.hpp"
+#include "common/QLogging.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/twitch/IrcMessageHandler.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "util/Helpers.hpp"
 #include "util/VectorMessageSink.hpp"
 
-#include <QJsonArray>
 #include <QUrlQuery>
+#include <rapidjson/document.h>
+#include <rapidjson/error/en.h>
 
 namespace chatterino::recentmessages::detail {
 
-// Parse the IRC messages returned in JSON form into Communi messages
-std::vector<Communi::IrcMessage *> parseRecentMessages(
-    const QJsonObject &jsonRoot)
+// Parse the IRC messages of a Recent Messages API response into Communi
+// messages
+ParsedRecentMessages parseRecentMessages(const QByteArray &body)
 {
-    const auto jsonMessages = jsonRoot.value("messages").toArray();
-    std::vector<Communi::IrcMessage *> messages;
+    ParsedRecentMessages parsed;
+
+    rapidjson::Document root;
+    root.Parse(body.constData(), body.size());
+    if (root.HasParseError() || !root.IsObject())
+    {
+        qCWarning(chatterinoRecentMessages)
+            << "Failed to parse recent messages:"
+            << rapidjson::GetParseError_En(root.GetParseError());
+        return parsed;
+    }
+
+    auto errorCode = root.FindMember("error_code");
+    if (errorCode != root.MemberEnd() && errorCode->value.IsString())
+    {
+        parsed.errorCode = QString::fromUtf8(
+            errorCode->value.GetString(),
+            static_cast<qsizetype>(errorCode->value.GetStringLength()));
+    }
+
+    auto jsonMessages = root.FindMember("messages");
+    if (jsonMessages == root.MemberEnd() || !jsonMessages->value.IsArray())
+    {
+        return parsed;
+    }
 
-    if (jsonMessages.empty())
+    const auto &array = jsonMessages->value.GetArray();
+    parsed.messages.reserve(array.Size());
+    for (const auto &jsonMessage : array)
     {
-        return messages;
+        if (!jsonMessage.IsString())
+        {
+            continue;
+        }
+
+        auto content = unescapeZeroWidthJoiner(QByteArray(
+            jsonMessage.GetString(),
+            static_cast<qsizetype>(jsonMessage.GetStringLength())));
+
+        parsed.messages.emplace_back(
+            Communi::IrcMessage::fromData(content, nullptr));
     }
 
-    for (const auto &jsonMessage : jsonMessages)
+    return parsed;
+}
+
+// Parse the records of a structured log into Communi messages. They're marked
+// as historical, so they can be built like recent messages.
+std::vector<Communi::IrcMessage *> parseStructuredLogRecords(
+    const std::vector<StructuredLogRecord> &records)
+{
+    std::vector<Communi::IrcMessage *> messages;
+    messages.reserve(records.size());
+
+    for (const auto &record : records)
     {
-        auto content = unescapeZeroWidthJoiner(jsonMessage.toString());
+        auto *message = Communi::IrcMessage::fromData(record.data, nullptr);
 
-        auto *message =
-            Communi::IrcMessage::fromData(content.toUtf8(), nullptr);
+        auto tags = message->tags();
+        tags.insert("historical", "1");
+        tags.insert("rm-received-ts", QString::number(record.receivedMs));
+        message->setTags(tags);
 
         messages.emplace_back(message);
     }
@@ -40,14 +90,23 @@ std::vector<Communi::IrcMessage *> parseRecentMessages(
 // Build Communi messages retrieved from the recent messages API into
 // proper chatterino messages.
 std::vector<MessagePtr> buildRecentMessages(
-    std::vector<Communi::IrcMessage *> &messages, Channel *channel)
+    std::vector<Communi::IrcMessage *> &messages, Channel *channel,
+    QDate &lastDate)
 {
     VectorMessageSink sink({}, MessageFlag::RecentMessage);
+    buildRecentMessages(messages, channel, sink, lastDate);
+    return std::move(sink).takeMessages();
+}
 
+// Build Communi messages retrieved from the recent messages API into `sink`.
+void buildRecentMessages(std::vector<Communi::IrcMessage *> &messages,
+                         Channel *channel, VectorMessageSink &sink,
+                         QDate &lastDate)
+{
     auto *twitchChannel = dynamic_cast<TwitchChannel *>(channel);
     if (!twitchChannel)
     {
-        return {};
+        return;
     }
 
     for (auto *message : messages)
@@ -60,9 +119,9 @@ std::vector<MessagePtr> buildRecentMessages(
                     .date();
 
             // Check if we need to insert a message stating that a new day began
-            if (msgDate != channel->lastDate_)
+            if (msgDate != lastDate)
             {
-                channel->lastDate_ = msgDate;
+                lastDate = msgDate;
                 auto msg = makeSystemMessage(
                     QLocale().toString(msgDate, QLocale::LongFormat),
                     QTime(0, 0));
@@ -74,8 +133,6 @@ std::vector<MessagePtr> buildRecentMessages(
 
         message->deleteLater();
     }
-
-    return std::move(sink).takeMessages();
 }
 
 // Returns the URL to be used for querying the Recent Messages API for the
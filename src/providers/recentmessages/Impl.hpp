@@ -2,9 +2,11 @@
 
 #include "common/Channel.hpp"
 #include "messages/Message.hpp"
+#include "singletons/helper/StructuredLog.hpp"
 
 #include <IrcMessage>
-#include <QJsonObject>
+#include <QByteArray>
+#include <QDate>
 #include <QString>
 #include <QUrl>
 
@@ -13,16 +15,47 @@
 #include <optional>
 #include <vector>
 
+namespace chatterino {
+
+class VectorMessageSink;
+
+}  // namespace chatterino
+
 namespace chatterino::recentmessages::detail {
 
-// Parse the IRC messages returned in JSON form into Communi messages
-std::vector<Communi::IrcMessage *> parseRecentMessages(
-    const QJsonObject &jsonRoot);
+struct ParsedRecentMessages {
+    std::vector<Communi::IrcMessage *> messages;
+    /// The `error_code` of the response, empty if there was none
+    QString errorCode;
+};
+
+// Parse the IRC messages of a Recent Messages API response into Communi
+// messages. The messages are passed to Communi as UTF-8 without converting
+// them to QString first.
+ParsedRecentMessages parseRecentMessages(const QByteArray &body);
+
+// Parse the records of a structured log into Communi messages. They're marked
+// as historical, so they can be built like recent messages.
+std::vector<Communi::IrcMessage *> parseStructuredLogRecords(
+    const std::vector<StructuredLogRecord> &records);
 
 // Build Communi messages retrieved from the recent messages API into
 // proper chatterino messages.
+//
+// A date separator is added before every message from a day after
+// `lastDate`, which is updated along the way. Messages are built off the GUI
+// thread, so this is a copy of the channel's lastDate_ that the caller writes
+// back on the GUI thread.
 std::vector<MessagePtr> buildRecentMessages(
-    std::vector<Communi::IrcMessage *> &messages, Channel *channel);
+    std::vector<Communi::IrcMessage *> &messages, Channel *channel,
+    QDate &lastDate);
+
+// Build Communi messages retrieved from the recent messages API into `sink`.
+// All parts of one response must be built into the same sink, so replies,
+// timeouts and similar messages can refer to earlier parts.
+void buildRecentMessages(std::vector<Communi::IrcMessage *> &messages,
+                         Channel *channel, VectorMessageSink &sink,
+                         QDate &lastDate);
 
 // Returns the URL to be used for querying the Recent Messages API for the
 // given channel.
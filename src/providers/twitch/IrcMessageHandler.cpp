@@ -1022,12 +1022,10 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *message,
         it != tags.end())
     {
         const QString replyID = it.value().toString();
-        auto threadIt = chan->threads().find(replyID);
         std::shared_ptr<MessageThread> rootThread;
-        if (threadIt != chan->threads().end() && !threadIt->second.expired())
+        if (auto thread = chan->findReplyThread(replyID))
         {
             // Thread already exists (has a reply)
-            auto thread = threadIt->second.lock();
             checkThreadSubscription(tags, message->nick(), thread);
             replyCtx.thread = thread;
             rootThread = thread;
@@ -1062,14 +1060,9 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *message,
             }
             else
             {
-                auto parentThreadIt = chan->threads().find(parentID);
-                if (parentThreadIt != chan->threads().end())
+                if (auto thread = chan->findReplyThread(parentID))
                 {
-                    auto thread = parentThreadIt->second.lock();
-                    if (thread)
-                    {
-                        replyCtx.parent = thread->root();
-                    }
+                    replyCtx.parent = thread->root();
                 }
                 else
                 {
@@ -1,5 +1,6 @@
 #include "providers/twitch/PubSubClient.hpp"
 
+#include "common/network/IoContextPool.hpp"
 #include "common/QLogging.hpp"
 #include "providers/twitch/PubSubActions.hpp"
 #include "providers/twitch/PubSubHelpers.hpp"
@@ -9,6 +10,7 @@
 #include "util/Helpers.hpp"
 #include "util/RapidjsonHelpers.hpp"
 
+#include <cstring>
 #include <exception>
 #include <thread>
 
@@ -225,6 +227,8 @@ bool PubSubClient::send(const char *payload)
         return false;
     }
 
+    IoContextPool::addBytesSent(std::strlen(payload));
+
     return true;
 }
 
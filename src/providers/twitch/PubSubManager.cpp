@@ -1,6 +1,7 @@
 #include "providers/twitch/PubSubManager.hpp"
 
 #include "Application.hpp"
+#include "common/network/IoContextPool.hpp"
 #include "common/QLogging.hpp"
 #include "controllers/accounts/AccountController.hpp"
 #include "providers/NetworkConfigurationProvider.hpp"
@@ -12,16 +13,13 @@
 #include "util/DebugCount.hpp"
 #include "util/Helpers.hpp"
 #include "util/RapidjsonHelpers.hpp"
-#include "util/RenameThread.hpp"
 
+#include <boost/asio/post.hpp>
 #include <QJsonArray>
-#include <QScopeGuard>
 
 #include <algorithm>
-#include <exception>
 #include <iostream>
 #include <memory>
-#include <thread>
 
 using websocketpp::lib::bind;
 using websocketpp::lib::placeholders::_1;
@@ -484,11 +482,10 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
         websocketpp::log::alevel::frame_payload |
         websocketpp::log::alevel::frame_header);
 
-    this->websocketClient.init_asio();
-
     // SSL Handshake
-    this->websocketClient.set_tls_init_handler(
-        bind(&PubSub::onTLSInit, this, ::_1));
+    this->websocketClient.set_tls_init_handler([](auto /*hdl*/) {
+        return IoContextPool::instance().tlsContext();
+    });
 
     this->websocketClient.set_message_handler(
         bind(&PubSub::onMessage, this, ::_1, ::_2));
@@ -547,73 +544,109 @@ void PubSub::addClient()
     {
         qCDebug(chatterinoPubSub)
             << "Unable to establish connection:" << ec.message().c_str();
+        this->addingClient = false;
         return;
     }
 
     NetworkConfigurationProvider::applyToWebSocket(con);
 
+    this->connectingHandle_ = con->get_handle();
     this->websocketClient.connect(con);
 }
 
 void PubSub::start()
 {
-    this->work = std::make_shared<boost::asio::executor_work_guard<
-        boost::asio::io_context::executor_type>>(
-        this->websocketClient.get_io_service().get_executor());
-    this->thread = std::make_unique<std::thread>([this] {
-        // make sure we set in any case, even exceptions
-        auto guard = qScopeGuard([&] {
-            this->stoppedFlag_.set();
-        });
+    assert(this->ioContext_ == nullptr);
 
-        runThread();
-    });
-    renameThread(*this->thread, "PubSub");
+    this->ioContext_ = &IoContextPool::instance().acquire();
+    this->websocketClient.init_asio(this->ioContext_);
+    this->reconnectTimer_ =
+        std::make_shared<boost::asio::steady_timer>(*this->ioContext_);
 }
 
 void PubSub::stop()
 {
-    this->stopping_ = true;
-
-    for (const auto &[hdl, client] : this->clients)
+    if (this->stopping_)
     {
-        (void)hdl;
-
-        client->close("Shutting down");
+        return;
     }
 
-    this->work.reset();
+    this->stopping_ = true;
 
-    if (!this->thread->joinable())
+    if (this->ioContext_ == nullptr)
     {
         return;
     }
 
-    // NOTE:
-    // There is a case where a new client was initiated but not added to the clients list.
-    // We just don't join the thread & let the operating system nuke the thread if joining fails
-    // within 1s.
-    // We could fix the underlying bug, but this is easier & we realistically won't use this exact code
-    // for super much longer.
-    if (this->stoppedFlag_.waitFor(std::chrono::seconds{1}))
+    boost::asio::post(*this->ioContext_, [this] {
+        for (const auto &[hdl, client] : this->clients)
+        {
+            (void)hdl;
+
+            client->close("Shutting down");
+        }
+        this->reconnectTimer_->cancel();
+        this->checkStopped();
+    });
+
+    // The context is shared, so we can't wait for it to run out of work.
+    // Wait until all connections (including one that's still being opened)
+    // are closed instead.
+    if (!this->stoppedFlag_.waitFor(std::chrono::seconds{1}))
     {
-        this->thread->join();
-        return;
+        qCWarning(chatterinoPubSub)
+            << "Connections didn't close within 1 second, terminate them";
+
+        // Handlers of the connections refer to us. They must be gone before
+        // we're destroyed, while the context keeps running.
+        OnceFlag terminated;
+        boost::asio::post(*this->ioContext_, [this, &terminated] {
+            this->terminateConnections();
+            terminated.set();
+        });
+        terminated.wait();
     }
 
-    qCWarning(chatterinoLiveupdates)
-        << "Thread didn't finish within 1 second, force-stop the client";
-    this->websocketClient.stop();
-    if (this->stoppedFlag_.waitFor(std::chrono::milliseconds{100}))
+    IoContextPool::instance().release(*this->ioContext_);
+}
+
+void PubSub::terminateConnections()
+{
+    auto terminate = [this](const WebsocketHandle &hdl) {
+        WebsocketErrorCode ec;
+        auto conn = this->websocketClient.get_con_from_hdl(hdl, ec);
+        if (ec)
+        {
+            // Already gone
+            return;
+        }
+
+        conn->set_open_handler(nullptr);
+        conn->set_close_handler(nullptr);
+        conn->set_fail_handler(nullptr);
+        conn->set_message_handler(nullptr);
+        conn->terminate({});
+    };
+
+    terminate(this->connectingHandle_);
+    for (const auto &[hdl, client] : this->clients)
     {
-        this->thread->join();
-        return;
+        terminate(hdl);
+        client->stop();
+        DebugCount::decrease("PubSub connections");
     }
 
-    qCWarning(chatterinoLiveupdates)
-        << "Thread didn't finish after stopping, discard it";
-    // detach the thread so the destructor doesn't attempt any joining
-    this->thread->detach();
+    this->clients.clear();
+    this->addingClient = false;
+    this->reconnectTimer_->cancel();
+}
+
+void PubSub::checkStopped()
+{
+    if (this->stopping_ && this->clients.empty() && !this->addingClient)
+    {
+        this->stoppedFlag_.set();
+    }
 }
 
 void PubSub::listenToChannelModerationActions(const QString &channelID)
@@ -814,6 +847,7 @@ void PubSub::onMessage(websocketpp::connection_hdl hdl,
                        WebsocketMessagePtr websocketMessage)
 {
     this->diag.messagesReceived += 1;
+    IoContextPool::addBytesReceived(websocketMessage->get_payload().size());
 
     const auto &payload =
         QString::fromStdString(websocketMessage->get_payload());
@@ -877,6 +911,7 @@ void PubSub::onConnectionOpen(WebsocketHandle hdl)
 
     DebugCount::increase("PubSub connections");
     this->addingClient = false;
+    this->connectingHandle_.reset();
 
     this->connectBackoff.reset();
 
@@ -889,6 +924,13 @@ void PubSub::onConnectionOpen(WebsocketHandle hdl)
 
     this->clients.emplace(hdl, client);
 
+    if (this->stopping_)
+    {
+        // This connection was opened while we were shutting down
+        client->close("Shutting down");
+        return;
+    }
+
     qCDebug(chatterinoPubSub) << "PubSub connection opened!";
 
     const auto topicsToTake =
@@ -943,10 +985,17 @@ void PubSub::onConnectionFail(WebsocketHandle hdl)
     }
 
     this->addingClient = false;
+    this->connectingHandle_.reset();
+    if (this->stopping_)
+    {
+        this->checkStopped();
+        return;
+    }
+
     if (!this->requests.empty())
     {
-        runAfter(this->websocketClient.get_io_service(),
-                 this->connectBackoff.next(), [this](auto timer) {
+        runAfter(this->reconnectTimer_, this->connectBackoff.next(),
+                 [this](auto timer) {
                      this->addClient();  //
                  });
     }
@@ -970,34 +1019,17 @@ void PubSub::onConnectionClose(WebsocketHandle hdl)
 
     client->stop();
 
-    if (!this->stopping_)
+    if (this->stopping_)
     {
-        auto clientListeners = client->getListeners();
-        for (const auto &listener : clientListeners)
-        {
-            this->listenToTopic(listener.topic);
-        }
+        this->checkStopped();
+        return;
     }
-}
-
-PubSub::WebsocketContextPtr PubSub::onTLSInit(websocketpp::connection_hdl hdl)
-{
-    WebsocketContextPtr ctx(
-        new boost::asio::ssl::context(boost::asio::ssl::context::tlsv12));
 
-    try
+    auto clientListeners = client->getListeners();
+    for (const auto &listener : clientListeners)
     {
-        ctx->set_options(boost::asio::ssl::context::default_workarounds |
-                         boost::asio::ssl::context::no_sslv2 |
-                         boost::asio::ssl::context::single_dh_use);
+        this->listenToTopic(listener.topic);
     }
-    catch (const std::exception &e)
-    {
-        qCDebug(chatterinoPubSub)
-            << "Exception caught in OnTLSInit:" << e.what();
-    }
-
-    return ctx;
 }
 
 void PubSub::handleResponse(const PubSubMessage &message)
@@ -1233,13 +1265,6 @@ void PubSub::handleMessageResponse(const PubSubMessageMessage &message)
     }
 }
 
-void PubSub::runThread()
-{
-    qCDebug(chatterinoPubSub) << "Start pubsub manager thread";
-    this->websocketClient.run();
-    qCDebug(chatterinoPubSub) << "Done with pubsub manager thread";
-}
-
 void PubSub::listenToTopic(const QString &topic)
 {
     PubSubListenMessage msg({topic});
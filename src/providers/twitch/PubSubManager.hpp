@@ -6,7 +6,7 @@
 #include "util/OnceFlag.hpp"
 
 #include <boost/asio/io_context.hpp>
-#include <boost/asio/ssl/context.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <pajlada/signals/signal.hpp>
 #include <QJsonObject>
 #include <QString>
@@ -22,7 +22,6 @@
 #include <map>
 #include <memory>
 #include <optional>
-#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -66,8 +65,6 @@ class PubSub
 {
     using WebsocketMessagePtr =
         websocketpp::config::asio_tls_client::message_type::ptr;
-    using WebsocketContextPtr =
-        websocketpp::lib::shared_ptr<boost::asio::ssl::context>;
 
     template <typename T>
     using Signal =
@@ -81,7 +78,9 @@ class PubSub
     };
 
     WebsocketClient websocketClient;
-    std::unique_ptr<std::thread> thread;
+    /// The context of the IoContextPool our connections run on
+    boost::asio::io_context *ioContext_ = nullptr;
+    std::shared_ptr<boost::asio::steady_timer> reconnectTimer_;
 
     // Account credentials
     // Set from setAccount
@@ -212,6 +211,8 @@ private:
     std::vector<QString> requests;
 
     std::atomic<bool> addingClient{false};
+    /// The connection that's being opened by addClient
+    WebsocketHandle connectingHandle_;
     ExponentialBackoff<5> connectBackoff{std::chrono::milliseconds(1000)};
 
     std::map<WebsocketHandle, std::shared_ptr<PubSubClient>,
@@ -230,7 +231,6 @@ private:
     void onConnectionOpen(websocketpp::connection_hdl hdl);
     void onConnectionFail(websocketpp::connection_hdl hdl);
     void onConnectionClose(websocketpp::connection_hdl hdl);
-    WebsocketContextPtr onTLSInit(websocketpp::connection_hdl hdl);
 
     void handleResponse(const PubSubMessage &message);
     void handleListenResponse(const NonceInfo &info, bool failed);
@@ -245,11 +245,12 @@ private:
 
     std::unordered_map<QString, NonceInfo> nonces_;
 
-    void runThread();
+    /// Signals stop() once the last connection is gone
+    void checkStopped();
 
-    std::shared_ptr<boost::asio::executor_work_guard<
-        boost::asio::io_context::executor_type>>
-        work{nullptr};
+    /// Drops all connections without waiting for the server. Must run on
+    /// the context.
+    void terminateConnections();
 
     const QString host_;
     const PubSubClientOptions clientOptions_;
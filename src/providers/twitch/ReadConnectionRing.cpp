@@ -0,0 +1,187 @@
+#include "providers/twitch/ReadConnectionRing.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace {
+
+uint64_t splitmix64(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/// FNV-1a, so channels hash the same way in every session
+uint64_t hashChannel(const QString &channelName)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (auto c : channelName)
+    {
+        hash ^= c.unicode();
+        hash *= 0x100000001b3ULL;
+    }
+    return splitmix64(hash);
+}
+
+}  // namespace
+
+namespace chatterino {
+
+ReadConnectionRing::ReadConnectionRing(size_t capacity)
+    : capacity_(std::max<size_t>(capacity, 1))
+{
+    this->addConnection();
+}
+
+size_t ReadConnectionRing::assign(const QString &channelName)
+{
+    if (auto it = this->assignments_.find(channelName);
+        it != this->assignments_.end())
+    {
+        return it->second;
+    }
+
+    if (this->assignments_.size() >= this->loads_.size() * this->capacity_)
+    {
+        this->addConnection();
+    }
+
+    return this->place(channelName);
+}
+
+void ReadConnectionRing::remove(const QString &channelName)
+{
+    auto it = this->assignments_.find(channelName);
+    if (it == this->assignments_.end())
+    {
+        return;
+    }
+
+    this->loads_[it->second]--;
+    this->assignments_.erase(it);
+
+    while (this->loads_.size() > 1 && this->loads_.back() == 0)
+    {
+        this->removeConnection();
+    }
+}
+
+void ReadConnectionRing::rebalance()
+{
+    std::vector<QString> channels;
+    channels.reserve(this->assignments_.size());
+    for (const auto &[channelName, connection] : this->assignments_)
+    {
+        (void)connection;
+        channels.push_back(channelName);
+    }
+    // The order decides which channels are pushed past a full connection,
+    // sort to place them the same way every time
+    std::sort(channels.begin(), channels.end());
+
+    this->assignments_.clear();
+    this->ring_.clear();
+    this->loads_.clear();
+
+    auto needed = std::max<size_t>(
+        1, (channels.size() + this->capacity_ - 1) / this->capacity_);
+    while (this->loads_.size() < needed)
+    {
+        this->addConnection();
+    }
+
+    for (const auto &channelName : channels)
+    {
+        this->place(channelName);
+    }
+}
+
+size_t ReadConnectionRing::place(const QString &channelName)
+{
+    // Walk clockwise until we find a connection that isn't full
+    auto it = this->ring_.lower_bound(hashChannel(channelName));
+    while (true)
+    {
+        if (it == this->ring_.end())
+        {
+            it = this->ring_.begin();
+        }
+        if (this->loads_[it->second] < this->capacity_)
+        {
+            break;
+        }
+        ++it;
+    }
+
+    auto connection = it->second;
+    this->loads_[connection]++;
+    this->assignments_.emplace(channelName, connection);
+    return connection;
+}
+
+std::optional<size_t> ReadConnectionRing::find(
+    const QString &channelName) const
+{
+    auto it = this->assignments_.find(channelName);
+    if (it == this->assignments_.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::vector<QString> ReadConnectionRing::channelsOf(size_t connection) const
+{
+    std::vector<QString> channels;
+    for (const auto &[channelName, assigned] : this->assignments_)
+    {
+        if (assigned == connection)
+        {
+            channels.push_back(channelName);
+        }
+    }
+    return channels;
+}
+
+size_t ReadConnectionRing::connectionCount() const
+{
+    return this->loads_.size();
+}
+
+size_t ReadConnectionRing::capacity() const
+{
+    return this->capacity_;
+}
+
+size_t ReadConnectionRing::load(size_t connection) const
+{
+    return this->loads_.at(connection);
+}
+
+void ReadConnectionRing::addConnection()
+{
+    auto connection = this->loads_.size();
+    this->loads_.push_back(0);
+
+    for (size_t i = 0; i < VIRTUAL_NODES; i++)
+    {
+        auto point = splitmix64((static_cast<uint64_t>(connection) << 32) | i);
+        // On the rare collision, the older connection keeps the point
+        this->ring_.emplace(point, connection);
+    }
+}
+
+void ReadConnectionRing::removeConnection()
+{
+    assert(this->loads_.size() > 1 && this->loads_.back() == 0);
+
+    auto connection = this->loads_.size() - 1;
+    std::erase_if(this->ring_, [&](const auto &point) {
+        return point.second == connection;
+    });
+    this->loads_.pop_back();
+}
+
+}  // namespace chatterino
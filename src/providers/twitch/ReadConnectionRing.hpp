@@ -0,0 +1,76 @@
+#pragma once
+
+#include "util/QStringHash.hpp"
+
+#include <QString>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+/**
+ * @brief Assigns channels to read connections.
+ *
+ * Channels are placed with consistent hashing with bounded loads: every
+ * connection owns VIRTUAL_NODES points on a hash ring, and a channel goes to
+ * the first connection clockwise from its hash that has fewer than `capacity`
+ * channels.
+ *
+ * rebalance() is called while all connections are closed. It creates
+ * ceil(channels / capacity) connections and places every channel on the ring.
+ *
+ * Between rebalances, assignments are sticky. A new channel goes to the
+ * first connection on the ring with room, and a connection is only added once
+ * all connections are full. Channels never move, so a channel only has to be
+ * rejoined when its own connection reconnects.
+ */
+class ReadConnectionRing
+{
+public:
+    static constexpr size_t VIRTUAL_NODES = 64;
+
+    explicit ReadConnectionRing(size_t capacity);
+
+    /// Returns the connection of `channelName`, assigning one if the channel
+    /// has none yet. This may add a connection.
+    size_t assign(const QString &channelName);
+
+    /// Removes the assignment of `channelName`. Empty connections at the end
+    /// are removed.
+    void remove(const QString &channelName);
+
+    /// Recreates ceil(channels / capacity) connections and places all
+    /// channels on the ring again. This moves channels, so it must only be
+    /// called while no connection is open.
+    void rebalance();
+
+    std::optional<size_t> find(const QString &channelName) const;
+
+    /// Returns the channels assigned to `connection`
+    std::vector<QString> channelsOf(size_t connection) const;
+
+    size_t connectionCount() const;
+    size_t capacity() const;
+
+    /// Returns the amount of channels assigned to `connection`
+    size_t load(size_t connection) const;
+
+private:
+    /// Places `channelName` on the first connection with room, starting at
+    /// its hash. There must be a connection with room.
+    size_t place(const QString &channelName);
+    void addConnection();
+    void removeConnection();
+
+    size_t capacity_;
+    std::map<uint64_t, size_t> ring_;
+    std::vector<size_t> loads_;
+    std::unordered_map<QString, size_t> assignments_;
+};
+
+}  // namespace chatterino
@@ -8,6 +8,7 @@
 #include "common/network/NetworkResult.hpp"
 #include "common/QLogging.hpp"
 #include "controllers/accounts/AccountController.hpp"
+#include "controllers/completion/CompletionUsage.hpp"
 #include "controllers/notifications/NotificationController.hpp"
 #include "controllers/twitch/LiveController.hpp"
 #include "debug/AssertInGuiThread.hpp"
@@ -24,6 +25,7 @@
 #include "providers/ffz/FfzBadges.hpp"
 #include "providers/ffz/FfzEmotes.hpp"
 #include "providers/recentmessages/Api.hpp"
+#include "providers/recentmessages/Impl.hpp"
 #include "providers/seventv/eventapi/Dispatch.hpp"
 #include "providers/seventv/SeventvAPI.hpp"
 #include "providers/seventv/SeventvEmotes.hpp"
@@ -38,6 +40,9 @@
 #include "providers/twitch/TwitchIrcServer.hpp"
 #include "providers/twitch/TwitchUsers.hpp"
 #include "singletons/Emotes.hpp"
+#include "singletons/helper/LoggingChannel.hpp"
+#include "singletons/helper/StructuredLog.hpp"
+#include "singletons/Paths.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/StreamerMode.hpp"
 #include "singletons/Toasts.hpp"
@@ -49,12 +54,14 @@
 #include "widgets/Window.hpp"
 
 #include <IrcConnection>
+#include <QDir>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonValue>
 #include <QStringBuilder>
 #include <QThread>
+#include <QtConcurrent>
 #include <QTimer>
 #include <rapidjson/document.h>
 
@@ -95,6 +102,9 @@ namespace {
 
     // From Twitch docs - expected size for a badge (1x)
     constexpr QSize BASE_BADGE_SIZE(18, 18);
+
+    // Amount of most-used words to look up when prefetching emote images
+    constexpr size_t PREFETCH_EMOTE_COUNT = 25;
 }  // namespace
 
 TwitchChannel::TwitchChannel(const QString &name, bool isWatching)
@@ -125,6 +135,18 @@ TwitchChannel::TwitchChannel(const QString &name, bool isWatching)
         this->refreshPubSub();
     });
 
+    // We can safely ignore this signal connection since it's our own signal
+    std::ignore = this->messageAppended.connect([this](auto &message, auto) {
+        if (message->flags.has(MessageFlag::System) ||
+            !message->serverReceivedTime.isValid())
+        {
+            return;
+        }
+        this->lastMessageReceivedAt_ = std::chrono::system_clock::time_point(
+            std::chrono::milliseconds(
+                message->serverReceivedTime.toMSecsSinceEpoch()));
+    });
+
     // We can safely ignore this signal connection this has no external dependencies - once the signal
     // is destroyed, it will no longer be able to fire
     std::ignore = this->joined.connect([this]() {
@@ -335,6 +357,7 @@ void TwitchChannel::refreshBTTVChannelEmotes(bool manualRefresh)
         [this, weak = weakOf<Channel>(this)](auto &&emoteMap) {
             if (auto shared = weak.lock())
             {
+                this->prefetchFrequentEmotes(emoteMap);
                 this->setBttvEmotes(std::make_shared<const EmoteMap>(emoteMap));
             }
         },
@@ -354,6 +377,7 @@ void TwitchChannel::refreshFFZChannelEmotes(bool manualRefresh)
         [this, weak = weakOf<Channel>(this)](auto &&emoteMap) {
             if (auto shared = weak.lock())
             {
+                this->prefetchFrequentEmotes(emoteMap);
                 this->setFfzEmotes(std::make_shared<const EmoteMap>(emoteMap));
             }
         },
@@ -396,6 +420,7 @@ void TwitchChannel::refreshSevenTVChannelEmotes(bool manualRefresh)
                                              auto channelInfo) {
             if (auto shared = weak.lock())
             {
+                this->prefetchFrequentEmotes(emoteMap);
                 this->setSeventvEmotes(
                     std::make_shared<const EmoteMap>(emoteMap));
                 this->updateSeventvData(channelInfo.userID,
@@ -422,6 +447,25 @@ void TwitchChannel::setSeventvEmotes(std::shared_ptr<const EmoteMap> &&map)
     this->seventvEmotes_.set(std::move(map));
 }
 
+void TwitchChannel::prefetchFrequentEmotes(const EmoteMap &emotes) const
+{
+    auto *usage = getApp()->getCompletionUsage();
+    if (usage == nullptr)
+    {
+        return;
+    }
+
+    for (const auto &word : usage->topWords(this->getName(),
+                                            PREFETCH_EMOTE_COUNT))
+    {
+        auto it = emotes.find(EmoteName{word});
+        if (it != emotes.end())
+        {
+            it->second->images.getImage1()->load(NetworkPriority::Background);
+        }
+    }
+}
+
 void TwitchChannel::addQueuedRedemption(const QString &rewardId,
                                         const QString &originalContent,
                                         Communi::IrcMessage *message)
@@ -1281,7 +1325,7 @@ void TwitchChannel::messageRemovedFromStart(const MessagePtr &msg)
     {
         if (msg->replyThread->liveCount(msg) == 0)
         {
-            this->threads_.erase(msg->replyThread->rootId());
+            this->threads_.access()->erase(msg->replyThread->rootId());
         }
     }
 }
@@ -1344,6 +1388,8 @@ void TwitchChannel::markDisconnected()
 
 void TwitchChannel::loadRecentMessages()
 {
+    this->backfillFromLogs();
+
     if (!getSettings()->loadTwitchMessageHistoryOnConnect)
     {
         return;
@@ -1357,7 +1403,8 @@ void TwitchChannel::loadRecentMessages()
     auto weak = weakOf<Channel>(this);
     recentmessages::load(
         this->getName(), weak,
-        [weak](const auto &messages) {
+        [weak, firstChunk = std::make_shared<bool>(true)](
+            const auto &messages, bool done) {
             auto shared = weak.lock();
             if (!shared)
             {
@@ -1370,8 +1417,21 @@ void TwitchChannel::loadRecentMessages()
                 return;
             }
 
-            tc->addMessagesAtStart(messages);
-            tc->loadingRecentMessages_.clear();
+            // Later chunks are newer than the first one, but older than the
+            // messages received since joining
+            if (*firstChunk && !tc->backfilledFromLogs_)
+            {
+                tc->addMessagesAtStart(messages);
+            }
+            else
+            {
+                tc->fillInMissingMessages(messages);
+            }
+            *firstChunk = false;
+            if (done)
+            {
+                tc->loadingRecentMessages_.clear();
+            }
 
             std::vector<MessagePtr> msgs;
             for (const auto &msg : messages)
@@ -1408,6 +1468,67 @@ void TwitchChannel::loadRecentMessages()
         std::nullopt, false);
 }
 
+void TwitchChannel::backfillFromLogs()
+{
+    if (!getSettings()->backfillFromStructuredLogs ||
+        !getSettings()->enableLogging || this->backfilledFromLogs_)
+    {
+        return;
+    }
+
+    QString base = getSettings()->logPath.getValue();
+    if (base.isEmpty())
+    {
+        base = getApp()->getPaths().messageLogDirectory;
+    }
+    auto directory =
+        base + QDir::separator() +
+        LoggingChannel::subDirectoryFor(this->getName(), this->getPlatform());
+    auto limit = static_cast<size_t>(
+        getSettings()->twitchMessageHistoryLimit.getValue());
+
+    // lastDate_ is only touched on the GUI thread, the worker builds with a
+    // copy and the result is written back with the messages
+    std::ignore = QtConcurrent::run([weak = weakOf<Channel>(this), directory,
+                                     channelName = this->getName(), limit,
+                                     lastDate = this->lastDate_]() mutable {
+        auto records = readStructuredLogTail(
+            findStructuredLogs(directory, channelName), limit);
+        if (records.empty())
+        {
+            return;
+        }
+
+        auto shared = weak.lock();
+        if (!shared)
+        {
+            return;
+        }
+
+        // build the logged messages like recent messages
+        auto parsed =
+            recentmessages::detail::parseStructuredLogRecords(records);
+        auto messages = recentmessages::detail::buildRecentMessages(
+            parsed, shared.get(), lastDate);
+
+        postToThread([shared = std::move(shared),
+                      messages = std::move(messages), lastDate] {
+            auto *tc = dynamic_cast<TwitchChannel *>(shared.get());
+            if (!tc)
+            {
+                return;
+            }
+
+            qCDebug(chatterinoTwitch)
+                << "Backfilled" << messages.size() << "messages in"
+                << tc->getName() << "from logs";
+            tc->lastDate_ = lastDate;
+            tc->fillInMissingMessages(messages);
+            tc->backfilledFromLogs_ = true;
+        });
+    });
+}
+
 void TwitchChannel::loadRecentMessagesReconnect()
 {
     if (!getSettings()->loadTwitchMessageHistoryOnConnect)
@@ -1420,16 +1541,22 @@ void TwitchChannel::loadRecentMessagesReconnect()
         return;  // already loading
     }
 
+    // Only request the messages we missed, i.e. the ones after the last
+    // message we received
+    const auto after = this->lastMessageReceivedAt_.has_value()
+                           ? this->lastMessageReceivedAt_
+                           : this->lastConnectedAt_;
+
     const auto now = std::chrono::system_clock::now();
     int limit = getSettings()->twitchMessageHistoryLimit.getValue();
-    if (this->lastConnectedAt_.has_value())
+    if (after.has_value())
     {
         // calculate how many messages could have occured
         // while we were not connected to the channel
         // assuming a maximum of 10 messages per second
         const auto secondsSinceDisconnect =
-            std::chrono::duration_cast<std::chrono::seconds>(
-                now - this->lastConnectedAt_.value())
+            std::chrono::duration_cast<std::chrono::seconds>(now -
+                                                             after.value())
                 .count();
         limit =
             std::min(static_cast<int>(secondsSinceDisconnect + 1) * 10, limit);
@@ -1438,7 +1565,7 @@ void TwitchChannel::loadRecentMessagesReconnect()
     auto weak = weakOf<Channel>(this);
     recentmessages::load(
         this->getName(), weak,
-        [weak](const auto &messages) {
+        [weak](const auto &messages, bool done) {
             auto shared = weak.lock();
             if (!shared)
             {
@@ -1452,7 +1579,10 @@ void TwitchChannel::loadRecentMessagesReconnect()
             }
 
             tc->fillInMissingMessages(messages);
-            tc->loadingRecentMessages_.clear();
+            if (done)
+            {
+                tc->loadingRecentMessages_.clear();
+            }
         },
         [weak]() {
             auto shared = weak.lock();
@@ -1469,7 +1599,7 @@ void TwitchChannel::loadRecentMessagesReconnect()
 
             tc->loadingRecentMessages_.clear();
         },
-        limit, this->lastConnectedAt_, now, true);
+        limit, after, now, true);
 }
 
 void TwitchChannel::refreshPubSub()
@@ -1558,13 +1688,19 @@ void TwitchChannel::refreshChatters()
 
 void TwitchChannel::addReplyThread(const std::shared_ptr<MessageThread> &thread)
 {
-    this->threads_[thread->rootId()] = thread;
+    (*this->threads_.access())[thread->rootId()] = thread;
 }
 
-const std::unordered_map<QString, std::weak_ptr<MessageThread>> &
-    TwitchChannel::threads() const
+std::shared_ptr<MessageThread> TwitchChannel::findReplyThread(
+    const QString &rootID) const
 {
-    return this->threads_;
+    auto threads = this->threads_.access();
+    auto it = threads->find(rootID);
+    if (it == threads->end())
+    {
+        return nullptr;
+    }
+    return it->second.lock();
 }
 
 std::shared_ptr<MessageThread> TwitchChannel::getOrCreateThread(
@@ -1572,21 +1708,22 @@ std::shared_ptr<MessageThread> TwitchChannel::getOrCreateThread(
 {
     assert(message != nullptr);
 
-    auto threadIt = this->threads_.find(message->id);
-    if (threadIt != this->threads_.end() && !threadIt->second.expired())
+    auto threads = this->threads_.access();
+    auto threadIt = threads->find(message->id);
+    if (threadIt != threads->end() && !threadIt->second.expired())
     {
         return threadIt->second.lock();
     }
 
     auto thread = std::make_shared<MessageThread>(message);
-    this->addReplyThread(thread);
+    (*threads)[thread->rootId()] = thread;
     return thread;
 }
 
 void TwitchChannel::cleanUpReplyThreads()
 {
-    for (auto it = this->threads_.begin(), last = this->threads_.end();
-         it != last;)
+    auto threads = this->threads_.access();
+    for (auto it = threads->begin(), last = threads->end(); it != last;)
     {
         bool doErase = true;
         if (auto thread = it->second.lock())
@@ -1596,7 +1733,7 @@ void TwitchChannel::cleanUpReplyThreads()
 
         if (doErase)
         {
-            it = this->threads_.erase(it);
+            it = threads->erase(it);
         }
         else
         {
@@ -271,8 +271,11 @@ public:
      * TwitchChannel instance will store a weak_ptr to the thread.
      */
     void addReplyThread(const std::shared_ptr<MessageThread> &thread);
-    const std::unordered_map<QString, std::weak_ptr<MessageThread>> &threads()
-        const;
+
+    /// Returns the thread started by the message with `rootID`, or nullptr if
+    /// there's none. Like addReplyThread, this may be called from any thread,
+    /// since recent messages are built on a thread pool.
+    std::shared_ptr<MessageThread> findReplyThread(const QString &rootID) const;
 
     /**
      * Get the thread for the given message
@@ -355,6 +358,8 @@ private:
     void refreshCheerEmotes();
     void loadRecentMessages();
     void loadRecentMessagesReconnect();
+    /// Adds the newest messages from the structured logs of this channel
+    void backfillFromLogs();
     void cleanUpReplyThreads();
     void showLoginMessage();
 
@@ -371,6 +376,10 @@ private:
     void updateSevenTVActivity();
     void listenSevenTVCosmetics() const;
 
+    /// Starts loading the images of the emotes in `emotes` that the user sends
+    /// most often in this channel.
+    void prefetchFrequentEmotes(const EmoteMap &emotes) const;
+
     /**
      * @brief Sets the live status of this Twitch channel
      *
@@ -439,8 +448,16 @@ private:
     bool disconnected_{};
     std::optional<std::chrono::time_point<std::chrono::system_clock>>
         lastConnectedAt_{};
+    /// Server time of the newest live message, history after a reconnect is
+    /// only loaded from here on
+    std::optional<std::chrono::time_point<std::chrono::system_clock>>
+        lastMessageReceivedAt_{};
     std::atomic_flag loadingRecentMessages_ = ATOMIC_FLAG_INIT;
-    std::unordered_map<QString, std::weak_ptr<MessageThread>> threads_;
+    /// Set once messages from the logs were added. Recent messages are merged
+    /// into these instead of being added at the start.
+    bool backfilledFromLogs_ = false;
+    UniqueAccess<std::unordered_map<QString, std::weak_ptr<MessageThread>>>
+        threads_;
 
 protected:
     void messageRemovedFromStart(const MessagePtr &msg) override;
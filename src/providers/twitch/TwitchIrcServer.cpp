@@ -22,9 +22,11 @@
 #include "providers/twitch/pubsubmessages/AutoMod.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
+#include "singletons/Logging.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/StreamerMode.hpp"
 #include "singletons/WindowManager.hpp"
+#include "util/DebugCount.hpp"
 #include "util/PostToThread.hpp"
 #include "util/RatelimitBucket.hpp"
 #include "util/Twitch.hpp"
@@ -35,10 +37,12 @@
 #include <pajlada/signals/signalholder.hpp>
 #include <QCoreApplication>
 #include <QMetaEnum>
+#include <QTimer>
 
 #include <cassert>
 #include <functional>
 #include <mutex>
+#include <utility>
 
 using namespace std::chrono_literals;
 
@@ -48,6 +52,10 @@ namespace {
 constexpr int JOIN_RATELIMIT_BUDGET = 18;
 constexpr int JOIN_RATELIMIT_COOLDOWN = 12500;
 
+/// Channels joined at once are sent as one `JOIN #a,#b` line. IRC lines are
+/// limited to 512 bytes including tags and the line ending.
+constexpr qsizetype MAX_JOIN_LINE_LENGTH = 500;
+
 using namespace chatterino;
 
 void sendHelixMessage(const std::shared_ptr<TwitchChannel> &channel,
@@ -158,6 +166,8 @@ TwitchIrcServer::TwitchIrcServer()
     , liveChannel(new Channel("/live", Channel::Type::TwitchLive))
     , automodChannel(new Channel("/automod", Channel::Type::TwitchAutomod))
     , watchingChannel(Channel::getEmpty(), Channel::Type::TwitchWatching)
+    , readRing_(static_cast<size_t>(std::max(
+          1, getSettings()->twitchChannelsPerReadConnection.getValue())))
 {
     // Initialize the connections
     // XXX: don't create write connection if there is no separate write connection.
@@ -171,7 +181,8 @@ TwitchIrcServer::TwitchIrcServer()
         {
             return;
         }
-        this->readConnection_->sendRaw("JOIN #" + message);
+
+        this->queueJoin(message);
     };
     this->joinBucket_.reset(new RatelimitBucket(
         JOIN_RATELIMIT_BUDGET, JOIN_RATELIMIT_COOLDOWN, actuallyJoin, this));
@@ -192,44 +203,7 @@ TwitchIrcServer::TwitchIrcServer()
             this->writeConnection_->smartReconnect();
         });
 
-    // Listen to read connection message signals
-    this->readConnection_.reset(new IrcConnection);
-    this->readConnection_->moveToThread(QCoreApplication::instance()->thread());
-
-    QObject::connect(this->readConnection_.get(),
-                     &Communi::IrcConnection::messageReceived, this,
-                     [this](auto msg) {
-                         this->readConnectionMessageReceived(msg);
-                     });
-    QObject::connect(this->readConnection_.get(),
-                     &Communi::IrcConnection::privateMessageReceived, this,
-                     [this](auto msg) {
-                         this->privateMessageReceived(msg);
-                     });
-    QObject::connect(this->readConnection_.get(),
-                     &Communi::IrcConnection::connected, this, [this] {
-                         this->onReadConnected(this->readConnection_.get());
-                     });
-    QObject::connect(this->readConnection_.get(),
-                     &Communi::IrcConnection::disconnected, this, [this] {
-                         this->onDisconnected();
-                     });
-    this->connections_.managedConnect(
-        this->readConnection_->connectionLost, [this](bool timeout) {
-            qCDebug(chatterinoIrc)
-                << "Read connection reconnect requested. Timeout:" << timeout;
-            if (timeout)
-            {
-                // Show additional message since this is going to interrupt a
-                // connection that is still "connected"
-                this->addGlobalSystemMessage(
-                    "Server connection timed out, reconnecting");
-            }
-            this->readConnection_->smartReconnect();
-        });
-    this->connections_.managedConnect(this->readConnection_->heartbeat, [this] {
-        this->markChannelsConnected();
-    });
+    this->syncReadConnections();
 }
 
 void TwitchIrcServer::initialize()
@@ -817,7 +791,9 @@ void TwitchIrcServer::initializeConnection(IrcConnection *connection,
     connection->setPort(Env::get().twitchServerPort);
     connection->setSecure(Env::get().twitchServerSecure);
 
-    this->open(type);
+    // Not locked: open() emits statusChanged right away, which takes
+    // connectionMutex_
+    connection->open();
 }
 
 std::shared_ptr<Channel> TwitchIrcServer::createChannel(
@@ -863,6 +839,8 @@ void TwitchIrcServer::privateMessageReceived(
 void TwitchIrcServer::readConnectionMessageReceived(
     Communi::IrcMessage *message)
 {
+    this->logRawMessage(message);
+
     if (message->type() == Communi::IrcMessage::Type::Private)
     {
         // We already have a handler for private messages
@@ -915,11 +893,46 @@ void TwitchIrcServer::readConnectionMessageReceived(
     }
     else if (command == "RECONNECT")
     {
-        this->addGlobalSystemMessage(
+        // Only this connection has to reconnect, the others keep their
+        // channels joined
+        auto *connection = dynamic_cast<IrcConnection *>(message->connection());
+        if (connection == nullptr)
+        {
+            return;
+        }
+
+        this->addSystemMessageTo(
+            connection,
             "Twitch Servers requested us to reconnect, reconnecting");
-        this->markChannelsConnected();
-        this->connect();
+        this->markChannelsConnected(connection);
+        connection->close();
+        this->initializeConnection(connection, ConnectionType::Read);
+    }
+}
+
+void TwitchIrcServer::logRawMessage(Communi::IrcMessage *message)
+{
+    static const QStringList loggedCommands{
+        "PRIVMSG",
+        "USERNOTICE",
+        "CLEARCHAT",
+        "CLEARMSG",
+    };
+
+    if (!getSettings()->enableStructuredLogs ||
+        !loggedCommands.contains(message->command()))
+    {
+        return;
+    }
+
+    auto target = message->parameter(0);
+    if (!target.startsWith('#'))
+    {
+        return;
     }
+
+    getApp()->getChatLogger()->addRawMessage(target.mid(1),
+                                             message->toData(), "twitch");
 }
 
 void TwitchIrcServer::writeConnectionMessageReceived(
@@ -951,21 +964,7 @@ void TwitchIrcServer::writeConnectionMessageReceived(
 
 void TwitchIrcServer::onReadConnected(IrcConnection *connection)
 {
-    (void)connection;
-
-    std::vector<ChannelPtr> activeChannels;
-    {
-        std::lock_guard lock(this->channelMutex);
-
-        activeChannels.reserve(this->channels.size());
-        for (const auto &weak : this->channels)
-        {
-            if (auto channel = weak.lock())
-            {
-                activeChannels.push_back(channel);
-            }
-        }
-    }
+    auto activeChannels = this->channelsOf(connection);
 
     // put the visible channels first
     auto visible = getApp()->getWindows()->getVisibleChannelNames();
@@ -988,15 +987,11 @@ void TwitchIrcServer::onReadConnected(IrcConnection *connection)
 
     for (const auto &chan : activeChannels)
     {
-        LimitedQueueSnapshot<MessagePtr> snapshot = chan->getMessageSnapshot();
-
-        bool replaceMessage =
-            snapshot.size() > 0 && snapshot[snapshot.size() - 1]->flags.has(
-                                       MessageFlag::DisconnectedMessage);
-
-        if (replaceMessage)
+        auto last = chan->getLastMessage();
+        if (last &&
+            last->second->flags.has(MessageFlag::DisconnectedMessage))
         {
-            chan->replaceMessage(snapshot[snapshot.size() - 1], reconnected);
+            chan->replaceMessage(last->first, last->second, reconnected);
         }
         else
         {
@@ -1005,6 +1000,7 @@ void TwitchIrcServer::onReadConnected(IrcConnection *connection)
     }
 
     this->falloffCounter_ = 1;
+    this->updateReadConnectionStats(connection);
 }
 
 void TwitchIrcServer::onWriteConnected(IrcConnection *connection)
@@ -1012,22 +1008,14 @@ void TwitchIrcServer::onWriteConnected(IrcConnection *connection)
     (void)connection;
 }
 
-void TwitchIrcServer::onDisconnected()
+void TwitchIrcServer::onDisconnected(IrcConnection *connection)
 {
-    std::lock_guard<std::mutex> lock(this->channelMutex);
-
     MessageBuilder b(systemMessage, "disconnected");
     b->flags.set(MessageFlag::DisconnectedMessage);
     auto disconnectedMsg = b.release();
 
-    for (std::weak_ptr<Channel> &weak : this->channels.values())
+    for (const auto &chan : this->channelsOf(connection))
     {
-        std::shared_ptr<Channel> chan = weak.lock();
-        if (!chan)
-        {
-            continue;
-        }
-
         chan->addMessage(disconnectedMsg, MessageContext::Original);
 
         if (auto *channel = dynamic_cast<TwitchChannel *>(chan.get()))
@@ -1035,6 +1023,8 @@ void TwitchIrcServer::onDisconnected()
             channel->markDisconnected();
         }
     }
+
+    this->updateReadConnectionStats(connection);
 }
 
 std::shared_ptr<Channel> TwitchIrcServer::getCustomChannel(
@@ -1447,14 +1437,242 @@ void TwitchIrcServer::dropSeventvChannel(const QString &userID,
     }
 }
 
-void TwitchIrcServer::markChannelsConnected()
+void TwitchIrcServer::markChannelsConnected(IrcConnection *connection)
 {
-    this->forEachChannel([](const ChannelPtr &chan) {
+    for (const auto &chan : this->channelsOf(connection))
+    {
         if (auto *channel = dynamic_cast<TwitchChannel *>(chan.get()))
         {
             channel->markConnected();
         }
+    }
+}
+
+void TwitchIrcServer::queueJoin(const QString &channelName)
+{
+    std::lock_guard lock(this->connectionMutex_);
+
+    auto index = this->readRing_.find(channelName);
+    if (!index || *index >= this->readConnections_.size())
+    {
+        return;
+    }
+    this->readConnections_[*index]->pendingJoins.append(channelName);
+
+    // The join bucket releases as many channels as its budget allows at once,
+    // these are all sent in one JOIN
+    if (!this->joinFlushScheduled_)
+    {
+        this->joinFlushScheduled_ = true;
+        QTimer::singleShot(0, this, [this] {
+            this->flushJoins();
+        });
+    }
+}
+
+void TwitchIrcServer::flushJoins()
+{
+    std::lock_guard lock(this->connectionMutex_);
+
+    this->joinFlushScheduled_ = false;
+    for (auto &read : this->readConnections_)
+    {
+        auto channels = std::exchange(read->pendingJoins, {});
+        if (channels.isEmpty() || !read->connected)
+        {
+            // Channels are joined again once the connection is back
+            continue;
+        }
+
+        QString line = u"JOIN"_s;
+        for (const auto &channel : channels)
+        {
+            if (line.size() > 4 &&
+                line.size() + channel.size() + 2 > MAX_JOIN_LINE_LENGTH)
+            {
+                read->connection->sendRaw(line);
+                line = u"JOIN"_s;
+            }
+            line += (line.size() > 4 ? u",#"_s : u" #"_s) + channel;
+        }
+        read->connection->sendRaw(line);
+    }
+}
+
+void TwitchIrcServer::addReadConnection()
+{
+    auto read = std::make_unique<ReadConnection>();
+    read->connection.reset(new IrcConnection);
+    read->connection->moveToThread(QCoreApplication::instance()->thread());
+    read->debugName =
+        u"IRC read connection #%1"_s.arg(this->readConnections_.size() + 1);
+
+    auto *connection = read->connection.get();
+    auto *stats = read.get();
+
+    QObject::connect(connection, &Communi::IrcConnection::messageReceived, this,
+                     [this, stats](auto msg) {
+                         stats->messages++;
+                         this->readConnectionMessageReceived(msg);
+                     });
+    QObject::connect(connection,
+                     &Communi::IrcConnection::privateMessageReceived, this,
+                     [this](auto msg) {
+                         this->privateMessageReceived(msg);
+                     });
+    QObject::connect(connection, &Communi::IrcConnection::statusChanged, this,
+                     [this, stats](auto status) {
+                         std::lock_guard lock(this->connectionMutex_);
+                         stats->connected =
+                             status == Communi::IrcConnection::Connected;
+                     });
+    QObject::connect(connection, &Communi::IrcConnection::connected, this,
+                     [this, connection] {
+                         this->onReadConnected(connection);
+                     });
+    QObject::connect(connection, &Communi::IrcConnection::disconnected, this,
+                     [this, connection] {
+                         this->onDisconnected(connection);
+                     });
+    read->signalHolder.managedConnect(
+        connection->connectionLost, [this, connection, stats](bool timeout) {
+            qCDebug(chatterinoIrc)
+                << stats->debugName
+                << "reconnect requested. Timeout:" << timeout;
+            if (timeout)
+            {
+                // Show additional message since this is going to interrupt a
+                // connection that is still "connected"
+                this->addSystemMessageTo(
+                    connection, "Server connection timed out, reconnecting");
+            }
+            stats->reconnects++;
+            connection->smartReconnect();
+        });
+    read->signalHolder.managedConnect(connection->heartbeat, [this,
+                                                              connection] {
+        this->markChannelsConnected(connection);
+        this->updateReadConnectionStats(connection);
     });
+
+    this->readConnections_.push_back(std::move(read));
+}
+
+std::vector<IrcConnection *> TwitchIrcServer::syncReadConnections()
+{
+    std::vector<IrcConnection *> added;
+    while (this->readConnections_.size() < this->readRing_.connectionCount())
+    {
+        this->addReadConnection();
+        added.push_back(this->readConnections_.back()->connection.get());
+    }
+
+    while (this->readConnections_.size() > this->readRing_.connectionCount())
+    {
+        auto &read = this->readConnections_.back();
+        qCDebug(chatterinoIrc) << "Closing unused" << read->debugName;
+
+        QObject::disconnect(read->connection.get(), nullptr, this, nullptr);
+        read->connection->close();
+        DebugCount::set(read->debugName + " channels", 0);
+        DebugCount::set(read->debugName + " connected", 0);
+
+        this->readConnections_.pop_back();
+    }
+
+    return added;
+}
+
+std::vector<IrcConnection *> TwitchIrcServer::readConnections()
+{
+    std::lock_guard lock(this->connectionMutex_);
+
+    std::vector<IrcConnection *> connections;
+    connections.reserve(this->readConnections_.size());
+    for (const auto &read : this->readConnections_)
+    {
+        connections.push_back(read->connection.get());
+    }
+    return connections;
+}
+
+IrcConnection *TwitchIrcServer::readConnectionOf(const QString &channelName)
+{
+    auto index = this->readRing_.find(channelName);
+    if (!index || *index >= this->readConnections_.size())
+    {
+        return nullptr;
+    }
+    return this->readConnections_[*index]->connection.get();
+}
+
+std::optional<size_t> TwitchIrcServer::readConnectionIndex(
+    IrcConnection *connection) const
+{
+    for (size_t i = 0; i < this->readConnections_.size(); i++)
+    {
+        if (this->readConnections_[i]->connection.get() == connection)
+        {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
+std::vector<ChannelPtr> TwitchIrcServer::channelsOf(IrcConnection *connection)
+{
+    std::vector<QString> names;
+    {
+        std::lock_guard lock(this->connectionMutex_);
+        auto index = this->readConnectionIndex(connection);
+        if (!index)
+        {
+            return {};
+        }
+        names = this->readRing_.channelsOf(*index);
+    }
+
+    std::lock_guard lock(this->channelMutex);
+
+    std::vector<ChannelPtr> channels;
+    channels.reserve(names.size());
+    for (const auto &name : names)
+    {
+        if (auto channel = this->channels.value(name).lock())
+        {
+            channels.push_back(std::move(channel));
+        }
+    }
+    return channels;
+}
+
+void TwitchIrcServer::addSystemMessageTo(IrcConnection *connection,
+                                         const QString &messageText)
+{
+    auto message = makeSystemMessage(messageText);
+    for (const auto &chan : this->channelsOf(connection))
+    {
+        chan->addMessage(message, MessageContext::Original);
+    }
+}
+
+void TwitchIrcServer::updateReadConnectionStats(IrcConnection *connection)
+{
+    std::lock_guard lock(this->connectionMutex_);
+
+    auto index = this->readConnectionIndex(connection);
+    if (!index)
+    {
+        return;
+    }
+
+    const auto &read = this->readConnections_[*index];
+    DebugCount::set(read->debugName + " channels",
+                    static_cast<int64_t>(this->readRing_.load(*index)));
+    DebugCount::set(read->debugName + " connected",
+                    connection->isConnected() ? 1 : 0);
+    DebugCount::set(read->debugName + " messages", read->messages);
+    DebugCount::set(read->debugName + " reconnects", read->reconnects);
 }
 
 void TwitchIrcServer::addFakeMessage(const QString &data)
@@ -1462,7 +1680,7 @@ void TwitchIrcServer::addFakeMessage(const QString &data)
     assertInGuiThread();
 
     auto *fakeMessage = Communi::IrcMessage::fromData(
-        data.toUtf8(), this->readConnection_.get());
+        data.toUtf8(), this->readConnections_.front()->connection.get());
 
     if (fakeMessage->command() == "PRIVMSG")
     {
@@ -1516,17 +1734,36 @@ void TwitchIrcServer::connect()
 
     this->disconnect();
 
+    {
+        std::lock_guard lock(this->connectionMutex_);
+        this->connectRequested_ = true;
+
+        // All connections are closed, so channels can move without a rejoin
+        this->readRing_.rebalance();
+        this->syncReadConnections();
+    }
+
     this->initializeConnection(this->writeConnection_.get(),
                                ConnectionType::Write);
-    this->initializeConnection(this->readConnection_.get(),
-                               ConnectionType::Read);
+    for (auto *connection : this->readConnections())
+    {
+        this->initializeConnection(connection, ConnectionType::Read);
+    }
 }
 
 void TwitchIrcServer::disconnect()
 {
-    std::lock_guard<std::mutex> locker(this->connectionMutex_);
+    {
+        std::lock_guard<std::mutex> locker(this->connectionMutex_);
+        this->connectRequested_ = false;
+    }
 
-    this->readConnection_->close();
+    // close() emits statusChanged and disconnected right away, their
+    // handlers take connectionMutex_
+    for (auto *connection : this->readConnections())
+    {
+        connection->close();
+    }
     this->writeConnection_->close();
 }
 
@@ -1587,26 +1824,50 @@ ChannelPtr TwitchIrcServer::getOrAddChannel(const QString &dirtyChannelName)
                                << "was destroyed";
         this->channels.remove(channelName);
 
-        if (this->readConnection_)
+        std::lock_guard lock(this->connectionMutex_);
+        if (auto *connection = this->readConnectionOf(channelName))
         {
-            this->readConnection_->sendRaw("PART #" + channelName);
+            connection->sendRaw("PART #" + channelName);
         }
+        this->readRing_.remove(channelName);
+        this->syncReadConnections();
     });
 
-    // join IRC channel
+    this->joinReadChannel(channelName);
+
+    return chan;
+}
+
+void TwitchIrcServer::joinReadChannel(const QString &channelName)
+{
+    std::vector<IrcConnection *> added;
+    bool join = false;
     {
-        std::lock_guard<std::mutex> lock2(this->connectionMutex_);
+        std::lock_guard lock(this->connectionMutex_);
 
-        if (this->readConnection_)
+        auto index = this->readRing_.assign(channelName);
+        added = this->syncReadConnections();
+        if (!this->connectRequested_)
         {
-            if (this->readConnection_->isConnected())
-            {
-                this->joinBucket_->send(channelName);
-            }
+            added.clear();
         }
+
+        join = index < this->readConnections_.size() &&
+               this->readConnections_[index]->connected;
     }
 
-    return chan;
+    // The bucket calls queueJoin right away if it has budget left, which
+    // takes connectionMutex_ again
+    if (join)
+    {
+        this->joinBucket_->send(channelName);
+    }
+
+    // New connections join their channels once they're connected
+    for (auto *connection : added)
+    {
+        this->initializeConnection(connection, ConnectionType::Read);
+    }
 }
 
 ChannelPtr TwitchIrcServer::getChannelOrEmpty(const QString &dirtyChannelName)
@@ -1639,15 +1900,18 @@ ChannelPtr TwitchIrcServer::getChannelOrEmpty(const QString &dirtyChannelName)
 
 void TwitchIrcServer::open(ConnectionType type)
 {
-    std::lock_guard<std::mutex> lock(this->connectionMutex_);
-
+    // open() emits statusChanged right away, its handler takes
+    // connectionMutex_
     if (type == ConnectionType::Write)
     {
         this->writeConnection_->open();
     }
     if (type == ConnectionType::Read)
     {
-        this->readConnection_->open();
+        for (auto *connection : this->readConnections())
+        {
+            connection->open();
+        }
     }
 }
 
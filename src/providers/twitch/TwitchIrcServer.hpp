@@ -4,19 +4,27 @@
 #include "common/Channel.hpp"
 #include "common/Common.hpp"
 #include "providers/irc/IrcConnection2.hpp"
+#include "providers/twitch/ReadConnectionRing.hpp"
 #include "util/RatelimitBucket.hpp"
 
 #include <IrcMessage>
 #include <pajlada/signals/signal.hpp>
 #include <pajlada/signals/signalholder.hpp>
 #include <QRandomGenerator>
+#include <QStringList>
 
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
 
+#if __has_include(<gtest/gtest_prod.h>)
+#    include <gtest/gtest_prod.h>
+#endif
+
 namespace chatterino {
 
 class Settings;
@@ -162,12 +170,14 @@ protected:
 
     void privateMessageReceived(Communi::IrcPrivateMessage *message);
     void readConnectionMessageReceived(Communi::IrcMessage *message);
+    /// Adds chat messages to the structured log of their channel
+    void logRawMessage(Communi::IrcMessage *message);
     void writeConnectionMessageReceived(Communi::IrcMessage *message);
 
     void onReadConnected(IrcConnection *connection);
     void onWriteConnected(IrcConnection *connection);
-    void onDisconnected();
-    void markChannelsConnected();
+    void onDisconnected(IrcConnection *connection);
+    void markChannelsConnected(IrcConnection *connection);
 
     std::shared_ptr<Channel> getCustomChannel(const QString &channelname);
 
@@ -183,8 +193,50 @@ private:
     QMap<QString, std::weak_ptr<Channel>> channels;
     std::mutex channelMutex;
 
+    /// A connection that receives the messages of a part of our channels
+    struct ReadConnection {
+        QObjectPtr<IrcConnection> connection;
+        pajlada::Signals::SignalHolder signalHolder;
+
+        /// Prefix of the debug counters of this connection
+        QString debugName;
+        int64_t messages = 0;
+        int64_t reconnects = 0;
+
+        /// Channels released by the join bucket that haven't been sent yet
+        QStringList pendingJoins;
+        /// Set while Twitch accepts commands on this connection
+        bool connected = false;
+    };
+
+    /// Assigns `channelName` to a read connection and joins it if that
+    /// connection is connected. Must not be called with connectionMutex_.
+    void joinReadChannel(const QString &channelName);
+
+    /// Joins `channelName` on its read connection with the next batch
+    void queueJoin(const QString &channelName);
+    void flushJoins();
+
+    void addReadConnection();
+    /// Adds or removes read connections to match readRing_. Returns the
+    /// added connections. Requires connectionMutex_.
+    std::vector<IrcConnection *> syncReadConnections();
+    std::vector<IrcConnection *> readConnections();
+    /// Requires connectionMutex_
+    IrcConnection *readConnectionOf(const QString &channelName);
+    /// Requires connectionMutex_
+    std::optional<size_t> readConnectionIndex(IrcConnection *connection) const;
+    /// Returns the channels joined through `connection`
+    std::vector<ChannelPtr> channelsOf(IrcConnection *connection);
+    void addSystemMessageTo(IrcConnection *connection,
+                            const QString &messageText);
+    void updateReadConnectionStats(IrcConnection *connection);
+
     QObjectPtr<IrcConnection> writeConnection_ = nullptr;
-    QObjectPtr<IrcConnection> readConnection_ = nullptr;
+    std::vector<std::unique_ptr<ReadConnection>> readConnections_;
+    ReadConnectionRing readRing_;
+    bool connectRequested_ = false;
+    bool joinFlushScheduled_ = false;
 
     // Our rate limiting bucket for the Twitch join rate limits
     // https://dev.twitch.tv/docs/irc/guide#rate-limits
@@ -204,6 +256,11 @@ private:
     std::chrono::steady_clock::time_point lastErrorTimeAmount_;
 
     QRandomGenerator generator;
+
+#ifdef FRIEND_TEST
+    FRIEND_TEST(TwitchIrcServer, JoinOnConnectedReadConnection);
+    FRIEND_TEST(TwitchIrcServer, OpenAndCloseReadConnection);
+#endif
 };
 
 }  // namespace chatterino
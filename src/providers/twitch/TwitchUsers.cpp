@@ -3,6 +3,7 @@
 #include "common/QLogging.hpp"
 #include "providers/twitch/api/Helix.hpp"
 #include "providers/twitch/TwitchUser.hpp"
+#include "util/Helpers.hpp"
 
 #include <boost/unordered/unordered_flat_map.hpp>
 #include <QStringList>
@@ -36,7 +37,6 @@ private:
     boost::unordered_flat_map<UserId, std::shared_ptr<TwitchUser>> cache;
     QStringList unresolved;
     QTimer nextBatchTimer;
-    bool isResolving = false;
 
     std::shared_ptr<TwitchUser> makeUnresolved(const UserId &id);
     void makeNextRequest();
@@ -90,7 +90,7 @@ std::shared_ptr<TwitchUser> TwitchUsersPrivate::makeUnresolved(const UserId &id)
     }
 
     this->unresolved.append(id.string);
-    if (!this->isResolving && !this->nextBatchTimer.isActive())
+    if (!this->nextBatchTimer.isActive())
     {
         this->nextBatchTimer.start();
     }
@@ -104,29 +104,21 @@ void TwitchUsersPrivate::makeNextRequest()
         return;
     }
 
-    if (this->isResolving)
+    // Helix sends these batches concurrently. A failed batch only loses its
+    // own users.
+    for (const auto &ids : splitListIntoBatches(this->unresolved, 100))
     {
-        qCWarning(chatterinoTwitch) << "Tried to start request while resolving";
-        return;
+        getHelix()->fetchUsers(ids, {},
+                               withSelf(this,
+                                        [](auto self, const auto &users) {
+                                            self->updateUsers(users);
+                                        }),
+                               withSelf(this, [](auto /*self*/) {
+                                   qCWarning(chatterinoTwitch)
+                                       << "Failed to load users";
+                               }));
     }
-    this->isResolving = true;
-
-    auto ids = this->unresolved.mid(
-        0, std::min<qsizetype>(this->unresolved.size(), 100));
-    this->unresolved = this->unresolved.mid(ids.length());
-    getHelix()->fetchUsers(ids, {},
-                           withSelf(this,
-                                    [](auto self, const auto &users) {
-                                        self->updateUsers(users);
-                                        self->isResolving = false;
-                                        self->makeNextRequest();
-                                    }),
-                           withSelf(this, [](auto self) {
-                               qCWarning(chatterinoTwitch)
-                                   << "Failed to load users";
-                               self->isResolving = false;
-                               self->makeNextRequest();
-                           }));
+    this->unresolved.clear();
 }
 
 void TwitchUsersPrivate::updateUsers(const std::vector<HelixUser> &users)
@@ -40,10 +40,69 @@ HelixChatters::HelixChatters(const QJsonObject &jsonObject)
     }
 }
 
+template <typename T>
+typename HelixBatcher<T>::RequestFn Helix::makeBatchRequest(QString url,
+                                                           QString idParam)
+{
+    return [this, url = std::move(url), idParam = std::move(idParam)](
+               const QStringList &ids, auto onFinished) {
+        QUrlQuery urlQuery;
+        for (const auto &id : ids)
+        {
+            urlQuery.addQueryItem(idParam, id);
+        }
+
+        this->makeGet(url, urlQuery)
+            .onSuccess([onFinished](const NetworkResult &result) {
+                onFinished(true, result);
+            })
+            .onError([onFinished](const NetworkResult &result) {
+                onFinished(false, result);
+            })
+            .execute();
+    };
+}
+
+Helix::Helix()
+    : batchRatelimit(std::make_shared<HelixRatelimit>())
+    , userBatcher(HelixBatcher<HelixUser>::create(
+          this->makeBatchRequest<HelixUser>("users", "id"),
+          [](const HelixUser &user) {
+              return user.id;
+          },
+          this->batchRatelimit))
+    , streamBatcher(HelixBatcher<HelixStream>::create(
+          this->makeBatchRequest<HelixStream>("streams", "user_id"),
+          [](const HelixStream &stream) {
+              return stream.userId;
+          },
+          this->batchRatelimit))
+    , channelBatcher(HelixBatcher<HelixChannel>::create(
+          this->makeBatchRequest<HelixChannel>("channels", "broadcaster_id"),
+          [](const HelixChannel &channel) {
+              return channel.userId;
+          },
+          this->batchRatelimit))
+    , gameBatcher(HelixBatcher<HelixGame>::create(
+          this->makeBatchRequest<HelixGame>("games", "id"),
+          [](const HelixGame &game) {
+              return game.id;
+          },
+          this->batchRatelimit))
+{
+}
+
 void Helix::fetchUsers(QStringList userIds, QStringList userLogins,
                        ResultCallback<std::vector<HelixUser>> successCallback,
                        HelixFailureCallback failureCallback)
 {
+    if (userLogins.isEmpty() && !userIds.isEmpty())
+    {
+        this->userBatcher->fetch(std::move(userIds), std::move(successCallback),
+                                 std::move(failureCallback));
+        return;
+    }
+
     QUrlQuery urlQuery;
 
     for (const auto &id : userIds)
@@ -166,6 +225,14 @@ void Helix::fetchStreams(
     ResultCallback<std::vector<HelixStream>> successCallback,
     HelixFailureCallback failureCallback, std::function<void()> finallyCallback)
 {
+    if (userLogins.isEmpty() && !userIds.isEmpty())
+    {
+        this->streamBatcher->fetch(
+            std::move(userIds), std::move(successCallback),
+            std::move(failureCallback), std::move(finallyCallback));
+        return;
+    }
+
     QUrlQuery urlQuery;
 
     for (const auto &id : userIds)
@@ -257,6 +324,13 @@ void Helix::fetchGames(QStringList gameIds, QStringList gameNames,
 {
     assert((gameIds.length() + gameNames.length()) > 0);
 
+    if (gameNames.isEmpty())
+    {
+        this->gameBatcher->fetch(std::move(gameIds), std::move(successCallback),
+                                 std::move(failureCallback));
+        return;
+    }
+
     QUrlQuery urlQuery;
 
     for (const auto &id : gameIds)
@@ -436,37 +510,8 @@ void Helix::fetchChannels(
     ResultCallback<std::vector<HelixChannel>> successCallback,
     HelixFailureCallback failureCallback)
 {
-    QUrlQuery urlQuery;
-
-    for (const auto &userID : userIDs)
-    {
-        urlQuery.addQueryItem("broadcaster_id", userID);
-    }
-
-    this->makeGet("channels", urlQuery)
-        .onSuccess([successCallback, failureCallback](auto result) {
-            auto root = result.parseJson();
-            auto data = root.value("data");
-
-            if (!data.isArray())
-            {
-                failureCallback();
-                return;
-            }
-
-            std::vector<HelixChannel> channels;
-
-            for (const auto &unparsedChannel : data.toArray())
-            {
-                channels.emplace_back(unparsedChannel.toObject());
-            }
-
-            successCallback(channels);
-        })
-        .onError([failureCallback](auto /*result*/) {
-            failureCallback();
-        })
-        .execute();
+    this->channelBatcher->fetch(std::move(userIDs), std::move(successCallback),
+                                std::move(failureCallback));
 }
 
 void Helix::getChannel(QString broadcasterId,
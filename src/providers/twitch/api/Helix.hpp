@@ -2,6 +2,7 @@
 
 #include "common/Aliases.hpp"
 #include "common/network/NetworkRequest.hpp"
+#include "providers/twitch/api/HelixBatcher.hpp"
 #include "providers/twitch/eventsub/SubscriptionRequest.hpp"
 #include "providers/twitch/TwitchEmotes.hpp"
 #include "util/Helpers.hpp"
@@ -1236,6 +1237,8 @@ protected:
 class Helix final : public IHelix
 {
 public:
+    Helix();
+
     // https://dev.twitch.tv/docs/api/reference#get-users
     void fetchUsers(QStringList userIds, QStringList userLogins,
                     ResultCallback<std::vector<HelixUser>> successCallback,
@@ -1628,6 +1631,12 @@ private:
     NetworkRequest makePut(const QString &url, const QUrlQuery &urlQuery);
     NetworkRequest makePatch(const QString &url, const QUrlQuery &urlQuery);
 
+    /// Returns a request function for a HelixBatcher that sends the IDs as
+    /// `idParam` to the `url` endpoint
+    template <typename T>
+    typename HelixBatcher<T>::RequestFn makeBatchRequest(QString url,
+                                                         QString idParam);
+
     /// Paginate the `url` endpoint and use `baseQuery` as the starting point for pagination.
     /// @param onPage returns true while a new page is expected. Once false is returned, pagination will stop.
     void paginate(const QString &url, const QUrlQuery &baseQuery,
@@ -1639,6 +1648,13 @@ private:
 
     QString clientId;
     QString oauthToken;
+
+    /// Shared by all batchers, since they share the same points
+    std::shared_ptr<HelixRatelimit> batchRatelimit;
+    std::shared_ptr<HelixBatcher<HelixUser>> userBatcher;
+    std::shared_ptr<HelixBatcher<HelixStream>> streamBatcher;
+    std::shared_ptr<HelixBatcher<HelixChannel>> channelBatcher;
+    std::shared_ptr<HelixBatcher<HelixGame>> gameBatcher;
 };
 
 // initializeHelix sets the helix instance to _instance
@@ -0,0 +1,103 @@
+#include "providers/twitch/api/HelixBatcher.hpp"
+
+#include <algorithm>
+
+namespace chatterino {
+
+bool HelixRatelimit::tryAcquire(Clock::time_point now)
+{
+    if (this->inFlight_ >= this->concurrency(now))
+    {
+        return false;
+    }
+
+    this->inFlight_++;
+    if (this->remaining_)
+    {
+        // Assume the request costs a point until we know better
+        (*this->remaining_)--;
+    }
+    return true;
+}
+
+void HelixRatelimit::release(const NetworkResult &result, Clock::time_point now)
+{
+    if (this->inFlight_ > 0)
+    {
+        this->inFlight_--;
+    }
+
+    bool ok = false;
+    auto remaining = result.header("Ratelimit-Remaining").toInt(&ok);
+    if (ok)
+    {
+        this->remaining_ = remaining;
+    }
+
+    auto reset = result.header("Ratelimit-Reset").toLongLong(&ok);
+    if (ok)
+    {
+        this->resetAt_ = Clock::time_point(std::chrono::seconds(reset));
+    }
+
+    if (result.status() == 429)
+    {
+        this->remaining_ = 0;
+        if (!this->resetAt_ || *this->resetAt_ <= now)
+        {
+            // Helix didn't tell us when to retry
+            this->resetAt_ = now + std::chrono::seconds(1);
+        }
+    }
+
+    // Listeners may add or remove listeners
+    auto listeners = this->listeners_;
+    for (const auto &listener : listeners)
+    {
+        listener();
+    }
+}
+
+size_t HelixRatelimit::concurrency(Clock::time_point now) const
+{
+    if (!this->remaining_ || (this->resetAt_ && *this->resetAt_ <= now))
+    {
+        // Nothing known yet or the bucket is full again
+        return MAX_CONCURRENCY;
+    }
+
+    auto budget = *this->remaining_ - RESERVED_POINTS;
+    if (budget <= 0)
+    {
+        return 0;
+    }
+    return std::min(MAX_CONCURRENCY, static_cast<size_t>(budget));
+}
+
+std::optional<std::chrono::milliseconds> HelixRatelimit::pausedFor(
+    Clock::time_point now) const
+{
+    if (this->concurrency(now) > 0)
+    {
+        return std::nullopt;
+    }
+    if (!this->resetAt_)
+    {
+        return std::chrono::seconds(1);
+    }
+    return std::max(std::chrono::duration_cast<std::chrono::milliseconds>(
+                        *this->resetAt_ - now),
+                    std::chrono::milliseconds(1));
+}
+
+size_t HelixRatelimit::inFlight() const
+{
+    return this->inFlight_;
+}
+
+void HelixRatelimit::onRelease(std::function<void()> listener)
+{
+    this->listeners_.emplace_back(std::move(listener));
+}
+
+}  // namespace chatterino
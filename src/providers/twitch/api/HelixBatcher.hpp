@@ -0,0 +1,389 @@
+#pragma once
+
+#include "common/network/NetworkResult.hpp"
+#include "util/PostToThread.hpp"
+#include "util/QStringHash.hpp"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace chatterino {
+
+/**
+ * @brief Decides how many batched Helix requests may run at once.
+ *
+ * Helix hands every client ID + user a bucket of points, and reports what's
+ * left in the `Ratelimit-Remaining` and `Ratelimit-Reset` headers. Batches run
+ * with up to MAX_CONCURRENCY requests in flight as long as enough points are
+ * left, keeping RESERVED_POINTS for requests the user is waiting for. Once the
+ * points are used up, batches pause until the bucket resets.
+ */
+class HelixRatelimit
+{
+public:
+    using Clock = std::chrono::system_clock;
+
+    static constexpr size_t MAX_CONCURRENCY = 6;
+    static constexpr int RESERVED_POINTS = 20;
+
+    /// Takes a slot for a request. Returns false if no request may be sent
+    /// right now.
+    bool tryAcquire(Clock::time_point now = Clock::now());
+
+    /// Frees the slot taken for `result` and updates the points from its
+    /// headers. Listeners are notified afterwards.
+    void release(const NetworkResult &result,
+                 Clock::time_point now = Clock::now());
+
+    /// Returns how many requests may be in flight right now
+    size_t concurrency(Clock::time_point now = Clock::now()) const;
+
+    /// Returns how long to wait until the points reset, if no request may be
+    /// sent until then
+    std::optional<std::chrono::milliseconds> pausedFor(
+        Clock::time_point now = Clock::now()) const;
+
+    size_t inFlight() const;
+
+    /// Adds a listener that's called whenever a slot was freed
+    void onRelease(std::function<void()> listener);
+
+private:
+    size_t inFlight_ = 0;
+    std::optional<int> remaining_;
+    std::optional<Clock::time_point> resetAt_;
+    std::vector<std::function<void()>> listeners_;
+};
+
+/**
+ * @brief Collects IDs for a Helix endpoint from many callers into batches.
+ *
+ * IDs requested within WINDOW are merged and deduplicated, then sent in
+ * batches of up to BATCH_SIZE IDs. Batches run concurrently as allowed by the
+ * shared HelixRatelimit. Every caller gets the results for its own IDs once all
+ * batches containing them finished, or its failure callback if one of them
+ * failed. Batches rejected with "429 Too Many Requests" are retried.
+ *
+ * Must be used from the GUI thread; calls from other threads are posted there.
+ *
+ * @tparam T the result type, constructible from the JSON object in "data"
+ */
+template <typename T>
+class HelixBatcher : public std::enable_shared_from_this<HelixBatcher<T>>
+{
+public:
+    static constexpr qsizetype BATCH_SIZE = 100;
+    static constexpr std::chrono::milliseconds WINDOW{50};
+
+    using SuccessCallback = std::function<void(std::vector<T>)>;
+    using FailureCallback = std::function<void()>;
+    /// Sends a request for `ids` and calls `onFinished` with whether it
+    /// succeeded and the result
+    using RequestFn = std::function<void(
+        const QStringList &ids,
+        std::function<void(bool ok, const NetworkResult &result)> onFinished)>;
+    /// Returns the ID an item of the response belongs to
+    using IdFn = std::function<QString(const T &item)>;
+
+    HelixBatcher(RequestFn request, IdFn idOf,
+                 std::shared_ptr<HelixRatelimit> ratelimit)
+        : request_(std::move(request))
+        , idOf_(std::move(idOf))
+        , ratelimit_(std::move(ratelimit))
+    {
+    }
+
+    static std::shared_ptr<HelixBatcher> create(
+        RequestFn request, IdFn idOf, std::shared_ptr<HelixRatelimit> ratelimit)
+    {
+        auto batcher = std::make_shared<HelixBatcher>(
+            std::move(request), std::move(idOf), ratelimit);
+        ratelimit->onRelease([weak = batcher->weak_from_this()] {
+            if (auto self = weak.lock())
+            {
+                // Full batches can go out right away, partial ones wait for
+                // their window to end
+                self->dispatch(!self->flushScheduled_);
+            }
+        });
+        return batcher;
+    }
+
+    void fetch(QStringList ids, SuccessCallback successCallback,
+               FailureCallback failureCallback,
+               std::function<void()> finallyCallback = {})
+    {
+        if (!isGuiThread())
+        {
+            postToGuiThread(
+                [weak = this->weak_from_this(), ids = std::move(ids),
+                 successCallback = std::move(successCallback),
+                 failureCallback = std::move(failureCallback),
+                 finallyCallback = std::move(finallyCallback)]() mutable {
+                    if (auto self = weak.lock())
+                    {
+                        self->fetch(std::move(ids), std::move(successCallback),
+                                    std::move(failureCallback),
+                                    std::move(finallyCallback));
+                    }
+                });
+            return;
+        }
+
+        ids.removeDuplicates();
+        ids.removeAll(QString());
+
+        auto waiter = std::make_shared<Waiter>(Waiter{
+            .success = std::move(successCallback),
+            .failure = std::move(failureCallback),
+            .finally = std::move(finallyCallback),
+            .results = {},
+            .pendingIds = ids.size(),
+            .failed = false,
+        });
+        if (ids.isEmpty())
+        {
+            complete(*waiter);
+            return;
+        }
+
+        for (const auto &id : ids)
+        {
+            auto &subscribers = this->subscribers_[id];
+            if (subscribers.empty())
+            {
+                this->queue_.append(id);
+            }
+            subscribers.push_back(waiter);
+        }
+
+        if (this->queue_.size() >= BATCH_SIZE)
+        {
+            this->dispatch(false);
+        }
+        if (!this->queue_.isEmpty())
+        {
+            this->scheduleFlush();
+        }
+    }
+
+    /// Sends all queued IDs without waiting for the window to end
+    void flush()
+    {
+        this->flushScheduled_ = false;
+        this->dispatch(true);
+    }
+
+    qsizetype queued() const
+    {
+        return this->queue_.size();
+    }
+
+private:
+    struct Waiter {
+        SuccessCallback success;
+        FailureCallback failure;
+        std::function<void()> finally;
+
+        std::vector<T> results;
+        qsizetype pendingIds;
+        bool failed;
+    };
+
+    using Subscribers = std::vector<std::shared_ptr<Waiter>>;
+
+    struct Batch {
+        QStringList ids;
+        /// Same order as `ids`
+        std::vector<Subscribers> subscribers;
+    };
+
+    static void complete(Waiter &waiter)
+    {
+        if (waiter.failed)
+        {
+            if (waiter.failure)
+            {
+                waiter.failure();
+            }
+        }
+        else if (waiter.success)
+        {
+            waiter.success(std::move(waiter.results));
+        }
+
+        if (waiter.finally)
+        {
+            waiter.finally();
+        }
+    }
+
+    void scheduleFlush()
+    {
+        if (this->flushScheduled_)
+        {
+            return;
+        }
+        this->flushScheduled_ = true;
+
+        QTimer::singleShot(WINDOW, [weak = this->weak_from_this()] {
+            if (auto self = weak.lock())
+            {
+                self->flush();
+            }
+        });
+    }
+
+    void scheduleRetry(std::chrono::milliseconds delay)
+    {
+        if (this->retryScheduled_)
+        {
+            return;
+        }
+        this->retryScheduled_ = true;
+
+        QTimer::singleShot(delay, [weak = this->weak_from_this()] {
+            if (auto self = weak.lock())
+            {
+                self->retryScheduled_ = false;
+                self->dispatch(true);
+            }
+        });
+    }
+
+    /// Sends batches while the ratelimit allows it. Partial batches are only
+    /// sent if `partial` is set.
+    void dispatch(bool partial)
+    {
+        while (this->queue_.size() >= BATCH_SIZE ||
+               (partial && !this->queue_.isEmpty()))
+        {
+            if (!this->ratelimit_->tryAcquire())
+            {
+                // Released slots notify us, only wait for a reset
+                if (auto pause = this->ratelimit_->pausedFor())
+                {
+                    this->scheduleRetry(*pause);
+                }
+                return;
+            }
+
+            auto batch = std::make_shared<Batch>();
+            batch->ids = this->queue_.mid(0, BATCH_SIZE);
+            this->queue_.remove(0, batch->ids.size());
+            batch->subscribers.reserve(batch->ids.size());
+            for (const auto &id : batch->ids)
+            {
+                auto it = this->subscribers_.find(id);
+                batch->subscribers.emplace_back(std::move(it->second));
+                this->subscribers_.erase(it);
+            }
+
+            this->request_(batch->ids, [weak = this->weak_from_this(), batch](
+                                           bool ok,
+                                           const NetworkResult &result) {
+                if (auto self = weak.lock())
+                {
+                    self->finish(*batch, ok, result);
+                }
+            });
+        }
+    }
+
+    void finish(Batch &batch, bool ok, const NetworkResult &result)
+    {
+        if (result.status() == 429)
+        {
+            // Queue the batch again, in front of everything else
+            for (auto i = batch.ids.size() - 1; i >= 0; i--)
+            {
+                const auto &id = batch.ids[i];
+                auto &subscribers = this->subscribers_[id];
+                if (subscribers.empty())
+                {
+                    this->queue_.prepend(id);
+                }
+                subscribers.insert(subscribers.end(),
+                                   batch.subscribers[i].begin(),
+                                   batch.subscribers[i].end());
+            }
+            this->ratelimit_->release(result);
+            return;
+        }
+
+        std::unordered_map<QString, T> items;
+        if (ok)
+        {
+            auto data = result.parseJson().value("data");
+            if (data.isArray())
+            {
+                for (const auto &value : data.toArray())
+                {
+                    T item(value.toObject());
+                    auto id = this->idOf_(item);
+                    items.emplace(std::move(id), std::move(item));
+                }
+            }
+            else
+            {
+                ok = false;
+            }
+        }
+
+        std::vector<std::shared_ptr<Waiter>> completed;
+        for (qsizetype i = 0; i < batch.ids.size(); i++)
+        {
+            auto item = items.find(batch.ids[i]);
+            for (const auto &waiter : batch.subscribers[i])
+            {
+                if (!ok)
+                {
+                    waiter->failed = true;
+                }
+                else if (item != items.end())
+                {
+                    waiter->results.push_back(item->second);
+                }
+
+                if (--waiter->pendingIds == 0)
+                {
+                    completed.push_back(waiter);
+                }
+            }
+        }
+
+        // Free the slot first, so callbacks see an up to date ratelimit
+        this->ratelimit_->release(result);
+
+        for (const auto &waiter : completed)
+        {
+            complete(*waiter);
+        }
+    }
+
+    RequestFn request_;
+    IdFn idOf_;
+    std::shared_ptr<HelixRatelimit> ratelimit_;
+
+    /// IDs waiting to be sent, in order
+    QStringList queue_;
+    /// Callers waiting for an ID in `queue_`
+    std::unordered_map<QString, Subscribers> subscribers_;
+
+    bool flushScheduled_ = false;
+    bool retryScheduled_ = false;
+};
+
+}  // namespace chatterino
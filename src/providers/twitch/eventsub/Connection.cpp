@@ -64,6 +64,12 @@ void Connection::onNotification(const lib::messages::Metadata &metadata,
                                 const boost::json::value &jv)
 {
     (void)metadata;
+    if (!LOG().isDebugEnabled())
+    {
+        // Don't serialize every notification only to drop the log line
+        return;
+    }
+
     auto jsonString = boost::json::serialize(jv);
     qCDebug(LOG) << "on notification: " << jsonString.c_str();
 }
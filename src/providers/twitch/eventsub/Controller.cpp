@@ -1,17 +1,19 @@
 #include "providers/twitch/eventsub/Controller.hpp"
 
+#include "common/network/IoContextPool.hpp"
 #include "common/QLogging.hpp"
 #include "common/Version.hpp"
 #include "providers/twitch/api/Helix.hpp"
 #include "providers/twitch/eventsub/Connection.hpp"
-#include "util/RenameThread.hpp"
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ssl.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/ssl/verify_mode.hpp>
 #include <boost/certify/https_verification.hpp>
 #include <twitch-eventsub-ws/session.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -44,48 +46,93 @@ Controller::Controller()
                          Version::instance().commitHash())
                     .toUtf8()
                     .toStdString())
-    , ioContext(1)
-    , work(boost::asio::make_work_guard(this->ioContext))
+    , ioContext(IoContextPool::instance().acquire())
 {
     std::tie(this->eventSubHost, this->eventSubPort, this->eventSubPath) =
         getEventSubHost();
-    this->thread = std::make_unique<std::thread>([this] {
-        this->ioContext.run();
-    });
-    renameThread(*this->thread, "C2EventSub");
 
-    this->threadGuard = std::make_unique<ThreadGuard>(this->thread->get_id());
+    this->threadGuard = std::make_unique<ThreadGuard>(
+        IoContextPool::instance().threadOf(this->ioContext));
 }
 
 Controller::~Controller()
 {
     qCInfo(LOG) << "Controller dtor start";
 
-    for (const auto &weakConnection : this->connections)
-    {
-        auto connection = weakConnection.lock();
-        if (!connection)
+    this->stopping = true;
+
+    // The context is shared, so we can't wait for it to run out of work.
+    // Wait until all connections are closed instead.
+    OnceFlag closed;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    boost::asio::post(this->ioContext, [this, &closed, deadline] {
+        for (const auto &weakConnection : this->connections)
         {
-            continue;
+            auto connection = weakConnection.lock();
+            if (!connection)
+            {
+                continue;
+            }
+
+            connection->close();
         }
 
-        connection->close();
-    }
+        {
+            std::lock_guard lock(this->subscriptionsMutex);
+            this->subscriptions.clear();
+        }
+
+        this->awaitConnectionsClosed(closed, deadline, false);
+    });
+
+    closed.wait();
 
-    this->subscriptions.clear();
+    IoContextPool::instance().release(this->ioContext);
 
-    this->work.reset();
+    qCInfo(LOG) << "Controller dtor end";
+}
+
+void Controller::awaitConnectionsClosed(
+    OnceFlag &closed, std::chrono::steady_clock::time_point deadline,
+    bool terminated)
+{
+    this->threadGuard->guard();
 
-    if (this->thread->joinable())
+    std::erase_if(this->connections, [](const auto &connection) {
+        return connection.expired();
+    });
+
+    if (this->connections.empty())
     {
-        this->thread->join();
+        closed.set();
+        return;
     }
-    else
+
+    if (!terminated && std::chrono::steady_clock::now() >= deadline)
     {
-        qCWarning(LOG) << "Thread not joinable";
+        qCWarning(LOG) << this->connections.size()
+                       << "connections didn't close within 1 second, "
+                          "terminate them";
+
+        // The connections use our SSL context, so they must be gone before
+        // we're destroyed. Terminated connections finish their pending
+        // operations right away and release themselves.
+        for (const auto &weakConnection : this->connections)
+        {
+            if (auto connection = weakConnection.lock())
+            {
+                connection->terminate();
+            }
+        }
+        terminated = true;
     }
 
-    qCInfo(LOG) << "Controller dtor end";
+    auto timer = std::make_shared<boost::asio::steady_timer>(
+        this->ioContext, std::chrono::milliseconds(10));
+    timer->async_wait(
+        [this, timer, &closed, deadline, terminated](const auto & /*ec*/) {
+            this->awaitConnectionsClosed(closed, deadline, terminated);
+        });
 }
 
 void Controller::removeRef(const SubscriptionRequest &request)
@@ -156,6 +203,11 @@ void Controller::subscribe(const SubscriptionRequest &request, bool isRetry)
 {
     qCInfo(LOG) << "Subscribe request for" << request.subscriptionType;
     boost::asio::post(this->ioContext, [this, request, isRetry] {
+        if (this->stopping)
+        {
+            return;
+        }
+
         // 1. Flush dead connections (maybe this should not be done here)
         // TODO: implement
 
@@ -287,21 +339,27 @@ void Controller::createConnection()
 {
     try
     {
-        boost::asio::ssl::context sslContext{
-            boost::asio::ssl::context::tlsv12_client};
-
-        if constexpr (!LOCAL_EVENTSUB)
+        if (!this->sslContext)
         {
-            sslContext.set_verify_mode(
-                boost::asio::ssl::verify_peer |
-                boost::asio::ssl::verify_fail_if_no_peer_cert);
-            sslContext.set_default_verify_paths();
+            auto sslContext = std::make_unique<boost::asio::ssl::context>(
+                boost::asio::ssl::context::tlsv12_client);
+
+            if constexpr (!LOCAL_EVENTSUB)
+            {
+                sslContext->set_verify_mode(
+                    boost::asio::ssl::verify_peer |
+                    boost::asio::ssl::verify_fail_if_no_peer_cert);
+                sslContext->set_default_verify_paths();
+
+                boost::certify::enable_native_https_server_verification(
+                    *sslContext);
+            }
 
-            boost::certify::enable_native_https_server_verification(sslContext);
+            this->sslContext = std::move(sslContext);
         }
 
         auto connection = std::make_shared<lib::Session>(
-            this->ioContext, sslContext, std::make_unique<Connection>());
+            this->ioContext, *this->sslContext, std::make_unique<Connection>());
 
         this->registerConnection(connection);
 
@@ -3,17 +3,19 @@
 #include "providers/twitch/eventsub/SubscriptionHandle.hpp"
 #include "providers/twitch/eventsub/SubscriptionRequest.hpp"
 #include "twitch-eventsub-ws/session.hpp"
+#include "util/OnceFlag.hpp"
 #include "util/ThreadGuard.hpp"
 
-#include <boost/asio/executor_work_guard.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/ssl/context.hpp>
 #include <boost/functional/hash.hpp>
 #include <QJsonObject>
 #include <QString>
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
-#include <thread>
 
 namespace chatterino::eventsub {
 
@@ -53,6 +55,11 @@ private:
     void subscribe(const SubscriptionRequest &request, bool isRetry);
 
     void createConnection();
+    /// Sets `closed` once all connections are gone. Connections that are
+    /// still open after `deadline` are terminated.
+    void awaitConnectionsClosed(
+        OnceFlag &closed, std::chrono::steady_clock::time_point deadline,
+        bool terminated);
     void registerConnection(std::weak_ptr<lib::Session> &&connection);
 
     void retrySubscription(const SubscriptionRequest &request,
@@ -69,11 +76,12 @@ private:
     std::string eventSubPort;
     std::string eventSubPath;
 
-    std::unique_ptr<std::thread> thread;
+    /// The context of the IoContextPool our connections run on
+    boost::asio::io_context &ioContext;
     std::unique_ptr<ThreadGuard> threadGuard;
-    boost::asio::io_context ioContext;
-    boost::asio::executor_work_guard<boost::asio::io_context::executor_type>
-        work;
+    /// Shared by all connections, created with the first one
+    std::unique_ptr<boost::asio::ssl::context> sslContext;
+    std::atomic<bool> stopping{false};
 
     std::vector<std::weak_ptr<lib::Session>> connections;
 
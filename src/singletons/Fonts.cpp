@@ -2,6 +2,7 @@
 
 #include "Application.hpp"
 #include "debug/AssertInGuiThread.hpp"
+#include "debug/Trace.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/WindowManager.hpp"
 
@@ -116,6 +117,7 @@ Fonts::FontData &Fonts::getOrCreateFontData(FontStyle type, float scale)
 
 Fonts::FontData Fonts::createFontData(FontStyle type, float scale)
 {
+    TraceSpan span("Fonts::createFontData");
     auto *settings = getSettings();
 
     // check if it's a chat (scale the setting)
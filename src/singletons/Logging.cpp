@@ -4,6 +4,7 @@
 #include "singletons/helper/LoggingChannel.hpp"
 #include "singletons/Settings.hpp"
 
+#include <QDateTime>
 #include <QDir>
 #include <QStandardPaths>
 
@@ -36,41 +37,59 @@ void Logging::addMessage(const QString &channelName, MessagePtr message,
 {
     this->threadGuard.guard();
 
-    if (!getSettings()->enableLogging)
+    if (!this->shouldLog(channelName))
+    {
+        return;
+    }
+
+    this->getLoggingChannel(channelName, platformName)
+        .addMessage(message, streamID);
+}
+
+void Logging::addRawMessage(const QString &channelName,
+                            const QByteArray &message,
+                            const QString &platformName)
+{
+    this->threadGuard.guard();
+
+    if (!getSettings()->enableStructuredLogs || !this->shouldLog(channelName))
     {
         return;
     }
 
+    this->getLoggingChannel(channelName, platformName)
+        .addRawMessage(message, QDateTime::currentMSecsSinceEpoch());
+}
+
+bool Logging::shouldLog(const QString &channelName) const
+{
+    if (!getSettings()->enableLogging)
+    {
+        return false;
+    }
+
     if (getSettings()->onlyLogListedChannels)
     {
         if (!this->onlyLogListedChannels.contains(channelName))
         {
-            return;
+            return false;
         }
     }
 
-    auto platIt = this->loggingChannels_.find(platformName);
-    if (platIt == this->loggingChannels_.end())
-    {
-        auto *channel = new LoggingChannel(channelName, platformName);
-        channel->addMessage(message, streamID);
-        auto map = std::map<QString, std::unique_ptr<LoggingChannel>>();
-        this->loggingChannels_[platformName] = std::move(map);
-        auto &ref = this->loggingChannels_.at(platformName);
-        ref.emplace(channelName, channel);
-        return;
-    }
-    auto chanIt = platIt->second.find(channelName);
-    if (chanIt == platIt->second.end())
+    return true;
+}
+
+LoggingChannel &Logging::getLoggingChannel(const QString &channelName,
+                                           const QString &platformName)
+{
+    auto &channels = this->loggingChannels_[platformName];
+    auto chanIt = channels.find(channelName);
+    if (chanIt == channels.end())
     {
         auto *channel = new LoggingChannel(channelName, platformName);
-        channel->addMessage(message, streamID);
-        platIt->second.emplace(channelName, channel);
-    }
-    else
-    {
-        chanIt->second->addMessage(message, streamID);
+        chanIt = channels.emplace(channelName, channel).first;
     }
+    return *chanIt->second;
 }
 
 void Logging::closeChannel(const QString &channelName,
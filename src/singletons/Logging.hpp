@@ -3,6 +3,7 @@
 #include "util/QStringHash.hpp"
 #include "util/ThreadGuard.hpp"
 
+#include <QByteArray>
 #include <QString>
 
 #include <map>
@@ -25,6 +26,12 @@ public:
                             const QString &platformName,
                             const QString &streamID) = 0;
 
+    /// Adds a raw message (e.g. an IRC line) to the structured log of the
+    /// channel
+    virtual void addRawMessage(const QString &channelName,
+                               const QByteArray &message,
+                               const QString &platformName) = 0;
+
     virtual void closeChannel(const QString &channelName,
                               const QString &platformName) = 0;
 };
@@ -38,10 +45,17 @@ public:
                     const QString &platformName,
                     const QString &streamID) override;
 
+    void addRawMessage(const QString &channelName, const QByteArray &message,
+                       const QString &platformName) override;
+
     void closeChannel(const QString &channelName,
                       const QString &platformName) override;
 
 private:
+    bool shouldLog(const QString &channelName) const;
+    LoggingChannel &getLoggingChannel(const QString &channelName,
+                                      const QString &platformName);
+
     using PlatformName = QString;
     using ChannelName = QString;
     std::map<PlatformName,
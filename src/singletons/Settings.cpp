@@ -10,6 +10,7 @@
 #include "controllers/moderationactions/ModerationAction.hpp"
 #include "controllers/nicknames/Nickname.hpp"
 #include "debug/Benchmark.hpp"
+#include "debug/Trace.hpp"
 #include "pajlada/settings/signalargs.hpp"
 #include "util/WindowsHelper.hpp"
 
@@ -145,6 +146,8 @@ Settings::Settings(const Args &args, const QString &settingsDirectory)
     : prevInstance_(Settings::instance_)
     , disableSaving(args.dontSaveSettings)
 {
+    TraceSpan span("Settings::Settings");
+
     QString settingsPath = settingsDirectory + "/settings.json";
 
     // get global instance of the settings library
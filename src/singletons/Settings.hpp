@@ -274,6 +274,8 @@ public:
     };
     // BoolSetting twitchSeperateWriteConnection =
     // {"/behaviour/twitchSeperateWriteConnection", false};
+    IntSetting twitchChannelsPerReadConnection = {
+        "/behaviour/twitchChannelsPerReadConnection", 50};
 
     // Auto-completion
     BoolSetting onlyFetchChattersForSmallerStreamers = {
@@ -517,6 +519,8 @@ public:
         "/logging/separatelyStoreStreamLogs",
         false,
     };
+    BoolSetting enableStructuredLogs = {"/logging/structured", false};
+    BoolSetting backfillFromStructuredLogs = {"/logging/backfillOnJoin", false};
 
     QStringSetting logPath = {"/logging/path", ""};
 
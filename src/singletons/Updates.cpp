@@ -424,6 +424,7 @@ void Updates::checkForUpdates()
         }
         qCDebug(chatterinoUpdate) << "Requesting updates from" << url;
         NetworkRequest(url)
+            .priority(NetworkPriority::Background)
             .timeout(60000)
             .followRedirects(true)
             .onSuccess(onSuccess)
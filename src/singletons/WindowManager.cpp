@@ -4,6 +4,7 @@
 #include "common/Args.hpp"
 #include "common/QLogging.hpp"
 #include "debug/AssertInGuiThread.hpp"
+#include "debug/Trace.hpp"
 #include "messages/MessageElement.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
 #include "singletons/Paths.hpp"
@@ -806,6 +807,8 @@ void WindowManager::applyWindowLayout(const WindowLayout &layout)
         return;
     }
 
+    TraceSpan span("WindowManager::applyWindowLayout");
+
     // Set emote popup position
     this->emotePopupBounds_ = layout.emotePopupBounds_;
 
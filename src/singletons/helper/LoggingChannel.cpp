@@ -60,45 +60,63 @@ LoggingChannel::LoggingChannel(QString _channelName, QString _platform)
     : channelName(std::move(_channelName))
     , platform(std::move(_platform))
 {
-    if (this->channelName.startsWith("/whispers"))
+    this->subDirectory = subDirectoryFor(this->channelName, this->platform);
+
+    getSettings()->logPath.connect([this](const QString &logPath, auto) {
+        this->baseDirectory = logPath.isEmpty()
+                                  ? getApp()->getPaths().messageLogDirectory
+                                  : logPath;
+        this->openLogFile();
+        // reopened in the new directory with the next message
+        this->structuredLog.close();
+        this->structuredLogDateString.clear();
+    });
+
+    this->structuredLogFlushTimer.setSingleShot(true);
+    this->structuredLogFlushTimer.setInterval(
+        StructuredLogWriter::FLUSH_INTERVAL);
+    QObject::connect(&this->structuredLogFlushTimer, &QTimer::timeout, [this] {
+        this->structuredLog.flush();
+    });
+}
+
+LoggingChannel::~LoggingChannel()
+{
+    appendLine(this->fileHandle, generateClosingString());
+    this->fileHandle.close();
+    this->currentStreamFileHandle.close();
+    this->structuredLog.close();
+}
+
+QString LoggingChannel::subDirectoryFor(const QString &channelName,
+                                        const QString &platform)
+{
+    QString subDirectory;
+    if (channelName.startsWith("/whispers"))
     {
-        this->subDirectory = "Whispers";
+        subDirectory = "Whispers";
     }
     else if (channelName.startsWith("/mentions"))
     {
-        this->subDirectory = "Mentions";
+        subDirectory = "Mentions";
     }
     else if (channelName.startsWith("/live"))
     {
-        this->subDirectory = "Live";
+        subDirectory = "Live";
     }
     else if (channelName.startsWith("/automod"))
     {
-        this->subDirectory = "AutoMod";
+        subDirectory = "AutoMod";
     }
     else
     {
-        this->subDirectory =
+        subDirectory =
             QStringLiteral("Channels") + QDir::separator() + channelName;
     }
 
     // enforce capitalized platform names
-    this->subDirectory = platform[0].toUpper() + platform.mid(1).toLower() +
-                         QDir::separator() + this->subDirectory;
-
-    getSettings()->logPath.connect([this](const QString &logPath, auto) {
-        this->baseDirectory = logPath.isEmpty()
-                                  ? getApp()->getPaths().messageLogDirectory
-                                  : logPath;
-        this->openLogFile();
-    });
-}
-
-LoggingChannel::~LoggingChannel()
-{
-    appendLine(this->fileHandle, generateClosingString());
-    this->fileHandle.close();
-    this->currentStreamFileHandle.close();
+    return platform[0].toUpper() + platform.mid(1).toLower() +
+           QDir::separator() + subDirectory;
 }
 
 void LoggingChannel::openLogFile()
@@ -163,6 +181,47 @@ void LoggingChannel::openStreamLogFile(const QString &streamID)
     appendLine(this->currentStreamFileHandle, generateOpeningString(now));
 }
 
+void LoggingChannel::openStructuredLogFile(const QString &dateString)
+{
+    this->structuredLogDateString = dateString;
+
+    QString directory =
+        this->baseDirectory + QDir::separator() + this->subDirectory;
+
+    if (!QDir().mkpath(directory))
+    {
+        qCDebug(chatterinoHelper) << "Unable to create logging path";
+        return;
+    }
+
+    QString fileName = directory + QDir::separator() + this->channelName +
+                       "-" + dateString + ".clog";
+    qCDebug(chatterinoHelper) << "Logging structured messages to" << fileName;
+    this->structuredLog.open(fileName);
+}
+
+void LoggingChannel::addRawMessage(const QByteArray &message,
+                                   qint64 receivedMs)
+{
+    QString messageDateString =
+        generateDateString(QDateTime::fromMSecsSinceEpoch(receivedMs));
+    if (messageDateString != this->structuredLogDateString)
+    {
+        this->openStructuredLogFile(messageDateString);
+    }
+
+    this->structuredLog.append({
+        .receivedMs = receivedMs,
+        .data = message,
+    });
+
+    if (this->structuredLog.hasBufferedRecords() &&
+        !this->structuredLogFlushTimer.isActive())
+    {
+        this->structuredLogFlushTimer.start();
+    }
+}
+
 void LoggingChannel::addMessage(const MessagePtr &message,
                                 const QString &streamID)
 {
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "singletons/helper/StructuredLog.hpp"
+
 #include <QFile>
 #include <QString>
+#include <QTimer>
 
 #include <memory>
 
@@ -26,9 +29,18 @@ public:
 
     void addMessage(const MessagePtr &message, const QString &streamID);
 
+    /// Adds a raw message to the structured log of the current date
+    void addRawMessage(const QByteArray &message, qint64 receivedMs);
+
+    /// Returns the directory (relative to the log directory) that messages of
+    /// `channelName` on `platform` are logged to
+    static QString subDirectoryFor(const QString &channelName,
+                                   const QString &platform);
+
 private:
     void openLogFile();
     void openStreamLogFile(const QString &streamID);
+    void openStructuredLogFile(const QString &dateString);
 
     const QString channelName;
     const QString platform;
@@ -41,6 +53,11 @@ private:
 
     QString dateString;
 
+    StructuredLogWriter structuredLog;
+    QString structuredLogDateString;
+    /// Flushes the structured log if no record arrives to do it
+    QTimer structuredLogFlushTimer;
+
     friend class Logging;
 };
 
@@ -0,0 +1,397 @@
+#include "singletons/helper/StructuredLog.hpp"
+
+#include "common/QLogging.hpp"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+/// "C2SL"
+constexpr quint32 FILE_MAGIC = 0x4332534c;
+constexpr quint32 FILE_VERSION = 2;
+constexpr qint64 FILE_HEADER_SIZE = 8;
+constexpr auto STREAM_VERSION = QDataStream::Qt_5_15;
+
+/// firstMs, lastMs, record count and compressed size
+constexpr qint64 BLOCK_HEADER_SIZE = 8 + 8 + 4 + 4;
+/// Every block ends with its total size, so the file can be read backwards
+constexpr qint64 BLOCK_TRAILER_SIZE = 4;
+
+}  // namespace
+
+namespace chatterino {
+
+StructuredLogWriter::~StructuredLogWriter()
+{
+    this->close();
+}
+
+bool StructuredLogWriter::open(const QString &path)
+{
+    this->close();
+
+    qint64 validSize = 0;
+    if (QFileInfo(path).size() > 0)
+    {
+        StructuredLogReader reader;
+        if (!reader.open(path))
+        {
+            qCWarning(chatterinoHelper)
+                << "Not appending to unknown structured log" << path;
+            return false;
+        }
+        validSize = reader.validSize();
+    }
+
+    this->file_.setFileName(path);
+    if (!this->file_.open(QIODevice::ReadWrite))
+    {
+        qCWarning(chatterinoHelper)
+            << "Unable to open structured log" << path
+            << this->file_.errorString();
+        return false;
+    }
+
+    if (validSize == 0)
+    {
+        QDataStream stream(&this->file_);
+        stream.setVersion(STREAM_VERSION);
+        stream << FILE_MAGIC << FILE_VERSION;
+    }
+    else if (this->file_.size() != validSize)
+    {
+        qCWarning(chatterinoHelper)
+            << "Dropping incomplete block of structured log" << path;
+        this->file_.resize(validSize);
+    }
+    this->file_.seek(this->file_.size());
+
+    return true;
+}
+
+bool StructuredLogWriter::isOpen() const
+{
+    return this->file_.isOpen();
+}
+
+void StructuredLogWriter::close()
+{
+    if (!this->file_.isOpen())
+    {
+        return;
+    }
+
+    this->flush();
+    this->file_.close();
+}
+
+void StructuredLogWriter::append(const StructuredLogRecord &record)
+{
+    if (!this->file_.isOpen())
+    {
+        return;
+    }
+
+    if (this->blockRecords_ == 0)
+    {
+        this->blockFirstMs_ = record.receivedMs;
+    }
+    this->blockLastMs_ = std::max(this->blockLastMs_, record.receivedMs);
+    this->blockRecords_++;
+
+    QDataStream stream(&this->block_, QIODevice::Append);
+    stream.setVersion(STREAM_VERSION);
+    stream << record.receivedMs << record.data;
+
+    auto age = std::chrono::milliseconds(record.receivedMs -
+                                         this->blockFirstMs_);
+    if (this->block_.size() >= BLOCK_SIZE || age >= FLUSH_INTERVAL)
+    {
+        this->flush();
+    }
+}
+
+bool StructuredLogWriter::hasBufferedRecords() const
+{
+    return this->blockRecords_ > 0;
+}
+
+void StructuredLogWriter::flush()
+{
+    if (this->blockRecords_ == 0 || !this->file_.isOpen())
+    {
+        return;
+    }
+
+    auto compressed = qCompress(this->block_);
+
+    QDataStream stream(&this->file_);
+    stream.setVersion(STREAM_VERSION);
+    stream << this->blockFirstMs_ << this->blockLastMs_ << this->blockRecords_
+           << static_cast<quint32>(compressed.size());
+    stream.writeRawData(compressed.constData(),
+                        static_cast<int>(compressed.size()));
+    stream << static_cast<quint32>(BLOCK_HEADER_SIZE + compressed.size() +
+                                   BLOCK_TRAILER_SIZE);
+    this->file_.flush();
+
+    this->block_.clear();
+    this->blockRecords_ = 0;
+    this->blockFirstMs_ = 0;
+    this->blockLastMs_ = 0;
+}
+
+bool StructuredLogReader::open(const QString &path)
+{
+    this->blocks_.clear();
+    this->validSize_ = 0;
+    this->indexed_ = false;
+
+    this->file_.setFileName(path);
+    if (!this->file_.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    QDataStream stream(&this->file_);
+    stream.setVersion(STREAM_VERSION);
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    return magic == FILE_MAGIC && version == FILE_VERSION;
+}
+
+const std::vector<StructuredLogReader::Block> &StructuredLogReader::blocks()
+{
+    this->buildIndex();
+    return this->blocks_;
+}
+
+qint64 StructuredLogReader::validSize()
+{
+    this->buildIndex();
+    return this->validSize_;
+}
+
+std::vector<StructuredLogRecord> StructuredLogReader::readBlock(size_t index)
+{
+    this->buildIndex();
+    return this->readRecords(this->blocks_.at(index));
+}
+
+std::vector<StructuredLogRecord> StructuredLogReader::readTail(size_t count)
+{
+    std::vector<std::vector<StructuredLogRecord>> parts;
+    size_t total = 0;
+
+    auto end = this->file_.size();
+    while (total < count && end > FILE_HEADER_SIZE)
+    {
+        std::optional<Block> block;
+        if (end - FILE_HEADER_SIZE >= BLOCK_HEADER_SIZE + BLOCK_TRAILER_SIZE)
+        {
+            this->file_.seek(end - BLOCK_TRAILER_SIZE);
+            QDataStream stream(&this->file_);
+            stream.setVersion(STREAM_VERSION);
+            quint32 length = 0;
+            stream >> length;
+            block = this->readBlockHeader(end - length);
+        }
+
+        if (!block || block->offset + block->size + BLOCK_TRAILER_SIZE != end)
+        {
+            // The end of the file is cut off, fall back to the block headers
+            parts.clear();
+            total = 0;
+            const auto &blocks = this->blocks();
+            for (auto it = blocks.rbegin(); it != blocks.rend() && total < count;
+                 ++it)
+            {
+                total += parts.emplace_back(this->readRecords(*it)).size();
+            }
+            break;
+        }
+
+        total += parts.emplace_back(this->readRecords(*block)).size();
+        end = block->offset - BLOCK_HEADER_SIZE;
+    }
+
+    std::vector<StructuredLogRecord> records;
+    records.reserve(std::min(total, count));
+    for (auto it = parts.rbegin(); it != parts.rend(); ++it)
+    {
+        for (auto &record : *it)
+        {
+            records.push_back(std::move(record));
+        }
+    }
+    if (records.size() > count)
+    {
+        records.erase(records.begin(),
+                      records.begin() +
+                          static_cast<std::ptrdiff_t>(records.size() - count));
+    }
+    return records;
+}
+
+void StructuredLogReader::buildIndex()
+{
+    if (this->indexed_)
+    {
+        return;
+    }
+    this->indexed_ = true;
+
+    qint64 offset = FILE_HEADER_SIZE;
+    while (auto block = this->readBlockHeader(offset))
+    {
+        this->blocks_.push_back(*block);
+        offset = block->offset + block->size + BLOCK_TRAILER_SIZE;
+    }
+    this->validSize_ = offset;
+}
+
+std::optional<StructuredLogReader::Block> StructuredLogReader::readBlockHeader(
+    qint64 offset)
+{
+    auto fileSize = this->file_.size();
+    if (offset < FILE_HEADER_SIZE ||
+        offset + BLOCK_HEADER_SIZE + BLOCK_TRAILER_SIZE > fileSize)
+    {
+        return std::nullopt;
+    }
+
+    this->file_.seek(offset);
+    QDataStream stream(&this->file_);
+    stream.setVersion(STREAM_VERSION);
+
+    Block block;
+    stream >> block.firstMs >> block.lastMs >> block.records >> block.size;
+    block.offset = offset + BLOCK_HEADER_SIZE;
+    if (stream.status() != QDataStream::Ok ||
+        block.offset + block.size + BLOCK_TRAILER_SIZE > fileSize)
+    {
+        return std::nullopt;
+    }
+
+    this->file_.seek(block.offset + block.size);
+    quint32 length = 0;
+    stream >> length;
+    if (stream.status() != QDataStream::Ok ||
+        length != BLOCK_HEADER_SIZE + block.size + BLOCK_TRAILER_SIZE)
+    {
+        return std::nullopt;
+    }
+
+    return block;
+}
+
+std::vector<StructuredLogRecord> StructuredLogReader::readRecords(
+    const Block &block)
+{
+    this->file_.seek(block.offset);
+    auto data = qUncompress(this->file_.read(block.size));
+
+    std::vector<StructuredLogRecord> records;
+    records.reserve(block.records);
+
+    QDataStream stream(data);
+    stream.setVersion(STREAM_VERSION);
+    for (uint32_t i = 0; i < block.records; i++)
+    {
+        StructuredLogRecord record;
+        stream >> record.receivedMs >> record.data;
+        if (stream.status() != QDataStream::Ok)
+        {
+            qCWarning(chatterinoHelper)
+                << "Corrupt block in structured log" << this->file_.fileName();
+            break;
+        }
+        records.push_back(std::move(record));
+    }
+
+    return records;
+}
+
+void StructuredLogReader::replay(
+    qint64 fromMs, const std::function<bool(const StructuredLogRecord &)> &cb)
+{
+    for (const auto &block : this->blocks())
+    {
+        if (block.lastMs < fromMs)
+        {
+            continue;
+        }
+
+        for (const auto &record : this->readRecords(block))
+        {
+            if (record.receivedMs < fromMs)
+            {
+                continue;
+            }
+            if (!cb(record))
+            {
+                return;
+            }
+        }
+    }
+}
+
+QStringList findStructuredLogs(const QString &directory,
+                               const QString &channelName)
+{
+    // <channel>-<yyyy-MM-dd>.clog, so sorting by name sorts by date
+    auto prefix = channelName + '-';
+    auto nameLength = prefix.size() + QStringView(u"yyyy-MM-dd.clog").size();
+
+    QStringList paths;
+    for (const auto &info :
+         QDir(directory).entryInfoList({prefix + "*.clog"}, QDir::Files,
+                                       QDir::Name | QDir::Reversed))
+    {
+        if (info.fileName().size() == nameLength)
+        {
+            paths.append(info.absoluteFilePath());
+        }
+    }
+    return paths;
+}
+
+std::vector<StructuredLogRecord> readStructuredLogTail(const QStringList &paths,
+                                                       size_t count)
+{
+    std::vector<std::vector<StructuredLogRecord>> parts;
+    size_t total = 0;
+    for (const auto &path : paths)
+    {
+        if (total >= count)
+        {
+            break;
+        }
+
+        StructuredLogReader reader;
+        if (!reader.open(path))
+        {
+            qCWarning(chatterinoHelper)
+                << "Skipping unknown structured log" << path;
+            continue;
+        }
+        total += parts.emplace_back(reader.readTail(count - total)).size();
+    }
+
+    std::vector<StructuredLogRecord> records;
+    records.reserve(total);
+    for (auto it = parts.rbegin(); it != parts.rend(); ++it)
+    {
+        std::move(it->begin(), it->end(), std::back_inserter(records));
+    }
+    return records;
+}
+
+}  // namespace chatterino
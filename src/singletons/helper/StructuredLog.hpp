@@ -0,0 +1,143 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace chatterino {
+
+/// A single message of a structured log, e.g. a raw IRC line
+struct StructuredLogRecord {
+    /// When the message was received, in milliseconds since epoch
+    qint64 receivedMs = 0;
+    QByteArray data;
+};
+
+/**
+ * @brief Writes structured logs.
+ *
+ * A structured log is a file header followed by compressed blocks of
+ * length-prefixed records. Every block starts with the receive time of its
+ * first and last record, so readers can seek to a time by only reading the
+ * block headers. Every block ends with its total length, so the newest
+ * blocks can be found by reading backwards from the end of the file.
+ *
+ * Records are buffered until the block is full or it has been open for
+ * FLUSH_INTERVAL. Since that's only checked when a record is appended, the
+ * owner has to call flush() if no records arrive. Buffered records are
+ * written when the writer is closed.
+ */
+class StructuredLogWriter
+{
+public:
+    /// Blocks are compressed once their records exceed this size
+    static constexpr qsizetype BLOCK_SIZE = 64 * 1024;
+    static constexpr std::chrono::seconds FLUSH_INTERVAL{30};
+
+    StructuredLogWriter() = default;
+    ~StructuredLogWriter();
+
+    StructuredLogWriter(const StructuredLogWriter &) = delete;
+    StructuredLogWriter &operator=(const StructuredLogWriter &) = delete;
+    StructuredLogWriter(StructuredLogWriter &&) = delete;
+    StructuredLogWriter &operator=(StructuredLogWriter &&) = delete;
+
+    /// Opens `path` for appending. A block that was cut off (e.g. by a crash)
+    /// is dropped.
+    bool open(const QString &path);
+    bool isOpen() const;
+    void close();
+
+    void append(const StructuredLogRecord &record);
+
+    /// Writes the buffered records as a block
+    void flush();
+
+    /// Returns true if records are waiting for flush()
+    bool hasBufferedRecords() const;
+
+private:
+    QFile file_;
+
+    QByteArray block_;
+    uint32_t blockRecords_ = 0;
+    qint64 blockFirstMs_ = 0;
+    qint64 blockLastMs_ = 0;
+};
+
+/// Reads structured logs written by StructuredLogWriter
+class StructuredLogReader
+{
+public:
+    struct Block {
+        /// Offset of the compressed records in the file
+        qint64 offset = 0;
+        uint32_t size = 0;
+        uint32_t records = 0;
+        qint64 firstMs = 0;
+        qint64 lastMs = 0;
+    };
+
+    /// Opens `path` and checks its file header. The block headers are only
+    /// read once they're needed.
+    bool open(const QString &path);
+
+    const std::vector<Block> &blocks();
+
+    /// Returns the offset past the last complete block
+    qint64 validSize();
+
+    /// Returns the records of the block at `index`, in the order they were
+    /// written
+    std::vector<StructuredLogRecord> readBlock(size_t index);
+
+    /**
+     * @brief Reads the records received at or after `fromMs`.
+     *
+     * Blocks that end before `fromMs` aren't decompressed.
+     *
+     * @param fromMs the time to start at, in milliseconds since epoch
+     * @param cb called with every record, returning false stops reading
+     */
+    void replay(qint64 fromMs,
+                const std::function<bool(const StructuredLogRecord &)> &cb);
+
+    /**
+     * @brief Reads the last `count` records, oldest first.
+     *
+     * Blocks are read backwards from the end of the file, so only the blocks
+     * holding these records are read. If the end of the file is cut off, the
+     * block headers are read from the start instead.
+     */
+    std::vector<StructuredLogRecord> readTail(size_t count);
+
+private:
+    void buildIndex();
+    std::optional<Block> readBlockHeader(qint64 offset);
+    std::vector<StructuredLogRecord> readRecords(const Block &block);
+
+    QFile file_;
+    std::vector<Block> blocks_;
+    qint64 validSize_ = 0;
+    bool indexed_ = false;
+};
+
+/// Returns the structured logs of `channelName` in `directory`, newest first
+QStringList findStructuredLogs(const QString &directory,
+                               const QString &channelName);
+
+/// Returns the last `count` records of `paths`, which are ordered newest
+/// first, oldest record first. Older files are only opened if the newer ones
+/// don't have enough records.
+std::vector<StructuredLogRecord> readStructuredLogTail(const QStringList &paths,
+                                                       size_t count);
+
+}  // namespace chatterino
@@ -0,0 +1,146 @@
+#include "util/AhoCorasick.hpp"
+
+#include <algorithm>
+#include <deque>
+
+namespace chatterino {
+
+AhoCorasick::AhoCorasick(Qt::CaseSensitivity caseSensitivity)
+    : caseSensitivity_(caseSensitivity)
+    , nodes_(1)
+{
+}
+
+size_t AhoCorasick::add(QStringView pattern)
+{
+    auto id = static_cast<uint32_t>(this->lengths_.size());
+    this->lengths_.push_back(pattern.size());
+    this->built_ = false;
+
+    if (pattern.isEmpty())
+    {
+        return id;
+    }
+
+    uint32_t node = 0;
+    for (auto qc : pattern)
+    {
+        auto c = this->fold(qc.unicode());
+        auto &next = this->nodes_[node].next;
+        auto it = std::lower_bound(next.begin(), next.end(), c,
+                                   [](const auto &edge, char16_t value) {
+                                       return edge.first < value;
+                                   });
+        if (it != next.end() && it->first == c)
+        {
+            node = it->second;
+            continue;
+        }
+
+        auto created = static_cast<uint32_t>(this->nodes_.size());
+        next.insert(it, {c, created});
+        // `next` might be dangling after this
+        this->nodes_.emplace_back();
+        node = created;
+    }
+    this->nodes_[node].patterns.push_back(id);
+
+    return id;
+}
+
+void AhoCorasick::build()
+{
+    std::deque<uint32_t> queue;
+    for (const auto &edge : this->nodes_[0].next)
+    {
+        this->nodes_[edge.second].fail = 0;
+        this->nodes_[edge.second].dictLink = NO_NODE;
+        queue.push_back(edge.second);
+    }
+
+    while (!queue.empty())
+    {
+        auto node = queue.front();
+        queue.pop_front();
+
+        for (const auto &[c, next] : this->nodes_[node].next)
+        {
+            auto fail = this->nodes_[node].fail;
+            while (fail != 0 && this->child(fail, c) == NO_NODE)
+            {
+                fail = this->nodes_[fail].fail;
+            }
+            auto target = this->child(fail, c);
+            if (target == NO_NODE)
+            {
+                target = 0;
+            }
+
+            auto &nextNode = this->nodes_[next];
+            nextNode.fail = target;
+            nextNode.dictLink = this->nodes_[target].patterns.empty()
+                                    ? this->nodes_[target].dictLink
+                                    : target;
+            queue.push_back(next);
+        }
+    }
+
+    this->built_ = true;
+}
+
+size_t AhoCorasick::size() const
+{
+    return this->lengths_.size();
+}
+
+bool AhoCorasick::empty() const
+{
+    return this->lengths_.empty();
+}
+
+qsizetype AhoCorasick::patternLength(size_t id) const
+{
+    return this->lengths_.at(id);
+}
+
+char16_t AhoCorasick::fold(char16_t c) const
+{
+    if (this->caseSensitivity_ == Qt::CaseSensitive)
+    {
+        return c;
+    }
+    return QChar(c).toCaseFolded().unicode();
+}
+
+uint32_t AhoCorasick::child(uint32_t node, char16_t c) const
+{
+    const auto &next = this->nodes_[node].next;
+    auto it = std::lower_bound(next.begin(), next.end(), c,
+                               [](const auto &edge, char16_t value) {
+                                   return edge.first < value;
+                               });
+    if (it != next.end() && it->first == c)
+    {
+        return it->second;
+    }
+    return NO_NODE;
+}
+
+uint32_t AhoCorasick::step(uint32_t state, char16_t c) const
+{
+    while (true)
+    {
+        auto next = this->child(state, c);
+        if (next != NO_NODE)
+        {
+            return next;
+        }
+        if (state == 0)
+        {
+            return 0;
+        }
+        state = this->nodes_[state].fail;
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <QString>
+#include <QStringView>
+
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace chatterino {
+
+/// AhoCorasick finds all occurrences of a set of literal patterns in a text
+/// with a single pass over the text.
+///
+/// Patterns are matched on UTF-16 code units. If the automaton is case
+/// insensitive, both the patterns and the text are simple case folded per
+/// code unit (characters outside the BMP are compared as-is).
+///
+/// Usage:
+///     AhoCorasick ac(Qt::CaseInsensitive);
+///     ac.add(u"foo");
+///     ac.add(u"bar");
+///     ac.build();
+///     ac.forEachMatch(text, [](size_t id, qsizetype end) {
+///         // ...
+///         return true;
+///     });
+class AhoCorasick
+{
+public:
+    explicit AhoCorasick(
+        Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive);
+
+    /// Adds `pattern` to the automaton and returns its id.
+    /// Ids are assigned sequentially, starting at 0.
+    /// Empty patterns are never reported.
+    size_t add(QStringView pattern);
+
+    /// Computes the failure links. Must be called after adding patterns and
+    /// before searching.
+    void build();
+
+    /// Returns the amount of patterns added
+    size_t size() const;
+    bool empty() const;
+
+    /// Returns the length of the pattern with the given id
+    qsizetype patternLength(size_t id) const;
+
+    /// Calls `cb(patternId, end)` for every occurrence of a pattern in `text`,
+    /// where `end` is the index one past the last character of the occurrence.
+    /// Occurrences are reported in order of their end index. Overlapping
+    /// occurrences are all reported. If `cb` returns false, the search stops.
+    template <typename Callback>
+    void forEachMatch(QStringView text, Callback &&cb) const
+    {
+        assert(this->built_);
+
+        uint32_t state = 0;
+        for (qsizetype i = 0; i < text.size(); ++i)
+        {
+            state = this->step(state, this->fold(text[i].unicode()));
+            for (auto node = state; node != NO_NODE;
+                 node = this->nodes_[node].dictLink)
+            {
+                for (auto id : this->nodes_[node].patterns)
+                {
+                    if (!cb(static_cast<size_t>(id), i + 1))
+                    {
+                        return;
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr uint32_t NO_NODE = UINT32_MAX;
+
+    struct Node {
+        /// Sorted by character
+        std::vector<std::pair<char16_t, uint32_t>> next;
+        /// Longest proper suffix of this node that's also in the trie
+        uint32_t fail = 0;
+        /// Closest node on the failure chain that ends a pattern
+        uint32_t dictLink = NO_NODE;
+        /// Patterns ending at this node
+        std::vector<uint32_t> patterns;
+    };
+
+    char16_t fold(char16_t c) const;
+    uint32_t child(uint32_t node, char16_t c) const;
+    uint32_t step(uint32_t state, char16_t c) const;
+
+    Qt::CaseSensitivity caseSensitivity_;
+    std::vector<Node> nodes_;
+    std::vector<qsizetype> lengths_;
+    bool built_ = true;
+};
+
+}  // namespace chatterino
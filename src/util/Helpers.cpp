@@ -8,6 +8,8 @@
 #include <QRegularExpression>
 #include <QUuid>
 
+#include <cstring>
+
 namespace {
 
 const QString ZERO_WIDTH_JOINER = QStringLiteral("\u200D");
@@ -18,6 +20,13 @@ const QRegularExpression ESCAPE_TAG_REGEX(
     QStringLiteral("(?<!\U000E0002)\U000E0002"),
     QRegularExpression::UseUnicodePropertiesOption);
 
+// U+E0002 and U+200D in UTF-8
+constexpr const char ESCAPE_TAG_UTF8[] = "\xF3\xA0\x80\x82";
+constexpr qsizetype ESCAPE_TAG_UTF8_SIZE = sizeof(ESCAPE_TAG_UTF8) - 1;
+constexpr const char ZERO_WIDTH_JOINER_UTF8[] = "\xE2\x80\x8D";
+constexpr qsizetype ZERO_WIDTH_JOINER_UTF8_SIZE =
+    sizeof(ZERO_WIDTH_JOINER_UTF8) - 1;
+
 }  // namespace
 
 namespace chatterino {
@@ -302,6 +311,45 @@ QString unescapeZeroWidthJoiner(QString escaped)
     return escaped;
 }
 
+QByteArray unescapeZeroWidthJoiner(QByteArray escaped)
+{
+    auto index = escaped.indexOf(ESCAPE_TAG_UTF8);
+    if (index < 0)
+    {
+        return escaped;
+    }
+
+    QByteArray unescaped;
+    unescaped.reserve(escaped.size());
+
+    qsizetype from = 0;
+    while (index >= 0)
+    {
+        unescaped.append(escaped.constData() + from, index - from);
+
+        // only the first escape tag of a sequence is replaced
+        bool afterTag =
+            index >= ESCAPE_TAG_UTF8_SIZE &&
+            std::memcmp(escaped.constData() + index - ESCAPE_TAG_UTF8_SIZE,
+                        ESCAPE_TAG_UTF8, ESCAPE_TAG_UTF8_SIZE) == 0;
+        if (afterTag)
+        {
+            unescaped.append(ESCAPE_TAG_UTF8, ESCAPE_TAG_UTF8_SIZE);
+        }
+        else
+        {
+            unescaped.append(ZERO_WIDTH_JOINER_UTF8,
+                             ZERO_WIDTH_JOINER_UTF8_SIZE);
+        }
+
+        from = index + ESCAPE_TAG_UTF8_SIZE;
+        index = escaped.indexOf(ESCAPE_TAG_UTF8, from);
+    }
+    unescaped.append(escaped.constData() + from, escaped.size() - from);
+
+    return unescaped;
+}
+
 QLocale getSystemLocale()
 {
 #ifdef CHATTERINO_WITH_TESTS
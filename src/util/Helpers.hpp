@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QByteArray>
 #include <QColor>
 #include <QLocale>
 #include <QString>
@@ -189,6 +190,11 @@ constexpr std::optional<std::decay_t<T>> makeConditionedOptional(bool condition,
 /// a ZWJ. See also: https://github.com/Chatterino/chatterino2/issues/3384.
 QString unescapeZeroWidthJoiner(QString escaped);
 
+/// @brief Unescapes zero width joiners in UTF-8 encoded messages
+///
+/// Same as unescapeZeroWidthJoiner(QString) without decoding the message.
+QByteArray unescapeZeroWidthJoiner(QByteArray escaped);
+
 QLocale getSystemLocale();
 
 }  // namespace chatterino
@@ -16,6 +16,7 @@ void loadPixmapFromUrl(const Url &url, std::function<void(QPixmap)> &&callback)
     NetworkRequest(url.string)
         .concurrent()
         .cache()
+        .priority(NetworkPriority::Images)
         .onSuccess(
             [callback = std::move(callback), url](const NetworkResult &result) {
                 auto data = result.getData();
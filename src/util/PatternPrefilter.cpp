@@ -0,0 +1,190 @@
+#include "util/PatternPrefilter.hpp"
+
+#include <QStringBuilder>
+#include <QStringList>
+
+#include <algorithm>
+
+namespace {
+
+// Constructs which refer to other parts of the pattern, change how the rest
+// of the pattern is parsed or depend on where the match started. These can't
+// be combined with other patterns.
+const QRegularExpression UNCOMBINABLE_CONSTRUCTS(
+    R"(\\[0-9cgkGKQ]|\(\?(?:P|&|R|\||'|<[A-Za-z_]|[+-]?[0-9]|[A-Za-z^-]*x)|\(\*)");
+
+/// Name of the capture group of the n-th combined pattern
+QString groupName(size_t n)
+{
+    return u"p" % QString::number(n);
+}
+
+}  // namespace
+
+namespace chatterino {
+
+PatternPrefilter::PatternPrefilter()
+    : literals_(Qt::CaseInsensitive)
+{
+}
+
+size_t PatternPrefilter::add(const QString &pattern, bool isRegex,
+                             Qt::CaseSensitivity caseSensitivity)
+{
+    auto index = this->size_++;
+
+    if (pattern.isEmpty())
+    {
+        return index;
+    }
+
+    if (!isRegex)
+    {
+        // Characters outside the BMP aren't case folded by the automaton
+        bool hasSurrogates =
+            std::any_of(pattern.begin(), pattern.end(), [](QChar c) {
+                return c.isSurrogate();
+            });
+        if (hasSurrogates && caseSensitivity == Qt::CaseInsensitive)
+        {
+            this->otherPatterns_.push_back(index);
+            return index;
+        }
+
+        this->literals_.add(pattern);
+        this->literalPatterns_.push_back(index);
+        return index;
+    }
+
+    QRegularExpression regex(pattern,
+                             QRegularExpression::UseUnicodePropertiesOption);
+    if (!regex.isValid())
+    {
+        return index;
+    }
+
+    if (isCombinable(pattern))
+    {
+        this->combinedPatterns_.push_back({
+            .index = index,
+            .pattern = pattern,
+            .caseSensitivity = caseSensitivity,
+        });
+    }
+    else
+    {
+        this->otherPatterns_.push_back(index);
+    }
+
+    return index;
+}
+
+void PatternPrefilter::build()
+{
+    this->literals_.build();
+
+    if (this->combinedPatterns_.empty())
+    {
+        return;
+    }
+
+    // The alternation in front only lets positions through where any pattern
+    // matches. Every pattern is then tried in an optional lookahead at that
+    // position, so patterns that match at the same position or overlap are
+    // all captured.
+    QStringList alternatives;
+    QString captures;
+    alternatives.reserve(
+        static_cast<qsizetype>(this->combinedPatterns_.size()));
+    for (size_t i = 0; i < this->combinedPatterns_.size(); i++)
+    {
+        const auto &combined = this->combinedPatterns_[i];
+        auto group = combined.caseSensitivity == Qt::CaseSensitive
+                         ? QStringLiteral("(?:")
+                         : QStringLiteral("(?i:");
+        QString alternative = group % combined.pattern % ')';
+        alternatives.append(alternative);
+        captures += u"(?:(?=(?<" % groupName(i) % '>' % alternative % u"))|)";
+    }
+
+    this->combined_ = QRegularExpression(
+        u"(?=" % alternatives.join('|') % ')' % captures,
+        QRegularExpression::UseUnicodePropertiesOption);
+    if (!this->combined_.isValid())
+    {
+        // Fall back to treating every regex as a candidate
+        for (const auto &combined : this->combinedPatterns_)
+        {
+            this->otherPatterns_.push_back(combined.index);
+        }
+        this->combinedPatterns_.clear();
+        return;
+    }
+    this->combined_.optimize();
+
+    // Unnamed groups of the patterns are numbered too
+    auto names = this->combined_.namedCaptureGroups();
+    this->exact_.assign(this->size_, false);
+    for (size_t i = 0; i < this->combinedPatterns_.size(); i++)
+    {
+        auto &combined = this->combinedPatterns_[i];
+        combined.group = static_cast<int>(names.indexOf(groupName(i)));
+        this->exact_[combined.index] = true;
+    }
+}
+
+std::vector<bool> PatternPrefilter::candidates(const QString &subject) const
+{
+    std::vector<bool> result(this->size_, false);
+
+    if (!this->literalPatterns_.empty())
+    {
+        this->literals_.forEachMatch(subject, [&](size_t id, qsizetype) {
+            result[this->literalPatterns_[id]] = true;
+            return true;
+        });
+    }
+
+    if (!this->combinedPatterns_.empty())
+    {
+        size_t found = 0;
+        auto it = this->combined_.globalMatch(subject);
+        while (found < this->combinedPatterns_.size() && it.hasNext())
+        {
+            auto match = it.next();
+            for (const auto &combined : this->combinedPatterns_)
+            {
+                if (!result[combined.index] &&
+                    match.capturedStart(combined.group) >= 0)
+                {
+                    result[combined.index] = true;
+                    found++;
+                }
+            }
+        }
+    }
+
+    for (auto index : this->otherPatterns_)
+    {
+        result[index] = true;
+    }
+
+    return result;
+}
+
+bool PatternPrefilter::isExact(size_t index) const
+{
+    return index < this->exact_.size() && this->exact_[index];
+}
+
+size_t PatternPrefilter::size() const
+{
+    return this->size_;
+}
+
+bool PatternPrefilter::isCombinable(const QString &pattern)
+{
+    return !UNCOMBINABLE_CONSTRUCTS.match(pattern).hasMatch();
+}
+
+}  // namespace chatterino
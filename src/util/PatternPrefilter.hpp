@@ -0,0 +1,76 @@
+#pragma once
+
+#include "util/AhoCorasick.hpp"
+
+#include <QRegularExpression>
+#include <QString>
+
+#include <vector>
+
+namespace chatterino {
+
+/// PatternPrefilter quickly rules out patterns that can't match a subject.
+///
+/// Literal patterns are found with a single case-folded Aho-Corasick pass
+/// over the subject. Literal patterns that pass the prefilter still have to
+/// be checked on their own, e.g. for word boundaries or case.
+///
+/// Regex patterns are combined into one regex with a capture group per
+/// pattern, which finds all matching patterns in one pass. These results are
+/// exact (see isExact()). Patterns that can't be combined are always
+/// candidates.
+///
+/// Empty patterns and invalid regexes are never candidates.
+class PatternPrefilter
+{
+public:
+    PatternPrefilter();
+
+    /// Adds a pattern and returns its index in the result of candidates().
+    /// Regex patterns are interpreted with the UseUnicodePropertiesOption.
+    size_t add(const QString &pattern, bool isRegex,
+               Qt::CaseSensitivity caseSensitivity);
+
+    /// Must be called after all patterns have been added
+    void build();
+
+    /// Returns the patterns that might match `subject`. If the n-th entry
+    /// is false, pattern n doesn't occur in (or match) the subject.
+    std::vector<bool> candidates(const QString &subject) const;
+
+    /// Returns true if the result of candidates() for pattern `index` is
+    /// exact, so the pattern doesn't have to be checked on its own
+    bool isExact(size_t index) const;
+
+    size_t size() const;
+
+    /// Returns true if the regex pattern can be part of a combined
+    /// alternation without changing its meaning
+    static bool isCombinable(const QString &pattern);
+
+private:
+    size_t size_ = 0;
+
+    AhoCorasick literals_;
+    /// Index of each pattern in `literals_`
+    std::vector<size_t> literalPatterns_;
+
+    struct CombinedPattern {
+        size_t index;
+        QString pattern;
+        Qt::CaseSensitivity caseSensitivity;
+        /// Number of the capture group of this pattern in `combined_`
+        int group = 0;
+    };
+    std::vector<CombinedPattern> combinedPatterns_;
+    /// Matches at every position one of the combined patterns matches at,
+    /// capturing each pattern that matches there
+    QRegularExpression combined_;
+    /// Set for the patterns in `combinedPatterns_`, by index
+    std::vector<bool> exact_;
+
+    /// Patterns that are always candidates
+    std::vector<size_t> otherPatterns_;
+};
+
+}  // namespace chatterino
@@ -8,6 +8,7 @@
 #include "controllers/commands/CommandController.hpp"
 #include "controllers/filters/FilterSet.hpp"
 #include "debug/Benchmark.hpp"
+#include "debug/Trace.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/layouts/MessageLayout.hpp"
@@ -1538,6 +1539,7 @@ void ChannelView::scrollToMessageLayout(MessageLayout *layout,
 void ChannelView::paintEvent(QPaintEvent *event)
 {
     //    BenchmarkGuard benchmark("paint");
+    TraceSpan span("ChannelView::paintEvent", "paint");
 
     QPainter painter(this);
 
@@ -1546,6 +1548,13 @@ void ChannelView::paintEvent(QPaintEvent *event)
     // draw messages
     this->drawMessages(painter, event->rect());
 
+    static bool firstPaint = true;
+    if (firstPaint && Trace::isRecording())
+    {
+        firstPaint = false;
+        Trace::instant("paint", QStringLiteral("First paint"));
+    }
+
     // draw paused sign
     if (this->paused())
     {
@@ -1,10 +1,12 @@
 #include "widgets/helper/DebugPopup.hpp"
 
 #include "common/Literals.hpp"
+#include "common/network/NetworkMetrics.hpp"
 #include "util/Clipboard.hpp"
 #include "util/DebugCount.hpp"
 
 #include <QFontDatabase>
+#include <QJsonDocument>
 #include <QLabel>
 #include <QPushButton>
 #include <QTimer>
@@ -18,23 +20,35 @@ DebugPopup::DebugPopup()
 {
     auto *layout = new QVBoxLayout(this);
     auto *text = new QLabel(this);
+    auto *networkText = new QLabel(this);
     auto *timer = new QTimer(this);
     auto *copyButton = new QPushButton(u"&Copy"_s);
+    auto *copyNetworkButton =
+        new QPushButton(u"Copy &network metrics as JSON"_s);
 
-    QObject::connect(timer, &QTimer::timeout, [text] {
+    auto update = [text, networkText] {
         text->setText(DebugCount::getDebugText());
-    });
+        networkText->setText(NetworkMetrics::getDebugText());
+    };
+    QObject::connect(timer, &QTimer::timeout, update);
     timer->start(300);
-    text->setText(DebugCount::getDebugText());
+    update();
 
     text->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    networkText->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
 
     layout->addWidget(text);
+    layout->addWidget(networkText);
     layout->addWidget(copyButton, 1);
+    layout->addWidget(copyNetworkButton, 1);
 
     QObject::connect(copyButton, &QPushButton::clicked, this, [text] {
         crossPlatformCopy(text->text());
     });
+    QObject::connect(copyNetworkButton, &QPushButton::clicked, this, [] {
+        crossPlatformCopy(QString::fromUtf8(
+            QJsonDocument(NetworkMetrics::toJson()).toJson()));
+    });
 }
 
 }  // namespace chatterino
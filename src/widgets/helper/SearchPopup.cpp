@@ -4,64 +4,189 @@
 #include "common/Channel.hpp"
 #include "controllers/filters/FilterSet.hpp"
 #include "controllers/hotkeys/HotkeyController.hpp"
+#include "debug/AssertInGuiThread.hpp"
 #include "messages/MessageElement.hpp"
-#include "messages/search/AuthorPredicate.hpp"
-#include "messages/search/BadgePredicate.hpp"
-#include "messages/search/ChannelPredicate.hpp"
-#include "messages/search/LinkPredicate.hpp"
-#include "messages/search/MessageFlagsPredicate.hpp"
-#include "messages/search/RegexPredicate.hpp"
-#include "messages/search/SubstringPredicate.hpp"
-#include "messages/search/SubtierPredicate.hpp"
+#include "messages/search/LogSearch.hpp"
+#include "messages/search/MessageSearchIndex.hpp"
+#include "messages/search/PredicateParser.hpp"
+#include "singletons/helper/LoggingChannel.hpp"
+#include "singletons/Paths.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/WindowManager.hpp"
+#include "util/PostToThread.hpp"
 #include "widgets/helper/ChannelView.hpp"
 #include "widgets/splits/Split.hpp"
 
+#include <QCheckBox>
+#include <QDir>
 #include <QHBoxLayout>
 #include <QLineEdit>
+#include <QPointer>
 #include <QPushButton>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <unordered_set>
 
 namespace chatterino {
 
-ChannelPtr SearchPopup::filter(const QString &text, const QString &channelName,
-                               const LimitedQueueSnapshot<MessagePtr> &snapshot)
+namespace {
+
+using Predicates = std::vector<std::unique_ptr<MessagePredicate>>;
+/// Channels are only referenced weakly, so they're never destroyed on a
+/// worker thread
+using WeakChannels = std::vector<std::weak_ptr<Channel>>;
+
+/// Amount of messages searched by one task
+constexpr size_t SEARCH_CHUNK_SIZE = 1024;
+
+/// A message with its flags at the time the search started. The GUI thread
+/// keeps changing the flags (e.g. on timeouts), so the search tasks must
+/// not read `message->flags`.
+struct SearchedMessage {
+    MessagePtr message;
+    MessageFlags flags;
+};
+
+/// Pairs `messages` with their current flags
+std::vector<SearchedMessage> readFlags(const std::vector<MessagePtr> &messages)
+{
+    assertInGuiThread();
+
+    std::vector<SearchedMessage> searched;
+    searched.reserve(messages.size());
+    for (const auto &message : messages)
+    {
+        searched.push_back({message, message->flags});
+    }
+    return searched;
+}
+
+/// Merges the messages of multiple channels into one list sorted by time
+std::vector<SearchedMessage> mergeSnapshots(
+    std::vector<std::vector<SearchedMessage>> snapshots)
 {
-    ChannelPtr channel(new Channel(channelName, Channel::Type::None));
+    // no point in sorting if it's a single channel search
+    if (snapshots.size() == 1)
+    {
+        return std::move(snapshots.front());
+    }
 
-    // Parse predicates from tags in "text"
-    auto predicates = parsePredicates(text);
+    std::vector<SearchedMessage> combined;
+    for (auto &snapshot : snapshots)
+    {
+        std::ranges::move(snapshot, std::back_inserter(combined));
+    }
+
+    std::ranges::stable_sort(combined, [](const auto &a, const auto &b) {
+        return a.message->serverReceivedTime < b.message->serverReceivedTime;
+    });
+
+    // remove any duplicate messages from splits containing the same channel
+    std::unordered_set<QString> seenIds;
+    std::erase_if(combined, [&](const SearchedMessage &searched) {
+        const auto &id = searched.message->id;
+        // messages without an id (e.g. system messages) are never dropped
+        return !id.isEmpty() && !seenIds.insert(id).second;
+    });
+
+    return combined;
+}
 
-    // Check for every message whether it fulfills all predicates that have
-    // been registered
-    for (size_t i = 0; i < snapshot.size(); ++i)
+/// Looks up the messages of `snapshot` that can't satisfy all predicates in
+/// the search indices of `channels`. Every index is locked once. Returns an
+/// empty list if the predicates can't be looked up.
+std::vector<bool> findRuledOut(const std::vector<SearchedMessage> &snapshot,
+                               const Predicates &predicates,
+                               const WeakChannels &channels)
+{
+    std::vector<bool> ruledOut(snapshot.size(), false);
+    std::vector<ChannelPtr> locked;
+    for (const auto &weak : channels)
     {
-        MessagePtr message = snapshot[i];
+        auto channel = weak.lock();
+        if (!channel)
+        {
+            continue;
+        }
+        locked.push_back(channel);
+        auto index = channel->accessSearchIndex();
 
-        bool accept = true;
+        std::optional<MessageSearchIndex::Postings> postings;
         for (const auto &pred : predicates)
         {
-            // Discard the message as soon as one predicate fails
-            if (!pred->appliesTo(*message))
+            auto found = pred->candidates(*index);
+            if (!found)
             {
-                accept = false;
-                break;
+                continue;
             }
+            postings = postings
+                           ? MessageSearchIndex::intersect(*postings, *found)
+                           : std::move(*found);
         }
 
-        // If all predicates match, add the message to the channel
-        if (accept)
+        if (!postings)
         {
-            auto overrideFlags = std::optional<MessageFlags>(message->flags);
-            overrideFlags->set(MessageFlag::DoNotLog);
+            ruledOut.clear();
+            break;
+        }
 
-            channel->addMessage(message, MessageContext::Repost, overrideFlags);
+        // Messages removed from their channel since the snapshot was taken
+        // aren't in the index anymore, so these still have to be checked.
+        auto candidates = index->resolve(*postings);
+        for (size_t i = 0; i < snapshot.size(); i++)
+        {
+            const auto &message = *snapshot[i].message;
+            if (!candidates.contains(&message) && index->contains(message))
+            {
+                ruledOut[i] = true;
+            }
         }
     }
 
-    return channel;
+    // A channel closed in the meantime must not be destroyed on this thread
+    postToThread([locked = std::move(locked)] {});
+
+    return ruledOut;
 }
 
+/// Returns the messages in [begin, end) of `snapshot` that satisfy all
+/// predicates
+std::vector<MessagePtr> searchChunk(
+    const std::vector<SearchedMessage> &snapshot, size_t begin, size_t end,
+    const Predicates &predicates, const std::vector<bool> &ruledOut,
+    const CancellationToken &token)
+{
+    std::vector<MessagePtr> results;
+    for (size_t i = begin; i < end; i++)
+    {
+        if (!ruledOut.empty() && ruledOut[i])
+        {
+            continue;
+        }
+        if (token.isCancelled())
+        {
+            return {};
+        }
+
+        const auto &searched = snapshot[i];
+        // Discard the message as soon as one predicate fails
+        bool accept = std::ranges::all_of(predicates, [&](const auto &pred) {
+            return pred->appliesTo(*searched.message, searched.flags);
+        });
+        if (accept)
+        {
+            results.push_back(searched.message);
+        }
+    }
+
+    return results;
+}
+
+}  // namespace
+
 SearchPopup::SearchPopup(QWidget *parent, Split *split)
     : BasePopup(
           {
@@ -214,33 +339,228 @@ bool SearchPopup::eventFilter(QObject *object, QEvent *event)
 
 void SearchPopup::search()
 {
-    if (this->snapshot_.size() == 0)
+    CancellationToken token(false);
+    this->searchToken_ = token;
+
+    this->results_ =
+        std::make_shared<Channel>(this->channelName_, Channel::Type::None);
+    this->nextChunk_ = 0;
+    this->pendingChunks_.clear();
+    this->channelView_->setChannel(this->results_);
+
+    if (this->searchLogs_->isChecked())
     {
-        this->snapshot_ = this->buildSnapshot();
+        this->searchLogs(token);
+        return;
     }
 
-    this->channelView_->setChannel(filter(this->searchInput_->text(),
-                                          this->channelName_, this->snapshot_));
+    // The flags are read now, the rest of the messages doesn't change
+    std::shared_ptr<const std::vector<SearchedMessage>> searched;
+    std::vector<std::vector<SearchedMessage>> snapshots;
+    if (this->snapshot_)
+    {
+        searched = std::make_shared<const std::vector<SearchedMessage>>(
+            readFlags(*this->snapshot_));
+    }
+    else
+    {
+        for (const auto &snapshot : this->collectSnapshots())
+        {
+            snapshots.push_back(readFlags(snapshot));
+        }
+    }
+
+    // Merging the snapshots and checking the predicates happens on the
+    // thread pool. Results are added to the channel as chunks finish.
+    QPointer<SearchPopup> self(this);
+    auto text = this->searchInput_->text();
+    WeakChannels channels;
+    for (const auto &channel : this->searchedChannels())
+    {
+        channels.emplace_back(channel);
+    }
+    std::ignore = QtConcurrent::run([self, token, text, channels, searched,
+                                     snapshots =
+                                         std::move(snapshots)]() mutable {
+        if (!searched)
+        {
+            searched = std::make_shared<const std::vector<SearchedMessage>>(
+                mergeSnapshots(std::move(snapshots)));
+
+            auto snapshot = std::make_shared<std::vector<MessagePtr>>();
+            snapshot->reserve(searched->size());
+            for (const auto &message : *searched)
+            {
+                snapshot->push_back(message.message);
+            }
+            postToThread([self, snapshot = std::move(snapshot)] {
+                if (self)
+                {
+                    self->snapshot_ = snapshot;
+                }
+            });
+        }
+        if (token.isCancelled())
+        {
+            return;
+        }
+
+        auto ruledOut = std::make_shared<const std::vector<bool>>(
+            findRuledOut(*searched, parsePredicates(text), channels));
+
+        for (size_t begin = 0, chunk = 0; begin < searched->size();
+             begin += SEARCH_CHUNK_SIZE, chunk++)
+        {
+            auto end = std::min(begin + SEARCH_CHUNK_SIZE, searched->size());
+            std::ignore = QtConcurrent::run([self, token, text, searched,
+                                             ruledOut, begin, end, chunk] {
+                if (token.isCancelled())
+                {
+                    return;
+                }
+
+                // Predicates aren't shared between threads
+                auto results = searchChunk(*searched, begin, end,
+                                           parsePredicates(text), *ruledOut,
+                                           token);
+                postToThread([self, token, chunk,
+                              results = std::move(results)]() mutable {
+                    if (self && !token.isCancelled())
+                    {
+                        self->addSearchResults(chunk, std::move(results));
+                    }
+                });
+            });
+        }
+    });
 }
 
-LimitedQueueSnapshot<MessagePtr> SearchPopup::buildSnapshot()
+void SearchPopup::searchLogs(const CancellationToken &token)
 {
-    // no point in filtering/sorting if it's a single channel search
+    auto text = this->searchInput_->text();
+    if (text.trimmed().isEmpty())
+    {
+        // Logs are too large to show in full
+        return;
+    }
+
+    QPointer<SearchPopup> self(this);
+    std::ignore = QtConcurrent::run([self, token, text,
+                                     directories = this->logDirectories()] {
+        QStringList files;
+        for (const auto &directory : directories)
+        {
+            files += findLogFiles(directory);
+        }
+
+        for (size_t chunk = 0; chunk < static_cast<size_t>(files.size());
+             chunk++)
+        {
+            std::ignore = QtConcurrent::run([self, token, text, chunk,
+                                             path = files.at(chunk)] {
+                if (token.isCancelled())
+                {
+                    return;
+                }
+
+                auto results = searchLogFile(path, text, token);
+                postToThread([self, token, chunk,
+                              results = std::move(results)] {
+                    if (!self || token.isCancelled())
+                    {
+                        return;
+                    }
+
+                    std::vector<MessagePtr> messages;
+                    messages.reserve(results.size());
+                    for (const auto &result : results)
+                    {
+                        messages.push_back(makeLogMessage(result));
+                    }
+                    self->addSearchResults(chunk, std::move(messages));
+                });
+            });
+        }
+    });
+}
+
+QStringList SearchPopup::logDirectories() const
+{
+    QString base = getSettings()->logPath.getValue();
+    if (base.isEmpty())
+    {
+        base = getApp()->getPaths().messageLogDirectory;
+    }
+
+    QStringList directories;
+    for (const auto &channel : this->searchedChannels())
+    {
+        directories.append(base + QDir::separator() +
+                           LoggingChannel::subDirectoryFor(
+                               channel->getName(), channel->getPlatform()));
+    }
+    directories.removeDuplicates();
+    return directories;
+}
+
+void SearchPopup::addSearchResults(size_t chunk,
+                                   std::vector<MessagePtr> messages)
+{
+    this->pendingChunks_.emplace(chunk, std::move(messages));
+
+    auto it = this->pendingChunks_.begin();
+    while (it != this->pendingChunks_.end() && it->first == this->nextChunk_)
+    {
+        for (const auto &message : it->second)
+        {
+            auto overrideFlags = std::optional<MessageFlags>(message->flags);
+            overrideFlags->set(MessageFlag::DoNotLog);
+
+            this->results_->addMessage(message, MessageContext::Repost,
+                                       overrideFlags);
+        }
+
+        it = this->pendingChunks_.erase(it);
+        this->nextChunk_++;
+    }
+}
+
+std::vector<ChannelPtr> SearchPopup::searchedChannels() const
+{
+    std::vector<ChannelPtr> channels;
+    for (const auto &view : this->searchChannels_)
+    {
+        auto channel = view.get().channel();
+        if (std::ranges::find(channels, channel) == channels.end())
+        {
+            channels.push_back(std::move(channel));
+        }
+    }
+    return channels;
+}
+
+std::vector<std::vector<MessagePtr>> SearchPopup::collectSnapshots() const
+{
+    // no point in filtering if it's a single channel search
     if (this->searchChannels_.length() == 1)
     {
-        const auto channelPtr = this->searchChannels_.at(0);
-        return channelPtr.get().channel()->getMessageSnapshot();
+        auto snapshot =
+            this->searchChannels_.at(0).get().channel()->getMessageSnapshot();
+        return {{snapshot.begin(), snapshot.end()}};
     }
 
-    auto combinedSnapshot = std::vector<std::shared_ptr<const Message>>{};
-    for (auto &channel : this->searchChannels_)
+    std::vector<std::vector<MessagePtr>> snapshots;
+    for (const auto &channel : this->searchChannels_)
     {
         ChannelView &sharedView = channel.get();
 
+        // The filters have to be checked on the GUI thread
         const FilterSetPtr filterSet = sharedView.getFilterSet();
         const LimitedQueueSnapshot<MessagePtr> &snapshot =
             sharedView.channel()->getMessageSnapshot();
 
+        auto &messages = snapshots.emplace_back();
+        messages.reserve(snapshot.size());
         for (const auto &message : snapshot)
         {
             if (filterSet && !filterSet->filter(message, sharedView.channel()))
@@ -248,35 +568,11 @@ LimitedQueueSnapshot<MessagePtr> SearchPopup::buildSnapshot()
                 continue;
             }
 
-            combinedSnapshot.push_back(message);
+            messages.push_back(message);
         }
     }
 
-    // remove any duplicate messages from splits containing the same channel
-    std::sort(combinedSnapshot.begin(), combinedSnapshot.end(),
-              [](MessagePtr &a, MessagePtr &b) {
-                  return a->id > b->id;
-              });
-
-    auto uniqueIterator =
-        std::unique(combinedSnapshot.begin(), combinedSnapshot.end(),
-                    [](MessagePtr &a, MessagePtr &b) {
-                        // nullptr check prevents system messages from being dropped
-                        return (a->id != nullptr) && a->id == b->id;
-                    });
-
-    combinedSnapshot.erase(uniqueIterator, combinedSnapshot.end());
-
-    // resort by time for presentation
-    std::sort(combinedSnapshot.begin(), combinedSnapshot.end(),
-              [](MessagePtr &a, MessagePtr &b) {
-                  return a->serverReceivedTime < b->serverReceivedTime;
-              });
-
-    auto queue = LimitedQueue<MessagePtr>(combinedSnapshot.size());
-    queue.pushFront(combinedSnapshot);
-
-    return queue.getSnapshot();
+    return snapshots;
 }
 
 void SearchPopup::initLayout()
@@ -307,6 +603,18 @@ void SearchPopup::initLayout()
                 this->searchInput_->installEventFilter(this);
             }
 
+            // LOGS
+            {
+                this->searchLogs_ = new QCheckBox("Logs", this);
+                this->searchLogs_->setToolTip(
+                    "Search the log files of this channel instead of its "
+                    "current history");
+                layout2->addWidget(this->searchLogs_);
+
+                QObject::connect(this->searchLogs_, &QCheckBox::toggled, this,
+                                 &SearchPopup::search);
+            }
+
             layout1->addLayout(layout2);
         }
 
@@ -325,75 +633,4 @@ void SearchPopup::initLayout()
     this->searchInput_->setFocus();
 }
 
-std::vector<std::unique_ptr<MessagePredicate>> SearchPopup::parsePredicates(
-    const QString &input)
-{
-    // This regex captures all name:value predicate pairs into named capturing
-    // groups and matches all other inputs seperated by spaces as normal
-    // strings.
-    // It also ignores whitespaces in values when being surrounded by quotation
-    // marks, to enable inputs like this => regex:"kappa 123"
-    static QRegularExpression predicateRegex(
-        R"lit((?<negation>[!\-])?(?:(?<name>\w+):(?<value>".+?"|[^\s]+))|[^\s]+?(?=$|\s))lit");
-    static QRegularExpression trimQuotationMarksRegex(R"(^"|"$)");
-
-    QRegularExpressionMatchIterator it = predicateRegex.globalMatch(input);
-
-    std::vector<std::unique_ptr<MessagePredicate>> predicates;
-
-    while (it.hasNext())
-    {
-        QRegularExpressionMatch match = it.next();
-
-        QString name = match.captured("name");
-        bool isNegated = !match.captured("negation").isEmpty();
-        QString value = match.captured("value");
-        value.remove(trimQuotationMarksRegex);
-
-        // match predicates
-
-        if (name == "from")
-        {
-            predicates.push_back(
-                std::make_unique<AuthorPredicate>(value, isNegated));
-        }
-        else if (name == "badge")
-        {
-            predicates.push_back(
-                std::make_unique<BadgePredicate>(value, isNegated));
-        }
-        else if (name == "subtier")
-        {
-            predicates.push_back(
-                std::make_unique<SubtierPredicate>(value, isNegated));
-        }
-        else if (name == "has" && value == "link")
-        {
-            predicates.push_back(std::make_unique<LinkPredicate>(isNegated));
-        }
-        else if (name == "in")
-        {
-            predicates.push_back(
-                std::make_unique<ChannelPredicate>(value, isNegated));
-        }
-        else if (name == "is")
-        {
-            predicates.push_back(
-                std::make_unique<MessageFlagsPredicate>(value, isNegated));
-        }
-        else if (name == "regex")
-        {
-            predicates.push_back(
-                std::make_unique<RegexPredicate>(value, isNegated));
-        }
-        else
-        {
-            predicates.push_back(
-                std::make_unique<SubstringPredicate>(match.captured()));
-        }
-    }
-
-    return predicates;
-}
-
 }  // namespace chatterino
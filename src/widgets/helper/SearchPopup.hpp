@@ -1,17 +1,19 @@
 #pragma once
 
 #include "ForwardDecl.hpp"
-#include "messages/LimitedQueueSnapshot.hpp"
+#include "util/CancellationToken.hpp"
 #include "widgets/BasePopup.hpp"
 
+#include <map>
 #include <memory>
+#include <vector>
 
+class QCheckBox;
 class QLineEdit;
 
 namespace chatterino {
 
 class Split;
-class MessagePredicate;
 
 class SearchPopup : public BasePopup
 {
@@ -36,36 +38,56 @@ protected:
 private:
     void initLayout();
     void search();
+
+    /**
+     * @brief Searches the log files of the searched channels.
+     *
+     * Every log file is searched by its own task. Its results are added like
+     * the results of a chunk.
+     *
+     * @param token cancels the search
+     */
+    void searchLogs(const CancellationToken &token);
+
+    /// Returns the directories the searched channels are logged to
+    QStringList logDirectories() const;
     void addShortcuts() override;
-    LimitedQueueSnapshot<MessagePtr> buildSnapshot();
 
     /**
-     * @brief Only retains those message from a list of messages that satisfy a
-     *        search query.
+     * @brief Collects the messages of all searched channels.
      *
-     * @param text          the search query -- will be parsed for MessagePredicates
-     * @param channelName   name of the channel to be returned
-     * @param snapshot      list of messages to filter
-     * @param filterSet     channel filter to apply
+     * Messages hidden by the filters of a split are skipped. The result has
+     * to be merged with mergeSnapshots before searching it.
      *
-     * @return a ChannelPtr with "channelName" and the filtered messages from
-     *         "snapshot"
+     * @return the messages of each searched channel
      */
-    static ChannelPtr filter(const QString &text, const QString &channelName,
-                             const LimitedQueueSnapshot<MessagePtr> &snapshot);
+    std::vector<std::vector<MessagePtr>> collectSnapshots() const;
+
+    /// Returns the searched channels without duplicates
+    std::vector<ChannelPtr> searchedChannels() const;
 
     /**
-     * @brief Checks the input for tags and registers their corresponding
-     *        predicates.
+     * @brief Adds the messages of a finished chunk to the search results.
+     *
+     * Chunks can finish in any order. Their messages are held back until all
+     * previous chunks finished.
      *
-     * @param input the string to check for tags
-     * @return a vector of MessagePredicates requested in the input
+     * @param chunk the index of the chunk in the snapshot
+     * @param messages the messages of the chunk that satisfy the search query
      */
-    static std::vector<std::unique_ptr<MessagePredicate>> parsePredicates(
-        const QString &input);
+    void addSearchResults(size_t chunk, std::vector<MessagePtr> messages);
+
+    /// Merged messages of all searched channels, built on the first search
+    std::shared_ptr<const std::vector<MessagePtr>> snapshot_;
+
+    /// Cancelled when the next search starts or the popup is closed
+    ScopedCancellationToken searchToken_;
+    ChannelPtr results_;
+    size_t nextChunk_ = 0;
+    std::map<size_t, std::vector<MessagePtr>> pendingChunks_;
 
-    LimitedQueueSnapshot<MessagePtr> snapshot_;
     QLineEdit *searchInput_{};
+    QCheckBox *searchLogs_{};
     ChannelView *channelView_{};
     QString channelName_{};
     Split *split_ = nullptr;
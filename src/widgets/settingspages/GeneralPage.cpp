@@ -1240,6 +1240,10 @@ void GeneralPage::initLayout(GeneralPageView &layout)
     layout.addIntInput("Max number of history messages to load on connect",
                        s.twitchMessageHistoryLimit, 10, 10000, 10);
 
+    layout.addIntInput(
+        "Channels per Twitch chat connection (requires restart)",
+        s.twitchChannelsPerReadConnection, 1, 1000, 10);
+
     layout.addIntInput("Split message scrollback limit (requires restart)",
                        s.scrollbackSplitLimit, 100, 100000, 100);
     layout.addIntInput("Usercard scrollback limit (requires restart)",
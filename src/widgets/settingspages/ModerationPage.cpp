@@ -164,14 +164,31 @@ ModerationPage::ModerationPage()
         separatelyStoreStreamLogs->setEnabled(getSettings()->enableLogging);
         logs.append(separatelyStoreStreamLogs);
 
+        auto *enableStructuredLogs = this->createCheckBox(
+            "Also store raw chat messages in replayable logs (.clog)",
+            getSettings()->enableStructuredLogs);
+
+        enableStructuredLogs->setEnabled(getSettings()->enableLogging);
+        logs.append(enableStructuredLogs);
+
+        auto *backfillFromStructuredLogs = this->createCheckBox(
+            "Show messages from replayable logs when joining a channel",
+            getSettings()->backfillFromStructuredLogs);
+
+        backfillFromStructuredLogs->setEnabled(getSettings()->enableLogging);
+        logs.append(backfillFromStructuredLogs);
+
         // Select event
         QObject::connect(
             enableLogging, &QCheckBox::stateChanged, this,
-            [enableLogging, onlyLogListedChannels,
-             separatelyStoreStreamLogs]() mutable {
+            [enableLogging, onlyLogListedChannels, separatelyStoreStreamLogs,
+             enableStructuredLogs, backfillFromStructuredLogs]() mutable {
                 onlyLogListedChannels->setEnabled(enableLogging->isChecked());
                 separatelyStoreStreamLogs->setEnabled(
                     getSettings()->enableLogging);
+                enableStructuredLogs->setEnabled(getSettings()->enableLogging);
+                backfillFromStructuredLogs->setEnabled(
+                    getSettings()->enableLogging);
             });
 
         EditableModelView *view =
@@ -1,5 +1,7 @@
 #include "widgets/splits/InputCompletionPopup.hpp"
 
+#include "Application.hpp"
+#include "controllers/completion/CompletionUsage.hpp"
 #include "controllers/completion/sources/UserSource.hpp"
 #include "controllers/completion/strategies/ClassicEmoteStrategy.hpp"
 #include "controllers/completion/strategies/ClassicUserStrategy.hpp"
@@ -58,6 +60,11 @@ std::unique_ptr<completion::Source> InputCompletionPopup::getSource() const
         return nullptr;
     }
 
+    ChannelCompletionUsage usage{
+        .usage = getApp()->getCompletionUsage(),
+        .channelName = this->currentChannel_->getName(),
+    };
+
     // Currently, strategies are hard coded.
     switch (*this->currentKind_)
     {
@@ -66,7 +73,8 @@ std::unique_ptr<completion::Source> InputCompletionPopup::getSource() const
             {
                 return std::make_unique<completion::EmoteSource>(
                     this->currentChannel_.get(),
-                    std::make_unique<completion::SmartEmoteStrategy>(),
+                    std::make_unique<completion::SmartEmoteStrategy>(
+                        std::move(usage)),
                     this->callback_);
             }
             return std::make_unique<completion::EmoteSource>(
@@ -76,7 +84,8 @@ std::unique_ptr<completion::Source> InputCompletionPopup::getSource() const
         case CompletionKind::User:
             return std::make_unique<completion::UserSource>(
                 this->currentChannel_.get(),
-                std::make_unique<completion::ClassicUserStrategy>(),
+                std::make_unique<completion::ClassicUserStrategy>(
+                    std::move(usage)),
                 this->callback_);
         default:
             return nullptr;
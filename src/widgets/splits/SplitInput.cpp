@@ -4,9 +4,14 @@
 #include "common/enums/MessageOverflow.hpp"
 #include "common/QLogging.hpp"
 #include "controllers/commands/CommandController.hpp"
+#include "controllers/completion/CompletionUsage.hpp"
 #include "controllers/hotkeys/HotkeyController.hpp"
+#include "messages/Emote.hpp"
 #include "messages/Link.hpp"
 #include "messages/Message.hpp"
+#include "providers/bttv/BttvEmotes.hpp"
+#include "providers/ffz/FfzEmotes.hpp"
+#include "providers/seventv/SeventvEmotes.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchCommon.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
@@ -31,6 +36,23 @@
 
 #include <functional>
 
+namespace {
+
+using namespace chatterino;
+
+/// Returns true if `word` is a Twitch, BTTV, FFZ or 7TV emote in `channel`
+bool isKnownEmote(const TwitchChannel &channel, const QString &word)
+{
+    EmoteName name{word};
+    return channel.twitchEmote(name) || channel.ffzEmote(name) ||
+           channel.bttvEmote(name) || channel.seventvEmote(name) ||
+           getApp()->getFfzEmotes()->emote(name) ||
+           getApp()->getBttvEmotes()->emote(name) ||
+           getApp()->getSeventvEmotes()->globalEmote(name);
+}
+
+}  // namespace
+
 namespace chatterino {
 
 SplitInput::SplitInput(Split *_chatWidget, bool enableInlineReplying)
@@ -440,6 +462,25 @@ void SplitInput::postMessageSend(const QString &message,
         this->prevMsg_.append(message);
     }
 
+    auto channel = this->split_->getChannel();
+    auto *usage = getApp()->getCompletionUsage();
+    auto *tc = dynamic_cast<TwitchChannel *>(channel.get());
+    if (usage && tc)
+    {
+        usage->recordMessage(channel->getName(), message,
+                             {
+                                 .isEmote =
+                                     [tc](const QString &word) {
+                                         return isKnownEmote(*tc, word);
+                                     },
+                                 .isChatter =
+                                     [tc](const QString &userName) {
+                                         return tc->accessChatters()->contains(
+                                             userName);
+                                     },
+                             });
+    }
+
     if (arguments.empty() || arguments.at(0) != "keepInput")
     {
         this->clearInput();
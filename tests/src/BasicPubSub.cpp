@@ -146,3 +146,32 @@ TEST(BasicPubSub, SubscriptionCycle)
     ASSERT_EQ(manager.diag.connectionsFailed, 0);
     ASSERT_EQ(manager.messagesReceived, 2);
 }
+
+TEST(BasicPubSub, PlannedSubscriptions)
+{
+    const QString host("wss://127.0.0.1:9050/liveupdates/sub-unsub");
+    MyManager manager(host);
+
+    // Duplicates are dropped and subscriptions removed before they were sent
+    // are never sent
+    manager.sub({1, "foo"});
+    manager.sub({1, "foo"});
+    manager.sub({2, "bar"});
+    manager.unsub({2, "bar"});
+    ASSERT_EQ(manager.subscriptionCount(), 1);
+    ASSERT_EQ(manager.connectionCount(), 0);
+
+    manager.start();
+    std::this_thread::sleep_for(500ms);
+
+    ASSERT_EQ(manager.diag.connectionsOpened, 1);
+    ASSERT_EQ(manager.connectionCount(), 1);
+    ASSERT_EQ(manager.messagesReceived, 1);
+    ASSERT_EQ(manager.popMessage(), QString("ack-sub-1-foo"));
+
+    manager.stop();
+
+    ASSERT_EQ(manager.diag.connectionsClosed, 1);
+    ASSERT_EQ(manager.connectionCount(), 0);
+    ASSERT_EQ(manager.subscriptionCount(), 1);
+}
@@ -0,0 +1,87 @@
+#include "common/Channel.hpp"
+
+#include "common/Literals.hpp"
+#include "messages/Message.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "mocks/Logging.hpp"
+#include "Test.hpp"
+
+#include <QDateTime>
+
+#include <memory>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+class MockApplication : public mock::BaseApplication
+{
+public:
+    MockApplication(const QString &settingsData)
+        : mock::BaseApplication(settingsData)
+    {
+    }
+
+    ILogging *getChatLogger() override
+    {
+        return &this->logging;
+    }
+
+    mock::EmptyLogging logging;
+};
+
+MessagePtr makeUserMessage(const QString &login, const QDateTime &time)
+{
+    auto message = std::make_shared<Message>();
+    message->loginName = login;
+    message->messageText = u"hi"_s;
+    message->serverReceivedTime = time;
+    return message;
+}
+
+MessagePtr makeTimeout(const QString &user, const QDateTime &time)
+{
+    auto message = std::make_shared<Message>();
+    message->flags.set(MessageFlag::Timeout);
+    message->timeoutUser = user;
+    message->messageText = user + u" has been timed out for 10s."_s;
+    message->serverReceivedTime = time;
+    return message;
+}
+
+}  // namespace
+
+TEST(Channel, DontStackBeyondUserMessage)
+{
+    MockApplication app(uR"({
+        "moderation": {
+            "timeoutStackStyle": 1
+        }
+    })"_s);
+    ASSERT_EQ(static_cast<TimeoutStackStyle>(
+                  getSettings()->timeoutStackStyle.getValue()),
+              TimeoutStackStyle::DontStackBeyondUserMessage);
+
+    Channel channel(u"forsen"_s, Channel::Type::Misc);
+    auto now = QDateTime::currentDateTime();
+
+    auto first = makeTimeout(u"forsen"_s, now);
+    channel.addOrReplaceTimeout(first, now);
+    auto userMessage = makeUserMessage(u"forsen"_s, now);
+    channel.addMessage(userMessage, MessageContext::Original);
+
+    // the user spoke after the first timeout, so the second one must not be
+    // stacked onto it
+    auto second = makeTimeout(u"forsen"_s, now);
+    channel.addOrReplaceTimeout(second, now);
+
+    auto snapshot = channel.getMessageSnapshot();
+    ASSERT_EQ(snapshot.size(), 3);
+    ASSERT_EQ(snapshot[0], first);
+    ASSERT_EQ(snapshot[1], userMessage);
+    ASSERT_EQ(snapshot[2], second);
+    ASSERT_EQ(first->count, 1);
+    ASSERT_TRUE(userMessage->flags.has(MessageFlag::Disabled));
+    ASSERT_FALSE(second->flags.has(MessageFlag::Disabled));
+}
@@ -6,6 +6,21 @@
 
 using namespace chatterino;
 
+namespace {
+
+std::vector<QString> userNames(
+    const std::vector<std::pair<QString, QString>> &chatters)
+{
+    std::vector<QString> names;
+    for (const auto &chatter : chatters)
+    {
+        names.push_back(chatter.second);
+    }
+    return names;
+}
+
+}  // namespace
+
 TEST(ChatterSet, insert)
 {
     ChatterSet set;
@@ -85,3 +100,73 @@ TEST(ChatterSet, MaxSizeLastUsed)
     EXPECT_TRUE(set.contains("pajlada"));
     EXPECT_TRUE(set.contains("Pajlada"));
 }
+
+TEST(ChatterSet, FilterByPrefix)
+{
+    ChatterSet set;
+
+    set.addRecentChatter("pajlada");
+    set.addRecentChatter("Pajbot");
+    set.addRecentChatter("forsen");
+    set.addRecentChatter("PAJ");
+
+    // Most recent chatters first
+    EXPECT_EQ(userNames(set.filterByPrefix("paj")),
+              (std::vector<QString>{"PAJ", "Pajbot", "pajlada"}));
+    EXPECT_EQ(set.filterByPrefix("PAJL"),
+              (std::vector<std::pair<QString, QString>>{
+                  {"pajlada", "pajlada"}}));
+    EXPECT_EQ(userNames(set.filterByPrefix("f")),
+              (std::vector<QString>{"forsen"}));
+    EXPECT_TRUE(set.filterByPrefix("x").empty());
+    EXPECT_EQ(set.filterByPrefix("").size(), 4);
+
+    // Changing the casing updates the result and bumps the chatter
+    set.addRecentChatter("Pajlada");
+    EXPECT_EQ(userNames(set.filterByPrefix("paj")),
+              (std::vector<QString>{"Pajlada", "PAJ", "Pajbot"}));
+    EXPECT_EQ(set.filterByPrefix(""), set.all());
+}
+
+TEST(ChatterSet, FilterByPrefixEviction)
+{
+    ChatterSet set;
+
+    set.addRecentChatter("pajlada");
+    for (auto i = 0; i < ChatterSet::CHATTER_LIMIT - 1; ++i)
+    {
+        set.addRecentChatter(QString("user%1").arg(i));
+    }
+    EXPECT_EQ(userNames(set.filterByPrefix("paj")),
+              (std::vector<QString>{"pajlada"}));
+    EXPECT_EQ(set.filterByPrefix("user").size(), ChatterSet::CHATTER_LIMIT - 1);
+
+    // Bumps pajlada out of the set
+    set.addRecentChatter("notpajlada");
+    EXPECT_TRUE(set.filterByPrefix("paj").empty());
+    EXPECT_EQ(set.filterByPrefix("").size(), ChatterSet::CHATTER_LIMIT);
+}
+
+TEST(ChatterSet, UpdateOnlineChatters)
+{
+    ChatterSet set;
+
+    set.addRecentChatter("Pajlada");
+    set.addRecentChatter("forsen");
+    set.addRecentChatter("Zneix");
+
+    set.updateOnlineChatters({"pajlada", "zneix", "mm2pl"});
+
+    EXPECT_TRUE(set.contains("pajlada"));
+    EXPECT_TRUE(set.contains("zneix"));
+    EXPECT_TRUE(set.contains("mm2pl"));
+    EXPECT_FALSE(set.contains("forsen"));
+
+    // Online chatters keep their casing
+    EXPECT_EQ(userNames(set.filterByPrefix("")),
+              (std::vector<QString>{"mm2pl", "Zneix", "Pajlada"}));
+
+    auto all = set.all();
+    ASSERT_EQ(all.size(), 3);
+    EXPECT_EQ(all.back(), (std::pair<QString, QString>{"pajlada", "Pajlada"}));
+}
@@ -0,0 +1,155 @@
+#include "controllers/completion/CompletionUsage.hpp"
+
+#include "controllers/completion/strategies/ClassicUserStrategy.hpp"
+#include "Test.hpp"
+
+using namespace chatterino;
+using namespace chatterino::completion;
+
+namespace {
+
+CompletionUsage::KnownWords knownWords(QStringList emotes,
+                                       QStringList chatters = {})
+{
+    return {
+        .isEmote =
+            [emotes](const QString &word) {
+                return emotes.contains(word);
+            },
+        .isChatter =
+            [chatters](const QString &userName) {
+                return chatters.contains(userName);
+            },
+    };
+}
+
+}  // namespace
+
+TEST(CompletionUsage, Weight)
+{
+    CompletionUsage usage;
+
+    EXPECT_EQ(usage.weight("forsen", "forsenE"), 0);
+
+    auto known = knownWords({"forsenE", "LULW"});
+    usage.recordMessage("forsen", "forsenE forsenE LULW", known);
+    usage.recordMessage("pajlada", "LULW", known);
+
+    // channel usage is weighted higher than global usage
+    EXPECT_GT(usage.weight("forsen", "forsenE"),
+              usage.weight("pajlada", "forsenE"));
+    EXPECT_GT(usage.weight("forsen", "forsenE"),
+              usage.weight("forsen", "LULW"));
+    EXPECT_GT(usage.weight("pajlada", "LULW"),
+              usage.weight("pajlada", "forsenE"));
+    EXPECT_EQ(usage.weight("pajlada", "Kappa"), 0);
+}
+
+TEST(CompletionUsage, Mentions)
+{
+    CompletionUsage usage;
+
+    usage.recordMessage("forsen", "@Pajlada, hello @zneix @stranger",
+                        knownWords({}, {"pajlada", "zneix"}));
+
+    EXPECT_GT(usage.weight("forsen", "pajlada"), 0);
+    EXPECT_GT(usage.weight("forsen", "zneix"), 0);
+    EXPECT_EQ(usage.weight("forsen", "@Pajlada,"), 0);
+    // not a chatter
+    EXPECT_EQ(usage.weight("forsen", "stranger"), 0);
+}
+
+TEST(CompletionUsage, IgnoresCommands)
+{
+    CompletionUsage usage;
+
+    auto known = knownWords({"pajlada"}, {"pajlada"});
+    usage.recordMessage("forsen", "/timeout pajlada 10", known);
+    usage.recordMessage("forsen", ".ban @pajlada", known);
+
+    EXPECT_EQ(usage.weight("forsen", "pajlada"), 0);
+    EXPECT_TRUE(usage.topWords("forsen", 10).empty());
+}
+
+TEST(CompletionUsage, TopWords)
+{
+    CompletionUsage usage;
+
+    auto known = knownWords({"a", "b", "c", "d"});
+    usage.recordMessage("forsen", "a b b c c c", known);
+    usage.recordMessage("pajlada", "d d d d", known);
+
+    EXPECT_EQ(usage.topWords("forsen", 2), (std::vector<QString>{"c", "b"}));
+    EXPECT_EQ(usage.topWords("forsen", 10),
+              (std::vector<QString>{"c", "b", "a"}));
+    EXPECT_TRUE(usage.topWords("zneix", 10).empty());
+}
+
+TEST(CompletionUsage, IgnoresOtherWords)
+{
+    CompletionUsage usage;
+
+    usage.recordMessage("forsen", "my password is hunter2 forsenE @forsen",
+                        knownWords({"forsenE"}));
+
+    EXPECT_EQ(usage.topWords("forsen", 10),
+              (std::vector<QString>{"forsenE"}));
+    EXPECT_EQ(usage.weight("forsen", "hunter2"), 0);
+}
+
+TEST(CompletionUsage, Decay)
+{
+    CompletionUsage usage;
+
+    for (int i = 0; i < 10; i++)
+    {
+        usage.recordWord("forsen", "frequent");
+    }
+    for (size_t i = 0; i < CompletionUsage::WORD_LIMIT; i++)
+    {
+        usage.recordWord("forsen", QString::number(i));
+    }
+
+    // all words used once are dropped, frequently used ones stay around
+    EXPECT_GT(usage.weight("forsen", "frequent"), 0);
+    EXPECT_EQ(usage.weight("forsen", "0"), 0);
+    EXPECT_EQ(usage.topWords("forsen", CompletionUsage::WORD_LIMIT).size(), 1);
+}
+
+TEST(CompletionUsage, UserStrategyOrder)
+{
+    CompletionUsage usage;
+    usage.recordMessage("forsen", "@pajbot @pajbot @pajlada",
+                        knownWords({}, {"pajbot", "pajlada"}));
+
+    std::vector<UserItem> items{
+        {"paj", "Paj"},
+        {"pajlada", "Pajlada"},
+        {"pajbot", "pajbot"},
+        {"forsen", "forsen"},
+    };
+
+    std::vector<UserItem> output;
+    ClassicUserStrategy withUsage({
+        .usage = &usage,
+        .channelName = "forsen",
+    });
+    static_cast<const Strategy<UserItem> &>(withUsage).apply(items, output,
+                                                             "@paj");
+    EXPECT_EQ(output, (std::vector<UserItem>{
+                          {"pajbot", "pajbot"},
+                          {"pajlada", "Pajlada"},
+                          {"paj", "Paj"},
+                      }));
+
+    // without usage the original order is kept
+    output.clear();
+    ClassicUserStrategy withoutUsage;
+    static_cast<const Strategy<UserItem> &>(withoutUsage)
+        .apply(items, output, "@paj");
+    EXPECT_EQ(output, (std::vector<UserItem>{
+                          {"paj", "Paj"},
+                          {"pajlada", "Pajlada"},
+                          {"pajbot", "pajbot"},
+                      }));
+}
@@ -1,8 +1,11 @@
 #include "controllers/accounts/AccountController.hpp"
+#include "controllers/filters/FilterRecord.hpp"
 #include "controllers/filters/lang/expressions/UnaryOperation.hpp"
 #include "controllers/filters/lang/Filter.hpp"
+#include "controllers/filters/lang/FilterParser.hpp"
 #include "controllers/filters/lang/Types.hpp"
 #include "controllers/highlights/HighlightController.hpp"
+#include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "mocks/BaseApplication.hpp"
 #include "mocks/Channel.hpp"
@@ -191,6 +194,91 @@ TEST(Filters, TypeSynthesis)
     }
 }
 
+TEST(Filters, UsedIdentifiers)
+{
+    struct TestCase {
+        QString input;
+        QSet<QString> identifiers;
+    };
+
+    // clang-format off
+    std::vector<TestCase> tests
+    {
+        {R".(1 + 1).", {}},
+        {R".(message.content contains "a").", {"message.content"}},
+        {R".(author.subbed || (author.sub_length > 3 && author.subbed)).", {"author.subbed", "author.sub_length"}},
+        {R".(message.content match {r"(\d\d)", 1} == channel.name).", {"message.content", "channel.name"}},
+    };
+    // clang-format on
+
+    for (const auto &[input, expected] : tests)
+    {
+        FilterParser parser(input);
+        ASSERT_TRUE(parser.valid()) << input;
+        EXPECT_TRUE(parser.identifiers() == expected) << input;
+
+        auto filterResult = Filter::fromString(input);
+        ASSERT_TRUE(std::holds_alternative<Filter>(filterResult)) << input;
+        const auto &slots = std::get<Filter>(filterResult).usedSlots();
+
+        for (auto it = MESSAGE_CONTEXT_SLOTS.begin();
+             it != MESSAGE_CONTEXT_SLOTS.end(); ++it)
+        {
+            EXPECT_EQ(slots.contains(it.value()), expected.contains(it.key()))
+                << input << ": " << it.key();
+        }
+    }
+}
+
+TEST(Filters, ResultCache)
+{
+    FilterRecord record("test", R".(message.length > 3).");
+    ASSERT_TRUE(record.valid());
+
+    auto message = std::make_shared<Message>();
+    EXPECT_EQ(record.cachedResult(*message), std::nullopt);
+
+    record.cacheResult(*message, true);
+    EXPECT_EQ(record.cachedResult(*message), true);
+
+    // a different record (e.g. an edited filter) doesn't share the result
+    FilterRecord edited("test", R".(message.length > 3).", record.getId());
+    EXPECT_EQ(edited.cachedResult(*message), std::nullopt);
+
+    // changing the flags invalidates the result
+    message->flags.set(MessageFlag::Disabled);
+    EXPECT_EQ(record.cachedResult(*message), std::nullopt);
+
+    // results depending on the channel are never cached
+    FilterRecord live("live", R".(channel.live).");
+    live.cacheResult(*message, true);
+    EXPECT_EQ(live.cachedResult(*message), std::nullopt);
+
+    // the results of removed records make room for new ones
+    for (size_t i = 0; i < 16; i++)
+    {
+        FilterRecord other("other", R".(flags.action).");
+        other.cacheResult(*message, false);
+    }
+    EXPECT_LE(message->filterCache.size(), FilterRecord::maxCachedResults());
+
+    // the results of many active filters don't evict each other
+    std::vector<std::unique_ptr<FilterRecord>> active;
+    for (size_t i = 0; i < 32; i++)
+    {
+        active.push_back(
+            std::make_unique<FilterRecord>("active", R".(flags.action)."));
+    }
+    for (const auto &other : active)
+    {
+        other->cacheResult(*message, false);
+    }
+    for (const auto &other : active)
+    {
+        EXPECT_EQ(other->cachedResult(*message), false);
+    }
+}
+
 TEST(Filters, Evaluation)
 {
     struct TestCase {
@@ -206,6 +294,16 @@ TEST(Filters, Evaluation)
         {"channel.name", QVariant("forsen")},
         {"author.badges", QVariant(QStringList({"moderator", "staff"}))}};
 
+    // The same values as contextMap, for the compiled filters
+    FilterContext filterContext;
+    filterContext.at(StringSlot::AuthorName) = "icelys";
+    filterContext.at(ColorSlot::AuthorColor) = QColor("#ff0000");
+    filterContext.at(BoolSlot::AuthorSubbed) = false;
+    filterContext.at(StringSlot::MessageContent) =
+        "hey there :) 2038-01-19 123 456";
+    filterContext.at(StringSlot::ChannelName) = "forsen";
+    filterContext.at(StringListSlot::AuthorBadges) = {"moderator", "staff"};
+
     // clang-format off
     std::vector<TestCase> tests
     {
@@ -221,6 +319,8 @@ TEST(Filters, Evaluation)
         {R".(3 * 4).", QVariant(12)},
         {R".(8 / 3).", QVariant(2)},
         {R".(7 % 3).", QVariant(1)},
+        {R".(7 / 0).", QVariant(0)},  // division by zero is 0
+        {R".(7 % 0).", QVariant(0)},
         {R".(5 == 5).", QVariant(true)},
         {R".(5 == "5").", QVariant(true)},
         {R".(5 != 7).", QVariant(true)},
@@ -265,6 +365,14 @@ TEST(Filters, Evaluation)
             << "Filter{ " << input << " } evaluated to " << result.toString()
             << " instead of " << expected.toString()
             << ".\nDebug: " << filter.debugString(MESSAGE_TYPING_CONTEXT);
+
+        auto compiledResult = filter.execute(filterContext);
+
+        EXPECT_EQ(compiledResult, expected)
+            << "Compiled Filter{ " << input << " } evaluated to "
+            << compiledResult.toString() << " instead of "
+            << expected.toString()
+            << ".\nDebug: " << filter.debugString(MESSAGE_TYPING_CONTEXT);
     }
 }
 
@@ -293,6 +401,13 @@ TEST_F(FiltersF, TypingContextChecks)
     auto contextMap = buildContextMap(msg, &channel);
 
     EXPECT_EQ(contextMap.size(), MESSAGE_TYPING_CONTEXT.size());
+    EXPECT_EQ(MESSAGE_CONTEXT_SLOTS.size(), MESSAGE_TYPING_CONTEXT.size());
+    for (auto it = MESSAGE_CONTEXT_SLOTS.begin();
+         it != MESSAGE_CONTEXT_SLOTS.end(); ++it)
+    {
+        EXPECT_EQ(it.value().type, MESSAGE_TYPING_CONTEXT.value(it.key()))
+            << it.key();
+    }
 
     delete privmsg;
 }
@@ -0,0 +1,251 @@
+#include "providers/twitch/api/HelixBatcher.hpp"
+
+#include "Test.hpp"
+
+#include <QJsonDocument>
+
+#include <functional>
+#include <vector>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Item {
+    QString id;
+
+    explicit Item(const QJsonObject &object)
+        : id(object.value("id").toString())
+    {
+    }
+};
+
+using OnFinished = std::function<void(bool, const NetworkResult &)>;
+
+struct PendingRequest {
+    QStringList ids;
+    OnFinished onFinished;
+};
+
+struct Fixture {
+    std::vector<PendingRequest> requests;
+    std::shared_ptr<HelixRatelimit> ratelimit =
+        std::make_shared<HelixRatelimit>();
+    std::shared_ptr<HelixBatcher<Item>> batcher = HelixBatcher<Item>::create(
+        [this](const QStringList &ids, OnFinished onFinished) {
+            this->requests.push_back({ids, std::move(onFinished)});
+        },
+        [](const Item &item) {
+            return item.id;
+        },
+        this->ratelimit);
+};
+
+NetworkResult makeResult(const QStringList &ids,
+                         NetworkResult::Headers headers = {})
+{
+    QJsonArray data;
+    for (const auto &id : ids)
+    {
+        data.append(QJsonObject{{"id", id}});
+    }
+    return {NetworkResult::NetworkError::NoError, 200,
+            QJsonDocument(QJsonObject{{"data", data}}).toJson(),
+            std::move(headers)};
+}
+
+QStringList makeIDs(int count, int offset = 0)
+{
+    QStringList ids;
+    for (int i = 0; i < count; i++)
+    {
+        ids.append(QString::number(offset + i));
+    }
+    return ids;
+}
+
+QStringList idsOf(const std::vector<Item> &items)
+{
+    QStringList ids;
+    for (const auto &item : items)
+    {
+        ids.append(item.id);
+    }
+    return ids;
+}
+
+}  // namespace
+
+TEST(HelixBatcher, MergesCallers)
+{
+    Fixture f;
+    QStringList first;
+    QStringList second;
+
+    f.batcher->fetch(
+        {"a", "b", "a"},
+        [&](const auto &items) {
+            first = idsOf(items);
+        },
+        [] {
+            FAIL();
+        });
+    f.batcher->fetch(
+        {"b", "c"},
+        [&](const auto &items) {
+            second = idsOf(items);
+        },
+        [] {
+            FAIL();
+        });
+
+    // Wait for the window
+    ASSERT_TRUE(f.requests.empty());
+    f.batcher->flush();
+
+    ASSERT_EQ(f.requests.size(), 1);
+    ASSERT_EQ(f.requests[0].ids, (QStringList{"a", "b", "c"}));
+
+    // "c" doesn't exist
+    f.requests[0].onFinished(true, makeResult({"b", "a"}));
+    ASSERT_EQ(first, (QStringList{"a", "b"}));
+    ASSERT_EQ(second, (QStringList{"b"}));
+}
+
+TEST(HelixBatcher, SplitsIntoConcurrentBatches)
+{
+    Fixture f;
+    int calls = 0;
+    QStringList result;
+
+    f.batcher->fetch(
+        makeIDs(250),
+        [&](const auto &items) {
+            calls++;
+            result = idsOf(items);
+        },
+        [] {
+            FAIL();
+        });
+
+    // Full batches are sent right away
+    ASSERT_EQ(f.requests.size(), 2);
+    ASSERT_EQ(f.batcher->queued(), 50);
+    f.batcher->flush();
+    ASSERT_EQ(f.requests.size(), 3);
+    ASSERT_EQ(f.ratelimit->inFlight(), 3);
+
+    f.requests[2].onFinished(true, makeResult(f.requests[2].ids));
+    f.requests[0].onFinished(true, makeResult(f.requests[0].ids));
+    ASSERT_EQ(calls, 0);
+    f.requests[1].onFinished(true, makeResult(f.requests[1].ids));
+    ASSERT_EQ(calls, 1);
+    ASSERT_EQ(result.size(), 250);
+    ASSERT_EQ(f.ratelimit->inFlight(), 0);
+}
+
+TEST(HelixBatcher, Failure)
+{
+    Fixture f;
+    int failures = 0;
+    int finallies = 0;
+
+    f.batcher->fetch(
+        makeIDs(200),
+        [](const auto &) {
+            FAIL();
+        },
+        [&] {
+            failures++;
+        },
+        [&] {
+            finallies++;
+        });
+
+    ASSERT_EQ(f.requests.size(), 2);
+    f.requests[0].onFinished(
+        false, {NetworkResult::NetworkError::InternalServerError, 500, {}});
+    ASSERT_EQ(failures, 0);
+    f.requests[1].onFinished(true, makeResult(f.requests[1].ids));
+    ASSERT_EQ(failures, 1);
+    ASSERT_EQ(finallies, 1);
+}
+
+TEST(HelixBatcher, ConcurrencyLimit)
+{
+    Fixture f;
+    f.batcher->fetch(makeIDs(800), [](const auto &) {}, [] {});
+
+    ASSERT_EQ(f.requests.size(), HelixRatelimit::MAX_CONCURRENCY);
+
+    // A freed slot is used by the next batch
+    f.requests[0].onFinished(true, makeResult({}));
+    ASSERT_EQ(f.requests.size(), HelixRatelimit::MAX_CONCURRENCY + 1);
+}
+
+TEST(HelixBatcher, RetryWhenRatelimited)
+{
+    Fixture f;
+    int calls = 0;
+    f.batcher->fetch(
+        {"a", "b"},
+        [&](const auto &) {
+            calls++;
+        },
+        [] {
+            FAIL();
+        });
+    f.batcher->flush();
+    ASSERT_EQ(f.requests.size(), 1);
+
+    f.requests[0].onFinished(
+        false, {NetworkResult::NetworkError::UnknownContentError, 429, {}});
+    ASSERT_EQ(calls, 0);
+    ASSERT_EQ(f.batcher->queued(), 2);
+
+    // Paused until the points reset
+    f.batcher->flush();
+    ASSERT_EQ(f.requests.size(), 1);
+    ASSERT_TRUE(f.ratelimit->pausedFor().has_value());
+}
+
+TEST(HelixRatelimit, FollowsHeaders)
+{
+    HelixRatelimit ratelimit;
+    auto now = HelixRatelimit::Clock::now();
+    auto resetAt = std::chrono::duration_cast<std::chrono::seconds>(
+                       (now + 10s).time_since_epoch())
+                       .count();
+
+    ASSERT_EQ(ratelimit.concurrency(now), HelixRatelimit::MAX_CONCURRENCY);
+
+    auto respond = [&](int remaining) {
+        ASSERT_TRUE(ratelimit.tryAcquire(now));
+        ratelimit.release(
+            {NetworkResult::NetworkError::NoError,
+             200,
+             {},
+             {
+                 {"Ratelimit-Remaining", QByteArray::number(remaining)},
+                 {"Ratelimit-Reset", QByteArray::number(resetAt)},
+             }},
+            now);
+    };
+
+    respond(HelixRatelimit::RESERVED_POINTS + 3);
+    ASSERT_EQ(ratelimit.concurrency(now), 3);
+    ASSERT_FALSE(ratelimit.pausedFor(now).has_value());
+
+    respond(HelixRatelimit::RESERVED_POINTS);
+    ASSERT_EQ(ratelimit.concurrency(now), 0);
+    ASSERT_FALSE(ratelimit.tryAcquire(now));
+    auto pause = ratelimit.pausedFor(now);
+    ASSERT_TRUE(pause.has_value());
+    ASSERT_LE(*pause, 10s);
+    ASSERT_GT(*pause, 8s);
+
+    // The bucket is full again after the reset
+    ASSERT_EQ(ratelimit.concurrency(now + 11s),
+              HelixRatelimit::MAX_CONCURRENCY);
+}
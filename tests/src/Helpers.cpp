@@ -554,5 +554,10 @@ TEST(Helpers, unescapeZeroWidthJoiner)
         const auto actual = unescapeZeroWidthJoiner(c.input.toString());
 
         EXPECT_EQ(actual, c.output);
+
+        const auto actualUtf8 =
+            unescapeZeroWidthJoiner(c.input.toString().toUtf8());
+
+        EXPECT_EQ(actualUtf8, c.output.toString().toUtf8());
     }
 }
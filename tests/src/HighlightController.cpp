@@ -2,6 +2,7 @@
 
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/highlights/HighlightPhrase.hpp"
+#include "controllers/highlights/HighlightPhraseMatcher.hpp"
 #include "messages/MessageBuilder.hpp"  // for MessageParseArgs
 #include "mocks/BaseApplication.hpp"
 #include "mocks/Helix.hpp"
@@ -161,6 +162,65 @@ static QString SETTINGS_ANON_EMPTY = R"!(
 {
 })!";
 
+static QString SETTINGS_PHRASE_PRIORITY = R"!(
+{
+    "accounts": {
+        "uid117166826": {
+            "username": "testaccount_420",
+            "userID": "117166826",
+            "clientID": "abc",
+            "oauthToken": "def"
+        },
+        "current": "testaccount_420"
+    },
+    "highlighting": {
+        "users": [
+            {
+                "pattern": "^for(sen|ty)$",
+                "showInMentions": false,
+                "alert": false,
+                "sound": false,
+                "regex": true,
+                "case": false,
+                "soundUrl": "",
+                "color": "#7f00ff00"
+            }
+        ],
+        "highlights": [
+            {
+                "pattern": "(a)\\1",
+                "showInMentions": false,
+                "alert": true,
+                "sound": false,
+                "regex": true,
+                "case": false,
+                "soundUrl": "",
+                "color": "#7f0000ff"
+            },
+            {
+                "pattern": "Kappa",
+                "showInMentions": false,
+                "alert": false,
+                "sound": false,
+                "regex": false,
+                "case": true,
+                "soundUrl": "",
+                "color": "#7fff0000"
+            },
+            {
+                "pattern": "kap+a",
+                "showInMentions": true,
+                "alert": false,
+                "sound": false,
+                "regex": true,
+                "case": false,
+                "soundUrl": "",
+                "color": "#7fffff00"
+            }
+        ]
+    }
+})!";
+
 struct TestCase {
     // TODO: create one of these from a raw irc message? hmm xD
     struct {
@@ -492,3 +552,197 @@ TEST_F(HighlightControllerTest, AnonEmpty)
 
     this->runTests(tests);
 }
+
+TEST_F(HighlightControllerTest, PhrasePriority)
+{
+    configure(SETTINGS_PHRASE_PRIORITY, false);
+
+    std::vector<TestCase> tests{
+        {
+            // Both the literal and the regex phrase match, the color of the
+            // first one wins
+            {
+                .senderName = "pajlada",
+                .originalMessage = "hello Kappa",
+            },
+            {
+                .state = true,
+                .result =
+                    {
+                        false,                                  // alert
+                        false,                                  // playsound
+                        std::nullopt,                           // custom sound url
+                        std::make_shared<QColor>("#7fff0000"),  // color
+                        true,                                   // showInMentions
+                    },
+            },
+        },
+        {
+            // The literal phrase is case sensitive
+            {
+                .senderName = "pajlada",
+                .originalMessage = "hello KAPPA",
+            },
+            {
+                .state = true,
+                .result =
+                    {
+                        false,                                  // alert
+                        false,                                  // playsound
+                        std::nullopt,                           // custom sound url
+                        std::make_shared<QColor>("#7fffff00"),  // color
+                        true,                                   // showInMentions
+                    },
+            },
+        },
+        {
+            // The literal phrase needs a word boundary
+            {
+                .senderName = "pajlada",
+                .originalMessage = "helloKappa",
+            },
+            {
+                .state = true,
+                .result =
+                    {
+                        false,                                  // alert
+                        false,                                  // playsound
+                        std::nullopt,                           // custom sound url
+                        std::make_shared<QColor>("#7fffff00"),  // color
+                        true,                                   // showInMentions
+                    },
+            },
+        },
+        {
+            // Regex with a back reference
+            {
+                .senderName = "pajlada",
+                .originalMessage = "aA",
+            },
+            {
+                .state = true,
+                .result =
+                    {
+                        true,                                   // alert
+                        false,                                  // playsound
+                        std::nullopt,                           // custom sound url
+                        std::make_shared<QColor>("#7f0000ff"),  // color
+                        false,                                  // showInMentions
+                    },
+            },
+        },
+        {
+            // Message highlights are checked before user highlights
+            {
+                .senderName = "FORTY",
+                .originalMessage = "aa Kappa",
+            },
+            {
+                .state = true,
+                .result =
+                    {
+                        true,                                   // alert
+                        false,                                  // playsound
+                        std::nullopt,                           // custom sound url
+                        std::make_shared<QColor>("#7f0000ff"),  // color
+                        true,                                   // showInMentions
+                    },
+            },
+        },
+        {
+            {
+                .senderName = "fortyy",
+                .originalMessage = "nothing here",
+            },
+            {
+                .state = false,
+                .result = HighlightResult::emptyResult(),
+            },
+        },
+    };
+
+    this->runTests(tests);
+}
+
+TEST(HighlightPhraseMatcher, Parity)
+{
+    auto phrase = [](const QString &pattern, bool isRegex,
+                     bool isCaseSensitive) {
+        return HighlightPhrase(pattern, false, false, false, isRegex,
+                               isCaseSensitive, {}, QColor());
+    };
+
+    std::vector<HighlightPhrase> phrases{
+        phrase("forsen", false, false),
+        phrase("Forsen", false, true),
+        phrase("for", false, false),
+        phrase("!testmanxd", false, false),
+        phrase("a b", false, false),
+        phrase("ab", false, false),
+        phrase("", false, false),
+        phrase("\u00e4\u00df", false, false),
+        phrase("STRASSE", false, false),
+        phrase("\U0001F600", false, false),
+        phrase("\U00010400", false, false),  // has a lowercase form
+        phrase("^hello", true, false),
+        phrase("world$", true, true),
+        phrase("\\bfo+\\b", true, false),
+        phrase("(\\w)\\1", true, false),
+        phrase("(?<name>x)\\k<name>", true, false),
+        phrase("(?x) a b # comment", true, false),
+        phrase("(?i)CASE", true, true),
+        phrase("\\Qa+b", true, false),
+        phrase("(unclosed", true, false),
+        phrase("a|b", true, true),
+    };
+
+    HighlightPhraseMatcher matcher;
+    for (const auto &p : phrases)
+    {
+        matcher.add(p);
+    }
+    matcher.build();
+    ASSERT_EQ(matcher.size(), phrases.size());
+
+    std::vector<QString> subjects{
+        "",
+        "forsen",
+        "FORSEN",
+        "xforsen",
+        "forsen!",
+        "hello forsen world",
+        "Hello world",
+        "hello World",
+        "!testmanxd",
+        "a!testmanxd",
+        "a b",
+        "a  b",
+        "ab",
+        "cab",
+        "foo fooo",
+        "xx",
+        "x x",
+        "ab",
+        "case",
+        "CASE",
+        "a+b",
+        "(unclosed",
+        "b",
+        "\u00c4\u00df",
+        "stra\u00dfe STRASSE",
+        "look \U0001F600 here",
+        "\U00010428",  // lowercase of U+10400
+        "\U00010400",
+    };
+
+    for (const auto &subject : subjects)
+    {
+        auto matches = matcher.match(subject);
+        ASSERT_EQ(matches.size(), phrases.size());
+        for (size_t i = 0; i < phrases.size(); i++)
+        {
+            EXPECT_EQ(matches[i], phrases[i].isMatch(subject))
+                << "Phrase " << phrases[i].getPattern() << " on " << subject;
+        }
+    }
+}
@@ -167,6 +167,17 @@ TEST_F(TestIgnoreController, processIgnorePhrases)
             "Kappa",
             {emoteAt(127, "Kappa")},
         },
+        {
+            {
+                regularReplace("foo", "bar"),
+                IgnorePhrase("bar", false, true, "", true),
+                regularReplace("bar", "baz"),
+            },
+            "foo Kappa",
+            {emoteAt(4, "Kappa")},
+            "baz Kappa",
+            {emoteAt(4, "Kappa")},
+        },
     };
 
     for (const auto &test : testCases)
@@ -0,0 +1,87 @@
+#include "common/network/IoContextPool.hpp"
+
+#include "Test.hpp"
+#include "util/OnceFlag.hpp"
+
+#include <boost/asio/post.hpp>
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace chatterino;
+
+TEST(IoContextPool, AcquirePicksLeastUsed)
+{
+    IoContextPool pool(2);
+    ASSERT_EQ(pool.threadCount(), 2);
+
+    auto &first = pool.acquire();
+    auto &second = pool.acquire();
+    ASSERT_NE(&first, &second);
+
+    pool.release(first);
+    auto &third = pool.acquire();
+    ASSERT_EQ(&third, &first);
+
+    pool.release(second);
+    pool.release(third);
+}
+
+TEST(IoContextPool, RunsOnOwnThread)
+{
+    IoContextPool pool(1);
+    auto &context = pool.acquire();
+
+    OnceFlag ran;
+    std::thread::id runner;
+    boost::asio::post(context, [&] {
+        runner = std::this_thread::get_id();
+        ran.set();
+    });
+    ASSERT_TRUE(ran.waitFor(std::chrono::seconds{1}));
+
+    ASSERT_EQ(runner, pool.threadOf(context));
+    ASSERT_NE(runner, std::this_thread::get_id());
+
+    pool.release(context);
+}
+
+TEST(IoContextPool, SurvivesThrowingHandler)
+{
+    IoContextPool pool(1);
+    auto &context = pool.acquire();
+
+    OnceFlag ran;
+    boost::asio::post(context, [] {
+        throw std::runtime_error("forsen");
+    });
+    boost::asio::post(context, [&] {
+        ran.set();
+    });
+    ASSERT_TRUE(ran.waitFor(std::chrono::seconds{1}));
+
+    pool.release(context);
+}
+
+TEST(IoContextPool, SharedTlsContext)
+{
+    IoContextPool pool(1);
+
+    auto tls = pool.tlsContext();
+    ASSERT_NE(tls, nullptr);
+    ASSERT_EQ(tls, pool.tlsContext());
+}
+
+// this test shouldn't time out (no assert necessary)
+TEST(IoContextPool, StopsWithPendingWork)
+{
+    IoContextPool pool(1);
+    auto &context = pool.acquire();
+
+    // the destructor doesn't wait for clients that never released the
+    // context or for their work
+    boost::asio::post(context, [] {
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    });
+}
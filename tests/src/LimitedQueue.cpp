@@ -264,3 +264,17 @@ TEST(LimitedQueue, Find)
                            })
                      .has_value());
 }
+
+TEST(LimitedQueue, LastWithIndex)
+{
+    LimitedQueue<int> queue(3);
+    EXPECT_FALSE(queue.lastWithIndex().has_value());
+
+    queue.pushBack(1);
+    EXPECT_EQ(queue.lastWithIndex(), std::make_pair(size_t{0}, 1));
+
+    queue.pushBack(2);
+    queue.pushBack(3);
+    queue.pushBack(4);
+    EXPECT_EQ(queue.lastWithIndex(), std::make_pair(size_t{2}, 4));
+}
@@ -0,0 +1,152 @@
+#include "messages/search/LogSearch.hpp"
+
+#include "messages/search/LogFileIndex.hpp"
+#include "messages/search/LogLine.hpp"
+#include "Test.hpp"
+#include "util/CancellationToken.hpp"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+using namespace chatterino;
+
+namespace {
+
+QByteArray makeLog(int lines, const QString &login)
+{
+    QByteArray log("# Start logging at 2024-01-02 13:00:00 UTC\n");
+    for (int i = 0; i < lines; i++)
+    {
+        log += QString("[13:%1:%2] %3: message number %4\n")
+                   .arg(i / 60 % 60, 2, 10, QChar('0'))
+                   .arg(i % 60, 2, 10, QChar('0'))
+                   .arg(login)
+                   .arg(i)
+                   .toUtf8();
+    }
+    return log;
+}
+
+void writeFile(const QString &path, const QByteArray &data,
+               QIODevice::OpenMode mode = QIODevice::WriteOnly)
+{
+    QFile file(path);
+    ASSERT_TRUE(file.open(mode));
+    file.write(data);
+}
+
+}  // namespace
+
+TEST(LogSearch, ParseLine)
+{
+    ASSERT_FALSE(parseLogLine(u"# Start logging at 2024-01-02 13:00:00 UTC"));
+    ASSERT_FALSE(parseLogLine(u"[13:00] forsen: hi"));
+
+    auto message = parseLogLine(u"[13:01:02] forsen: hi: there");
+    ASSERT_TRUE(message);
+    ASSERT_EQ(message->time, QTime(13, 1, 2));
+    ASSERT_EQ(message->loginName, "forsen");
+    ASSERT_TRUE(message->localizedName.isEmpty());
+    ASSERT_EQ(message->messageText, "hi: there");
+    ASSERT_EQ(message->searchText, "forsen: hi: there");
+
+    auto localized = parseLogLine(u"#pajlada [13:01:02] 테스트 test_user: hi");
+    ASSERT_TRUE(localized);
+    ASSERT_EQ(localized->channelName, "pajlada");
+    ASSERT_EQ(localized->localizedName, QString::fromUtf8("테스트"));
+    ASSERT_EQ(localized->loginName, "test_user");
+    ASSERT_EQ(localized->messageText, "hi");
+
+    auto system =
+        parseLogLine(u"[13:01:02] forsen has been timed out for 10m: spam");
+    ASSERT_TRUE(system);
+    ASSERT_TRUE(system->loginName.isEmpty());
+    ASSERT_EQ(system->messageText, "forsen has been timed out for 10m: spam");
+}
+
+TEST(LogSearch, IndexRoundTrip)
+{
+    auto log = makeLog(2000, "forsen");
+
+    LogFileIndex index;
+    ASSERT_TRUE(index.extend(log));
+    ASSERT_FALSE(index.extend(log));
+    ASSERT_EQ(index.indexedSize(), log.size());
+    ASSERT_GT(index.blocks().size(), 1);
+    ASSERT_EQ(index.blocks().back().end, log.size());
+
+    auto loaded = LogFileIndex::deserialize(index.serialize());
+    ASSERT_TRUE(loaded);
+    ASSERT_EQ(loaded->indexedSize(), index.indexedSize());
+    ASSERT_EQ(loaded->blocks().size(), index.blocks().size());
+    ASSERT_EQ(*loaded->bySubstring("number 1999"),
+              *index.bySubstring("number 1999"));
+    ASSERT_EQ(loaded->byAuthors({"Forsen"})->size(), index.blocks().size());
+    ASSERT_TRUE(loaded->byAuthors({"pajlada"})->empty());
+    ASSERT_FALSE(loaded->byBadges({"moderator"}));
+
+    ASSERT_FALSE(LogFileIndex::deserialize("garbage"));
+}
+
+TEST(LogSearch, SaveKeepsNewerIndex)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath("forsen-2024-01-02.log");
+    auto log = makeLog(2000, "forsen");
+    writeFile(path, log);
+
+    LogFileIndex older;
+    ASSERT_TRUE(older.extend(log.left(log.size() / 2)));
+    LogFileIndex newer;
+    ASSERT_TRUE(newer.extend(log));
+
+    ASSERT_TRUE(newer.save(path));
+    // e.g. a task that read the file before it grew
+    ASSERT_TRUE(older.save(path));
+
+    auto loaded = LogFileIndex::load(path);
+    ASSERT_TRUE(loaded);
+    ASSERT_EQ(loaded->indexedSize(), newer.indexedSize());
+
+    // a stored index of a longer file that was replaced is overwritten
+    auto shorter = makeLog(10, "forsen");
+    writeFile(path, shorter);
+    ASSERT_FALSE(LogFileIndex::load(path));
+    LogFileIndex rebuilt;
+    ASSERT_TRUE(rebuilt.extend(shorter));
+    ASSERT_TRUE(rebuilt.save(path));
+    loaded = LogFileIndex::load(path);
+    ASSERT_TRUE(loaded);
+    ASSERT_EQ(loaded->indexedSize(), shorter.size());
+}
+
+TEST(LogSearch, SearchFile)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath("forsen-2024-01-02.log");
+    writeFile(path, makeLog(2000, "forsen"));
+
+    CancellationToken token(false);
+    auto results = searchLogFile(path, "from:forsen number 1999", token);
+    ASSERT_EQ(results.size(), 1);
+    ASSERT_EQ(results[0].channelName, "forsen");
+    ASSERT_EQ(results[0].date, QDate(2024, 1, 2));
+    ASSERT_EQ(results[0].line.messageText, "message number 1999");
+    ASSERT_TRUE(QFile::exists(LogFileIndex::sidecarPath(path)));
+
+    // lines appended after the sidecar was written are found too
+    writeFile(path, "[14:00:00] pajlada: message number 1999\n",
+              QIODevice::Append);
+    results = searchLogFile(path, "number 1999", token);
+    ASSERT_EQ(results.size(), 2);
+    ASSERT_EQ(results[1].line.loginName, "pajlada");
+
+    results = searchLogFile(path, "from:pajlada", token);
+    ASSERT_EQ(results.size(), 1);
+
+    ASSERT_EQ(findLogFiles(dir.path()),
+              QStringList{QFileInfo(path).absoluteFilePath()});
+}
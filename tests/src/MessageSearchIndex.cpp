@@ -0,0 +1,163 @@
+#include "messages/search/MessageSearchIndex.hpp"
+
+#include "messages/LimitedQueue.hpp"
+#include "messages/Message.hpp"
+#include "messages/search/AuthorPredicate.hpp"
+#include "messages/search/BadgePredicate.hpp"
+#include "messages/search/RegexPredicate.hpp"
+#include "messages/search/SubstringPredicate.hpp"
+#include "providers/twitch/TwitchBadge.hpp"
+#include "Test.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+MessagePtr makeMessage(const QString &login, const QString &display,
+                       const QString &text,
+                       const std::vector<QString> &badges = {})
+{
+    auto message = std::make_shared<Message>();
+    message->loginName = login;
+    message->displayName = display;
+    message->searchText = login + ": " + text;
+    message->messageText = text;
+    for (const auto &badge : badges)
+    {
+        message->badges.emplace_back(badge, "1");
+    }
+    return message;
+}
+
+LimitedQueueSnapshot<MessagePtr> makeSnapshot(
+    const std::vector<MessagePtr> &messages)
+{
+    LimitedQueue<MessagePtr> queue(messages.size() + 1);
+    for (const auto &message : messages)
+    {
+        queue.pushBack(message);
+    }
+    return queue.getSnapshot();
+}
+
+}  // namespace
+
+TEST(MessageSearchIndex, InactiveUntilSynced)
+{
+    MessageSearchIndex index;
+    auto message = makeMessage("forsen", "Forsen", "hello");
+
+    index.add(*message);
+    ASSERT_FALSE(index.isActive());
+    ASSERT_EQ(index.size(), 0);
+
+    index.sync(makeSnapshot({message}));
+    ASSERT_TRUE(index.isActive());
+    ASSERT_EQ(index.size(), 1);
+    ASSERT_TRUE(index.contains(*message));
+}
+
+TEST(MessageSearchIndex, Lookups)
+{
+    std::vector<MessagePtr> messages{
+        makeMessage("forsen", "Forsen", "hello chat", {"broadcaster"}),
+        makeMessage("pajlada", "pajlada", "Hello World", {"moderator"}),
+        makeMessage("nymn", "NymN", "good morning", {"subscriber"}),
+        makeMessage("user123", "日本語", "ÄÖÜ äöü", {"moderator", "premium"}),
+    };
+
+    MessageSearchIndex index;
+    index.sync(makeSnapshot(messages));
+
+    auto lookup = [&](const MessagePredicate &pred) {
+        auto postings = pred.candidates(index);
+        return postings ? std::optional(index.resolve(*postings))
+                        : std::nullopt;
+    };
+
+    {
+        auto found = lookup(AuthorPredicate("FORSEN,nymn", false));
+        ASSERT_TRUE(found.has_value());
+        ASSERT_EQ(*found, (std::unordered_set<const Message *>{
+                              messages[0].get(), messages[2].get()}));
+    }
+    {
+        auto found = lookup(AuthorPredicate("日本語", false));
+        ASSERT_TRUE(found.has_value());
+        ASSERT_EQ(*found,
+                  (std::unordered_set<const Message *>{messages[3].get()}));
+    }
+    {
+        // Negated predicates can't be looked up
+        ASSERT_FALSE(lookup(AuthorPredicate("forsen", true)).has_value());
+        ASSERT_FALSE(lookup(RegexPredicate("hello", false)).has_value());
+    }
+    {
+        auto found = lookup(BadgePredicate("mod", false));
+        ASSERT_TRUE(found.has_value());
+        ASSERT_EQ(*found, (std::unordered_set<const Message *>{
+                              messages[1].get(), messages[3].get()}));
+    }
+    {
+        // Too short to be looked up
+        ASSERT_FALSE(lookup(SubstringPredicate("he")).has_value());
+    }
+
+    // The candidates must contain every message the predicate applies to
+    for (const auto &search :
+         {"hello", "HELLO", "llo", "world", "äöü", "xyz", ": g", "user123"})
+    {
+        SubstringPredicate pred(QString::fromUtf8(search));
+        auto found = lookup(pred);
+        ASSERT_TRUE(found.has_value()) << search;
+        for (const auto &message : messages)
+        {
+            if (pred.appliesTo(*message, message->flags))
+            {
+                ASSERT_TRUE(found->contains(message.get())) << search;
+            }
+        }
+    }
+    ASSERT_TRUE(lookup(SubstringPredicate("xyz"))->empty());
+}
+
+TEST(MessageSearchIndex, RemoveAndSync)
+{
+    auto a = makeMessage("forsen", "Forsen", "hello chat");
+    auto b = makeMessage("forsen", "Forsen", "bye chat");
+    auto c = makeMessage("nymn", "NymN", "hello");
+
+    MessageSearchIndex index;
+    index.sync(makeSnapshot({a, b}));
+    ASSERT_EQ(index.removals(), 0);
+
+    index.add(*c);
+    index.remove(*a);
+    ASSERT_EQ(index.size(), 2);
+    ASSERT_EQ(index.removals(), 1);
+    ASSERT_FALSE(index.contains(*a));
+
+    auto forsen = index.resolve(*index.byAuthors({"forsen"}));
+    ASSERT_EQ(forsen, (std::unordered_set<const Message *>{b.get()}));
+    auto hello = index.resolve(*index.bySubstring("hello"));
+    ASSERT_EQ(hello, (std::unordered_set<const Message *>{c.get()}));
+
+    // Removing enough messages compacts the postings
+    index.remove(*b);
+    index.remove(*c);
+    ASSERT_EQ(index.size(), 0);
+    ASSERT_TRUE(index.byAuthors({"forsen", "nymn"})->empty());
+
+    index.sync(makeSnapshot({a, c}));
+    ASSERT_EQ(index.size(), 2);
+    hello = index.resolve(*index.bySubstring("hello"));
+    ASSERT_EQ(hello, (std::unordered_set<const Message *>{a.get(), c.get()}));
+
+    index.clear();
+    ASSERT_TRUE(index.isActive());
+    ASSERT_EQ(index.size(), 0);
+    ASSERT_EQ(index.removals(), 5);
+}
@@ -0,0 +1,77 @@
+#include "messages/MessageSimilarity.hpp"
+
+#include "Test.hpp"
+
+#include <QRandomGenerator>
+
+#include <algorithm>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+/// The table based solution of the Longest Common Substring Problem
+float referenceSimilarity(const QString &str1, const QString &str2)
+{
+    std::vector<std::vector<int>> tree(str1.size() + 1,
+                                       std::vector<int>(str2.size() + 1, 0));
+    int z = 0;
+    for (qsizetype i = 1; i <= str1.size(); i++)
+    {
+        for (qsizetype j = 1; j <= str2.size(); j++)
+        {
+            if (str1[i - 1] == str2[j - 1])
+            {
+                tree[i][j] = tree[i - 1][j - 1] + 1;
+                z = std::max(z, tree[i][j]);
+            }
+        }
+    }
+    if (z == 0)
+    {
+        return 0.F;
+    }
+    return float(z) / float(std::max({qsizetype(1), str1.size(), str2.size()}));
+}
+
+QString randomString(QRandomGenerator &rng, int maxLength)
+{
+    QString result;
+    auto length = rng.bounded(maxLength + 1);
+    for (int i = 0; i < length; i++)
+    {
+        result.append(QChar(u'a' + rng.bounded(3)));
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(MessageSimilarity, RelativeSimilarity)
+{
+    ASSERT_EQ(relativeSimilarity(u"", u""), 0.F);
+    ASSERT_EQ(relativeSimilarity(u"abc", u"abc"), 1.F);
+    ASSERT_EQ(relativeSimilarity(u"xxabcd", u"abcdyy"), 4.F / 6.F);
+    ASSERT_EQ(relativeSimilarity(u"abc", u"def"), 0.F);
+}
+
+TEST(MessageSimilarity, MatchesReference)
+{
+    QRandomGenerator rng(42);
+    for (int n = 0; n < 2000; n++)
+    {
+        auto str1 = randomString(rng, 24);
+        auto str2 = n % 4 == 0 ? str1 + randomString(rng, 4)
+                               : randomString(rng, 24);
+        auto expected = referenceSimilarity(str1, str2);
+
+        ASSERT_EQ(relativeSimilarity(str1, str2), expected)
+            << str1 << ' ' << str2;
+        for (float threshold : {-1.F, 0.F, 0.25F, 0.5F, 0.75F, 0.9F, 1.F})
+        {
+            ASSERT_EQ(isSimilar(str1, str2, threshold), expected > threshold)
+                << str1 << ' ' << str2 << ' ' << threshold;
+        }
+    }
+}
@@ -0,0 +1,89 @@
+#include "common/network/NetworkMetrics.hpp"
+
+#include "Test.hpp"
+
+#include <QJsonArray>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+
+TEST(LatencyHistogram, Empty)
+{
+    LatencyHistogram histogram;
+
+    ASSERT_EQ(histogram.count(), 0);
+    ASSERT_EQ(histogram.percentile(50), 0ms);
+}
+
+TEST(LatencyHistogram, Percentiles)
+{
+    LatencyHistogram histogram;
+    for (int i = 1; i <= 100; i++)
+    {
+        histogram.record(std::chrono::milliseconds(i));
+    }
+
+    ASSERT_EQ(histogram.count(), 100);
+
+    // Buckets are a quarter of a power of two wide
+    auto p50 = histogram.percentile(50);
+    ASSERT_GT(p50, 50ms);
+    ASSERT_LE(p50, 64ms);
+
+    auto p99 = histogram.percentile(99);
+    ASSERT_GT(p99, 99ms);
+    ASSERT_LE(p99, 128ms);
+
+    ASSERT_EQ(histogram.percentile(0), 2ms);
+}
+
+TEST(LatencyHistogram, Buckets)
+{
+    LatencyHistogram histogram;
+    histogram.record(0ms);
+    histogram.record(3ms);
+    histogram.record(4ms);
+    histogram.record(9ms);
+    histogram.record(-5ms);
+    histogram.record(24h);
+
+    ASSERT_EQ(histogram.bucketCount(0), 2);
+    ASSERT_EQ(histogram.bucketCount(3), 1);
+    ASSERT_EQ(histogram.bucketCount(4), 1);
+    ASSERT_EQ(histogram.bucketCount(8), 1);
+    ASSERT_EQ(histogram.bucketCount(LatencyHistogram::BUCKET_COUNT - 1), 1);
+
+    ASSERT_EQ(LatencyHistogram::upperBound(0), 1);
+    ASSERT_EQ(LatencyHistogram::upperBound(4), 5);
+    ASSERT_EQ(LatencyHistogram::upperBound(8), 10);
+    ASSERT_EQ(LatencyHistogram::upperBound(LatencyHistogram::BUCKET_COUNT - 1),
+              1 << 20);
+}
+
+TEST(NetworkMetrics, Json)
+{
+    auto &stats =
+        NetworkMetrics::get("metrics.test.invalid", NetworkRequestType::Post);
+    ASSERT_EQ(&stats, &NetworkMetrics::get("metrics.test.invalid",
+                                           NetworkRequestType::Post));
+
+    NetworkStats::add(stats.requests, 2);
+    NetworkStats::add(stats.bytesIn, 100);
+    stats.latency.record(7ms);
+
+    bool found = false;
+    for (const auto &value : NetworkMetrics::toJson()["hosts"].toArray())
+    {
+        auto entry = value.toObject();
+        if (entry["host"].toString() != "metrics.test.invalid")
+        {
+            continue;
+        }
+        found = true;
+        ASSERT_EQ(entry["type"].toString(), "Post");
+        ASSERT_EQ(entry["requests"].toInt(), 2);
+        ASSERT_EQ(entry["bytesIn"].toInt(), 100);
+        ASSERT_EQ(entry["latencyMs"].toObject()["p50"].toInt(), 8);
+    }
+    ASSERT_TRUE(found);
+}
@@ -277,3 +277,40 @@ TEST(NetworkRequest, BatchedTimeouts)
     }
 #endif
 }
+
+TEST(NetworkRequest, CoalescedGet)
+{
+    EXPECT_TRUE(NetworkManager::workerThread->isRunning());
+
+    auto url = getDelayURL(1);
+    RequestWaiter first;
+    RequestWaiter second;
+    bool deletedCallerCalled = false;
+    auto *caller = new QObject;
+
+    NetworkRequest(url)
+        .onSuccess([&](const NetworkResult &result) {
+            EXPECT_EQ(result.status(), 200);
+            first.requestDone();
+        })
+        .execute();
+    NetworkRequest(url)
+        .caller(caller)
+        .onSuccess([&](const NetworkResult & /*result*/) {
+            deletedCallerCalled = true;
+        })
+        .execute();
+    NetworkRequest(url)
+        .onSuccess([&](const NetworkResult &result) {
+            EXPECT_EQ(result.status(), 200);
+            second.requestDone();
+        })
+        .execute();
+
+    // Only this request's callbacks should be dropped
+    delete caller;
+
+    first.waitForRequest();
+    second.waitForRequest();
+    EXPECT_FALSE(deletedCallerCalled);
+}
@@ -55,3 +55,17 @@ TEST(NetworkResult, InvalidError)
     checkResult({static_cast<Error>(-1), 42, {}}, static_cast<Error>(-1), 42,
                 "unknown error (status: 42, error: -1)");
 }
+
+TEST(NetworkResult, Header)
+{
+    NetworkResult res(Error::NoError, 200, {},
+                      {
+                          {"Ratelimit-Remaining", "799"},
+                          {"content-type", "application/json"},
+                      });
+
+    ASSERT_EQ(res.header("Ratelimit-Remaining"), "799");
+    ASSERT_EQ(res.header("ratelimit-remaining"), "799");
+    ASSERT_EQ(res.header("Content-Type"), "application/json");
+    ASSERT_TRUE(res.header("Ratelimit-Reset").isEmpty());
+}
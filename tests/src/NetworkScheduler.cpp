@@ -0,0 +1,165 @@
+#include "common/network/NetworkScheduler.hpp"
+
+#include "Test.hpp"
+
+#include <vector>
+
+using namespace chatterino;
+using namespace chatterino::network::detail;
+
+TEST(NetworkScheduler, PerHostLimit)
+{
+    NetworkScheduler scheduler(2, 10, 0);
+    std::vector<int> started;
+
+    for (int i = 0; i < 4; i++)
+    {
+        scheduler.schedule(NetworkPriority::Interactive, "a", [&, i] {
+            started.push_back(i);
+        });
+    }
+    scheduler.schedule(NetworkPriority::Interactive, "b", [&] {
+        started.push_back(10);
+    });
+
+    ASSERT_EQ(started, (std::vector<int>{0, 1, 10}));
+    ASSERT_EQ(scheduler.active("a"), 2);
+    ASSERT_EQ(scheduler.active("b"), 1);
+    ASSERT_EQ(scheduler.queued(), 2);
+
+    scheduler.finished("a");
+    ASSERT_EQ(started, (std::vector<int>{0, 1, 10, 2}));
+
+    scheduler.finished("b");
+    ASSERT_EQ(scheduler.active("b"), 0);
+    ASSERT_EQ(scheduler.queued(), 1);
+
+    scheduler.finished("a");
+    scheduler.finished("a");
+    ASSERT_EQ(started, (std::vector<int>{0, 1, 10, 2, 3}));
+    ASSERT_EQ(scheduler.active(), 1);
+    ASSERT_EQ(scheduler.queued(), 0);
+}
+
+TEST(NetworkScheduler, Priority)
+{
+    NetworkScheduler scheduler(1, 10, 0);
+    std::vector<int> started;
+
+    // occupy the host
+    scheduler.schedule(NetworkPriority::Interactive, "a", [] {});
+
+    scheduler.schedule(NetworkPriority::Background, "a", [&] {
+        started.push_back(3);
+    });
+    scheduler.schedule(NetworkPriority::Images, "a", [&] {
+        started.push_back(2);
+    });
+    scheduler.schedule(NetworkPriority::Interactive, "a", [&] {
+        started.push_back(1);
+    });
+    ASSERT_TRUE(started.empty());
+
+    scheduler.finished("a");
+    scheduler.finished("a");
+    scheduler.finished("a");
+    ASSERT_EQ(started, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(NetworkScheduler, RoundRobin)
+{
+    NetworkScheduler scheduler(10, 1, 0);
+    std::vector<QString> started;
+
+    // occupy the only slot
+    scheduler.schedule(NetworkPriority::Images, "x", [] {});
+
+    for (int i = 0; i < 3; i++)
+    {
+        scheduler.schedule(NetworkPriority::Images, "a", [&] {
+            started.emplace_back("a");
+        });
+    }
+    scheduler.schedule(NetworkPriority::Images, "b", [&] {
+        started.emplace_back("b");
+    });
+
+    scheduler.finished("x");
+    scheduler.finished("a");
+    scheduler.finished("b");
+    scheduler.finished("a");
+    ASSERT_EQ(started, (std::vector<QString>{"a", "b", "a", "a"}));
+}
+
+TEST(NetworkScheduler, ReservedSlots)
+{
+    NetworkScheduler scheduler(10, 3, 1);
+    int background = 0;
+    int interactive = 0;
+
+    for (int i = 0; i < 3; i++)
+    {
+        scheduler.schedule(NetworkPriority::Background, "a", [&] {
+            background++;
+        });
+    }
+    ASSERT_EQ(background, 2);
+
+    scheduler.schedule(NetworkPriority::Interactive, "a", [&] {
+        interactive++;
+    });
+    ASSERT_EQ(interactive, 1);
+    ASSERT_EQ(scheduler.queued(), 1);
+
+    scheduler.finished("a");
+    ASSERT_EQ(background, 2);
+    scheduler.finished("a");
+    ASSERT_EQ(background, 3);
+}
+
+TEST(NetworkScheduler, FinishWhileStarting)
+{
+    NetworkScheduler scheduler(1, 10, 0);
+    int started = 0;
+
+    for (int i = 0; i < 5; i++)
+    {
+        scheduler.schedule(NetworkPriority::Interactive, "a", [&] {
+            started++;
+            scheduler.finished("a");
+        });
+    }
+
+    ASSERT_EQ(started, 5);
+    ASSERT_EQ(scheduler.active(), 0);
+    ASSERT_EQ(scheduler.queued(), 0);
+}
+
+TEST(NetworkScheduler, Raise)
+{
+    NetworkScheduler scheduler(1, 10, 0);
+    std::vector<int> started;
+
+    // occupy the host
+    scheduler.schedule(NetworkPriority::Interactive, "a", [] {});
+
+    scheduler.schedule(NetworkPriority::Images, "a", [&] {
+        started.push_back(2);
+    });
+    auto id = scheduler.schedule(NetworkPriority::Background, "a", [&] {
+        started.push_back(1);
+    });
+
+    scheduler.raise("a", id, NetworkPriority::Interactive);
+    // lowering doesn't do anything
+    scheduler.raise("a", id, NetworkPriority::Background);
+    ASSERT_EQ(scheduler.queued(), 2);
+
+    scheduler.finished("a");
+    scheduler.finished("a");
+    ASSERT_EQ(started, (std::vector<int>{1, 2}));
+
+    // already started
+    scheduler.raise("a", id, NetworkPriority::Interactive);
+    ASSERT_EQ(scheduler.queued(), 0);
+}
@@ -0,0 +1,159 @@
+#include "util/PatternPrefilter.hpp"
+
+#include "Test.hpp"
+
+#include <QRegularExpression>
+
+using namespace chatterino;
+
+TEST(PatternPrefilter, Combinable)
+{
+    const QStringList combinable{
+        "foo",
+        "f(o+)bar",
+        "(?:abc|def)",
+        "(?i)abc",
+        "(?<=foo)\\d+",
+        "a(?=b)",
+        "\\bword\\b",
+        "[\\p{L}]+",
+        "\\x{1F600}",
+    };
+    for (const auto &pattern : combinable)
+    {
+        EXPECT_TRUE(PatternPrefilter::isCombinable(pattern)) << pattern;
+    }
+
+    const QStringList uncombinable{
+        "(a)\\1",
+        "(?<name>a)\\k<name>",
+        "(?P<name>a)",
+        "(a)\\g1",
+        "(?x) a b c",
+        "(?ix)a",
+        "\\Q.*\\E",
+        "\\cA",
+        "(a(?R)?b)",
+        "(?1)",
+        "(?|(a)|(b))",
+        "(*UTF)abc",
+    };
+    for (const auto &pattern : uncombinable)
+    {
+        EXPECT_FALSE(PatternPrefilter::isCombinable(pattern)) << pattern;
+    }
+}
+
+TEST(PatternPrefilter, Candidates)
+{
+    struct Pattern {
+        QString pattern;
+        bool isRegex;
+        Qt::CaseSensitivity caseSensitivity;
+    };
+    const std::vector<Pattern> patterns{
+        {"forsen", false, Qt::CaseInsensitive},
+        {"Kappa", false, Qt::CaseSensitive},
+        {"", false, Qt::CaseInsensitive},
+        {"\\d{3}", true, Qt::CaseSensitive},
+        {"pog(gers)?", true, Qt::CaseInsensitive},
+        {"(a)\\1", true, Qt::CaseSensitive},
+        {"(invalid", true, Qt::CaseSensitive},
+        {"äöü", false, Qt::CaseInsensitive},
+    };
+    const QStringList subjects{
+        "",
+        "FORSEN",
+        "kappa",
+        "Kappa 123",
+        "POGGERS",
+        "aa",
+        "ÄÖÜ",
+        "nothing to see here",
+    };
+
+    PatternPrefilter prefilter;
+    for (size_t i = 0; i < patterns.size(); i++)
+    {
+        const auto &p = patterns[i];
+        ASSERT_EQ(prefilter.add(p.pattern, p.isRegex, p.caseSensitivity), i);
+    }
+    prefilter.build();
+    ASSERT_EQ(prefilter.size(), patterns.size());
+
+    for (const auto &subject : subjects)
+    {
+        auto candidates = prefilter.candidates(subject);
+        ASSERT_EQ(candidates.size(), patterns.size());
+
+        for (size_t i = 0; i < patterns.size(); i++)
+        {
+            const auto &p = patterns[i];
+            bool matches = false;
+            if (p.isRegex)
+            {
+                QRegularExpression regex(
+                    p.pattern,
+                    QRegularExpression::UseUnicodePropertiesOption |
+                        (p.caseSensitivity == Qt::CaseInsensitive
+                             ? QRegularExpression::CaseInsensitiveOption
+                             : QRegularExpression::NoPatternOption));
+                matches = regex.isValid() && regex.match(subject).hasMatch();
+            }
+            else
+            {
+                matches = !p.pattern.isEmpty() &&
+                          subject.contains(p.pattern, p.caseSensitivity);
+            }
+
+            // Candidates must be a superset of the matching patterns
+            if (matches)
+            {
+                EXPECT_TRUE(candidates[i])
+                    << "pattern " << p.pattern << " subject " << subject;
+            }
+            if (prefilter.isExact(i))
+            {
+                EXPECT_EQ(candidates[i], matches)
+                    << "pattern " << p.pattern << " subject " << subject;
+            }
+        }
+
+        // Empty and invalid patterns are never candidates
+        EXPECT_FALSE(candidates[2]) << subject;
+        EXPECT_FALSE(candidates[6]) << subject;
+        // Uncombinable regexes are always candidates
+        EXPECT_TRUE(candidates[5]) << subject;
+    }
+
+    EXPECT_TRUE(prefilter.isExact(3));
+    EXPECT_TRUE(prefilter.isExact(4));
+    EXPECT_FALSE(prefilter.isExact(0));
+    EXPECT_FALSE(prefilter.isExact(5));
+
+    EXPECT_FALSE(prefilter.candidates("nothing to see here")[0]);
+    EXPECT_FALSE(prefilter.candidates("nothing to see here")[3]);
+    EXPECT_FALSE(prefilter.candidates("nothing to see here")[4]);
+}
+
+TEST(PatternPrefilter, OverlappingRegexes)
+{
+    PatternPrefilter prefilter;
+    prefilter.add("foo", true, Qt::CaseSensitive);
+    prefilter.add("oob", true, Qt::CaseSensitive);
+    prefilter.add("fo+", true, Qt::CaseSensitive);
+    prefilter.add("(?<=x)b", true, Qt::CaseInsensitive);
+    prefilter.add("^b", true, Qt::CaseSensitive);
+    prefilter.build();
+
+    // Patterns matching at the same position or inside another match are
+    // all found
+    EXPECT_EQ(prefilter.candidates("foob"),
+              (std::vector<bool>{true, true, true, false, false}));
+    EXPECT_EQ(prefilter.candidates("xfoo XB"),
+              (std::vector<bool>{true, false, true, true, false}));
+    EXPECT_EQ(prefilter.candidates("boob"),
+              (std::vector<bool>{false, true, false, false, true}));
+    EXPECT_EQ(prefilter.candidates("nothing"),
+              (std::vector<bool>{false, false, false, false, false}));
+}
@@ -0,0 +1,144 @@
+#include "providers/twitch/ReadConnectionRing.hpp"
+
+#include "Test.hpp"
+
+using namespace chatterino;
+
+namespace {
+
+QString channelName(int i)
+{
+    return QStringLiteral("channel%1").arg(i);
+}
+
+}  // namespace
+
+TEST(ReadConnectionRing, AddsConnectionsWhenFull)
+{
+    ReadConnectionRing ring(10);
+    ASSERT_EQ(ring.connectionCount(), 1);
+
+    for (int i = 0; i < 25; i++)
+    {
+        ring.assign(channelName(i));
+    }
+
+    ASSERT_EQ(ring.connectionCount(), 3);
+    size_t total = 0;
+    for (size_t i = 0; i < ring.connectionCount(); i++)
+    {
+        ASSERT_LE(ring.load(i), 10);
+        ASSERT_EQ(ring.channelsOf(i).size(), ring.load(i));
+        total += ring.load(i);
+    }
+    ASSERT_EQ(total, 25);
+}
+
+TEST(ReadConnectionRing, AssignmentsAreSticky)
+{
+    ReadConnectionRing ring(10);
+
+    std::vector<size_t> before;
+    for (int i = 0; i < 10; i++)
+    {
+        before.push_back(ring.assign(channelName(i)));
+    }
+
+    // adding connections doesn't move existing channels
+    for (int i = 10; i < 40; i++)
+    {
+        ring.assign(channelName(i));
+    }
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_EQ(ring.find(channelName(i)), before[i]);
+        ASSERT_EQ(ring.assign(channelName(i)), before[i]);
+    }
+}
+
+TEST(ReadConnectionRing, IsDeterministic)
+{
+    ReadConnectionRing a(5);
+    ReadConnectionRing b(5);
+    for (int i = 0; i < 30; i++)
+    {
+        ASSERT_EQ(a.assign(channelName(i)), b.assign(channelName(i)));
+    }
+}
+
+TEST(ReadConnectionRing, RemovesEmptyConnections)
+{
+    ReadConnectionRing ring(2);
+    for (int i = 0; i < 6; i++)
+    {
+        ring.assign(channelName(i));
+    }
+    ASSERT_EQ(ring.connectionCount(), 3);
+
+    for (int i = 0; i < 6; i++)
+    {
+        ring.remove(channelName(i));
+        ASSERT_FALSE(ring.find(channelName(i)).has_value());
+    }
+    ASSERT_EQ(ring.connectionCount(), 1);
+    ASSERT_EQ(ring.load(0), 0);
+
+    // removing unknown channels is fine
+    ring.remove(QStringLiteral("forsen"));
+    ASSERT_EQ(ring.assign(QStringLiteral("forsen")), 0);
+}
+
+TEST(ReadConnectionRing, RebalancePlacesByHash)
+{
+    ReadConnectionRing ascending(10);
+    ReadConnectionRing descending(10);
+    for (int i = 0; i < 25; i++)
+    {
+        ascending.assign(channelName(i));
+        descending.assign(channelName(24 - i));
+    }
+
+    ascending.rebalance();
+    descending.rebalance();
+
+    // the placement doesn't depend on the order the channels were joined in
+    ASSERT_EQ(ascending.connectionCount(), 3);
+    ASSERT_EQ(descending.connectionCount(), 3);
+    size_t total = 0;
+    for (size_t i = 0; i < ascending.connectionCount(); i++)
+    {
+        ASSERT_LE(ascending.load(i), 10);
+        total += ascending.load(i);
+    }
+    ASSERT_EQ(total, 25);
+    for (int i = 0; i < 25; i++)
+    {
+        ASSERT_EQ(ascending.find(channelName(i)),
+                  descending.find(channelName(i)));
+    }
+}
+
+TEST(ReadConnectionRing, RebalanceDropsUnneededConnections)
+{
+    ReadConnectionRing ring(2);
+    for (int i = 0; i < 6; i++)
+    {
+        ring.assign(channelName(i));
+    }
+    ASSERT_EQ(ring.connectionCount(), 3);
+
+    // removing channels from the first connections leaves gaps
+    for (const auto &channel : ring.channelsOf(0))
+    {
+        ring.remove(channel);
+    }
+    for (const auto &channel : ring.channelsOf(1))
+    {
+        ring.remove(channel);
+    }
+    ASSERT_EQ(ring.connectionCount(), 3);
+
+    ring.rebalance();
+    ASSERT_EQ(ring.connectionCount(), 1);
+    ASSERT_EQ(ring.load(0), 2);
+}
@@ -0,0 +1,218 @@
+#include "singletons/helper/StructuredLog.hpp"
+
+#include "Test.hpp"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+using namespace chatterino;
+
+namespace {
+
+QByteArray makeLine(int i)
+{
+    return "@id=" + QByteArray::number(i) +
+           " :forsen!forsen@forsen.tmi.twitch.tv PRIVMSG #forsen :message " +
+           QByteArray::number(i);
+}
+
+/// Writes `count` records, one per second starting at `startMs`
+void writeRecords(StructuredLogWriter &writer, qint64 startMs, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        writer.append({
+            .receivedMs = startMs + i * 1000,
+            .data = makeLine(i),
+        });
+    }
+}
+
+}  // namespace
+
+TEST(StructuredLog, RoundTrip)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath("forsen-2024-01-02.clog");
+
+    {
+        StructuredLogWriter writer;
+        ASSERT_TRUE(writer.open(path));
+        writeRecords(writer, 0, 100);
+    }
+
+    StructuredLogReader reader;
+    ASSERT_TRUE(reader.open(path));
+    // a block is written every 30 seconds
+    ASSERT_EQ(reader.blocks().size(), 4);
+    ASSERT_EQ(reader.blocks().front().firstMs, 0);
+    ASSERT_EQ(reader.blocks().back().lastMs, 99'000);
+
+    std::vector<StructuredLogRecord> records;
+    reader.replay(50'000, [&](const auto &record) {
+        records.push_back(record);
+        return records.size() < 10;
+    });
+    ASSERT_EQ(records.size(), 10);
+    ASSERT_EQ(records.front().receivedMs, 50'000);
+    ASSERT_EQ(records.front().data, makeLine(50));
+    ASSERT_EQ(records.back().data, makeLine(59));
+}
+
+TEST(StructuredLog, FlushWithoutNewRecords)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath("forsen-2024-01-02.clog");
+
+    StructuredLogWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    writeRecords(writer, 0, 5);
+    ASSERT_TRUE(writer.hasBufferedRecords());
+
+    // the channel's timer flushes the block while the writer is still open
+    writer.flush();
+    ASSERT_FALSE(writer.hasBufferedRecords());
+
+    StructuredLogReader reader;
+    ASSERT_TRUE(reader.open(path));
+    ASSERT_EQ(reader.blocks().size(), 1);
+    ASSERT_EQ(reader.blocks().front().records, 5);
+}
+
+TEST(StructuredLog, AppendAfterCrash)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath("forsen-2024-01-02.clog");
+
+    {
+        StructuredLogWriter writer;
+        ASSERT_TRUE(writer.open(path));
+        writeRecords(writer, 0, 10);
+    }
+
+    // simulate a block that was cut off
+    {
+        QFile file(path);
+        ASSERT_TRUE(file.open(QIODevice::Append));
+        file.write("garbage");
+    }
+
+    {
+        StructuredLogWriter writer;
+        ASSERT_TRUE(writer.open(path));
+        writeRecords(writer, 10'000, 10);
+    }
+
+    StructuredLogReader reader;
+    ASSERT_TRUE(reader.open(path));
+    ASSERT_EQ(reader.blocks().size(), 2);
+    ASSERT_EQ(reader.validSize(), QFile(path).size());
+
+    size_t count = 0;
+    reader.replay(0, [&](const auto &) {
+        count++;
+        return true;
+    });
+    ASSERT_EQ(count, 20);
+}
+
+TEST(StructuredLog, RefusesUnknownFiles)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath("forsen-2024-01-02.clog");
+    {
+        QFile file(path);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write("not a structured log");
+    }
+
+    StructuredLogWriter writer;
+    ASSERT_FALSE(writer.open(path));
+    ASSERT_FALSE(writer.isOpen());
+}
+
+TEST(StructuredLog, ReadTail)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath("forsen-2024-01-02.clog");
+
+    {
+        StructuredLogWriter writer;
+        ASSERT_TRUE(writer.open(path));
+        writeRecords(writer, 0, 100);
+    }
+
+    StructuredLogReader reader;
+    ASSERT_TRUE(reader.open(path));
+    auto records = reader.readTail(45);
+    ASSERT_EQ(records.size(), 45);
+    ASSERT_EQ(records.front().receivedMs, 55'000);
+    ASSERT_EQ(records.back().data, makeLine(99));
+
+    ASSERT_EQ(reader.readTail(1000).size(), 100);
+    ASSERT_TRUE(reader.readTail(0).empty());
+}
+
+TEST(StructuredLog, ReadTailOfCutOffFile)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath("forsen-2024-01-02.clog");
+
+    {
+        StructuredLogWriter writer;
+        ASSERT_TRUE(writer.open(path));
+        writeRecords(writer, 0, 100);
+    }
+    {
+        QFile file(path);
+        ASSERT_TRUE(file.open(QIODevice::Append));
+        file.write("garbage");
+    }
+
+    StructuredLogReader reader;
+    ASSERT_TRUE(reader.open(path));
+    auto records = reader.readTail(10);
+    ASSERT_EQ(records.size(), 10);
+    ASSERT_EQ(records.front().data, makeLine(90));
+    ASSERT_EQ(records.back().data, makeLine(99));
+}
+
+TEST(StructuredLog, ReadTailAcrossFiles)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    {
+        StructuredLogWriter writer;
+        ASSERT_TRUE(writer.open(dir.filePath("forsen-2024-01-01.clog")));
+        writeRecords(writer, 0, 20);
+    }
+    {
+        StructuredLogWriter writer;
+        ASSERT_TRUE(writer.open(dir.filePath("forsen-2024-01-02.clog")));
+        writeRecords(writer, 100'000, 5);
+    }
+    // neither of these belong to #forsen
+    for (const auto *name : {"forsen-old.clog", "pajlada-2024-01-02.clog"})
+    {
+        QFile file(dir.filePath(name));
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    }
+
+    auto paths = findStructuredLogs(dir.path(), "forsen");
+    ASSERT_EQ(paths.size(), 2);
+    ASSERT_TRUE(paths.front().endsWith("forsen-2024-01-02.clog"));
+
+    auto records = readStructuredLogTail(paths, 10);
+    ASSERT_EQ(records.size(), 10);
+    ASSERT_EQ(records.front().receivedMs, 15'000);
+    ASSERT_EQ(records.back().receivedMs, 104'000);
+
+    ASSERT_EQ(readStructuredLogTail(paths, 3).front().receivedMs, 102'000);
+}
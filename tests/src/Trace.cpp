@@ -0,0 +1,102 @@
+#include "debug/Trace.hpp"
+
+#include "Test.hpp"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include <thread>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+
+namespace {
+
+QJsonObject findEvent(const QJsonArray &events, const QString &phase,
+                      const QString &name)
+{
+    for (const auto &value : events)
+    {
+        auto event = value.toObject();
+        if (event["ph"].toString() == phase && event["name"].toString() == name)
+        {
+            return event;
+        }
+    }
+    return {};
+}
+
+}  // namespace
+
+TEST(Trace, WritesTraceEvents)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath("trace.json");
+
+    {
+        // Nothing is recorded before the start
+        TraceSpan span("before");
+    }
+    ASSERT_FALSE(Trace::isRecording());
+
+    Trace::start(path, 1h);
+    ASSERT_TRUE(Trace::isRecording());
+
+    auto flowID = Trace::newFlowID();
+    {
+        TraceSpan span("outer");
+        Trace::asyncBegin("network", "request", flowID);
+        Trace::instant("paint", "First paint");
+    }
+    std::thread([flowID] {
+        Trace::asyncEnd("network", "request", flowID);
+    }).join();
+
+    Trace::finish();
+    ASSERT_FALSE(Trace::isRecording());
+    {
+        // Nothing is recorded after the trace is written
+        TraceSpan span("after");
+    }
+    // Only written once
+    Trace::finish();
+
+    QFile file(path);
+    ASSERT_TRUE(file.open(QFile::ReadOnly));
+    auto root = QJsonDocument::fromJson(file.readAll()).object();
+    ASSERT_EQ(root["displayTimeUnit"].toString(), "ms");
+    auto events = root["traceEvents"].toArray();
+
+    ASSERT_TRUE(findEvent(events, "X", "before").isEmpty());
+    ASSERT_TRUE(findEvent(events, "X", "after").isEmpty());
+
+    auto outer = findEvent(events, "X", "outer");
+    ASSERT_FALSE(outer.isEmpty());
+    ASSERT_EQ(outer["cat"].toString(), "app");
+    ASSERT_GE(outer["dur"].toDouble(), 0);
+
+    auto begin = findEvent(events, "b", "request");
+    auto end = findEvent(events, "e", "request");
+    ASSERT_FALSE(begin.isEmpty());
+    ASSERT_FALSE(end.isEmpty());
+    ASSERT_EQ(begin["id"], end["id"]);
+    ASSERT_NE(begin["tid"], end["tid"]);
+    ASSERT_GE(end["ts"].toDouble(), begin["ts"].toDouble());
+
+    ASSERT_FALSE(findEvent(events, "i", "First paint").isEmpty());
+
+    // Both threads are named
+    int threadNames = 0;
+    for (const auto &value : events)
+    {
+        if (value.toObject()["ph"].toString() == "M")
+        {
+            threadNames++;
+        }
+    }
+    ASSERT_EQ(threadNames, 2);
+}
@@ -0,0 +1,70 @@
+#include "providers/twitch/TwitchIrcServer.hpp"
+
+#include "mocks/BaseApplication.hpp"
+#include "Test.hpp"
+
+using namespace chatterino;
+
+namespace chatterino {
+
+TEST(TwitchIrcServer, JoinOnConnectedReadConnection)
+{
+    mock::BaseApplication app;
+    TwitchIrcServer server;
+
+    {
+        std::lock_guard lock(server.connectionMutex_);
+        server.readRing_.assign("pajlada");
+        server.syncReadConnections();
+        ASSERT_EQ(server.readConnections_.size(), 1);
+        server.readConnections_[0]->connected = true;
+    }
+
+    auto channel = std::make_shared<Channel>("forsen", Channel::Type::Twitch);
+    server.channels.insert("forsen", channel);
+
+    // The join bucket has budget, so the channel is queued right away. This
+    // used to deadlock on connectionMutex_.
+    server.joinReadChannel("forsen");
+
+    std::lock_guard lock(server.connectionMutex_);
+    ASSERT_EQ(server.readConnections_[0]->pendingJoins,
+              QStringList{"forsen"});
+    ASSERT_TRUE(server.joinFlushScheduled_);
+}
+
+TEST(TwitchIrcServer, OpenAndCloseReadConnection)
+{
+    mock::BaseApplication app;
+    TwitchIrcServer server;
+
+    IrcConnection *connection = nullptr;
+    {
+        std::lock_guard lock(server.connectionMutex_);
+        server.readRing_.assign("pajlada");
+        server.syncReadConnections();
+        ASSERT_EQ(server.readConnections_.size(), 1);
+        connection = server.readConnections_[0]->connection.get();
+    }
+
+    // Nothing listens on this port, the connection is closed before it could
+    // fail anyway
+    connection->setHost("127.0.0.1");
+    connection->setPort(1);
+    connection->setUserName("justinfan123");
+    connection->setNickName("justinfan123");
+    connection->setRealName("justinfan123");
+
+    // Both emit statusChanged right away. These used to deadlock on
+    // connectionMutex_.
+    server.open(TwitchIrcServer::ConnectionType::Read);
+    ASSERT_EQ(connection->status(), Communi::IrcConnection::Connecting);
+
+    server.disconnect();
+    ASSERT_FALSE(connection->isActive());
+
+    std::lock_guard lock(server.connectionMutex_);
+    ASSERT_FALSE(server.readConnections_[0]->connected);
+}
+
+}  // namespace chatterino
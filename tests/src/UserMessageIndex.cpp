@@ -0,0 +1,97 @@
+#include "messages/UserMessageIndex.hpp"
+
+#include "messages/LimitedQueue.hpp"
+#include "messages/Message.hpp"
+#include "Test.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+std::shared_ptr<Message> makeMessage(const QString &login,
+                                     const QString &text = "hi")
+{
+    auto message = std::make_shared<Message>();
+    message->loginName = login;
+    message->messageText = text;
+    return message;
+}
+
+}  // namespace
+
+TEST(UserMessageIndex, AppendAndRemove)
+{
+    UserMessageIndex index;
+    auto a1 = makeMessage("forsen");
+    auto b1 = makeMessage("pajlada");
+    auto a2 = makeMessage("forsen");
+
+    index.append(a1);
+    index.append(b1);
+    index.append(a2);
+
+    ASSERT_EQ(index.find("Forsen"), (std::vector<MessagePtr>{a1, a2}));
+    ASSERT_EQ(index.find("pajlada"), std::vector<MessagePtr>{b1});
+    ASSERT_TRUE(index.find("nobody").empty());
+
+    index.remove(a1);
+    ASSERT_EQ(index.find("forsen"), std::vector<MessagePtr>{a2});
+
+    auto older = makeMessage("forsen");
+    index.prepend({older, makeMessage("pajlada")});
+    ASSERT_EQ(index.find("forsen"), (std::vector<MessagePtr>{older, a2}));
+    ASSERT_EQ(index.find("pajlada").size(), 2);
+
+    index.clear();
+    ASSERT_TRUE(index.find("forsen").empty());
+}
+
+TEST(UserMessageIndex, ModerationAndSubs)
+{
+    UserMessageIndex index;
+
+    auto timeout = makeMessage("", "forsen has been timed out for 10s.");
+    timeout->timeoutUser = "forsen";
+    auto sub = makeMessage("", "Forsen subscribed at Tier 1.");
+    sub->flags.set(MessageFlag::Subscription);
+    auto system = makeMessage("", "forsen is live!");
+
+    index.append(timeout);
+    index.append(sub);
+    index.append(system);
+
+    ASSERT_EQ(index.find("forsen"), (std::vector<MessagePtr>{timeout, sub}));
+}
+
+TEST(UserMessageIndex, Replace)
+{
+    UserMessageIndex index;
+    auto a1 = makeMessage("forsen");
+    auto a2 = makeMessage("forsen");
+    auto timeout = makeMessage("");
+    timeout->timeoutUser = "pajlada";
+
+    index.append(a1);
+    index.append(timeout);
+    index.append(a2);
+
+    // same user: keeps the position
+    auto edited = makeMessage("forsen");
+    index.replace(a1, edited);
+    ASSERT_EQ(index.find("forsen"), (std::vector<MessagePtr>{edited, a2}));
+
+    // different user: moves the message
+    auto stacked = makeMessage("");
+    stacked->timeoutUser = "forsen";
+    index.replace(timeout, stacked);
+    ASSERT_TRUE(index.find("pajlada").empty());
+    ASSERT_EQ(index.find("forsen").size(), 3);
+
+    LimitedQueue<MessagePtr> queue(10);
+    queue.pushBack(a2);
+    index.reset(queue.getSnapshot());
+    ASSERT_EQ(index.find("forsen"), std::vector<MessagePtr>{a2});
+}